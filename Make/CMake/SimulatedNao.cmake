@@ -67,6 +67,10 @@ endif()
 target_link_libraries(SimulatedNao PRIVATE Flags::ForDevelop)
 target_precompile_headers(SimulatedNao PRIVATE "${SIMULATEDNAO_ROOT_DIR}/Tools/Precompiled/BHumanPch.h")
 
+# The module replaces the global operator new to track allocations (see Platform/Memory.h).
+# Without binding its own calls to it, they would use the one of the C++ runtime of SimRobot.
+target_link_options(SimulatedNao PRIVATE $<$<PLATFORM_ID:Linux>:-Wl,-Bsymbolic-functions>)
+
 source_group(TREE "${SIMULATEDNAO_ROOT_DIR}" FILES ${SIMULATEDNAO_SOURCES})
 
 if(WIN32)
@@ -5,9 +5,16 @@ file(GLOB TESTS_SOURCES
     "${TESTS_ROOT_DIR}/Platform/${OS}/*.cpp" "${TESTS_ROOT_DIR}/Platform/${OS}/*.h" "${TESTS_ROOT_DIR}/Platform/${OS}/*.mm"
     "${TESTS_ROOT_DIR}/Platform/*.cpp" "${TESTS_ROOT_DIR}/Platform/*.h"
     "${TESTS_ROOT_DIR}/Tools/*.cpp" "${TESTS_ROOT_DIR}/Tools/*.h"
+    "${TESTS_ROOT_DIR}/Tools/BehaviorControl/SectorWheel.cpp" "${TESTS_ROOT_DIR}/Tools/BehaviorControl/SectorWheel.h"
+    "${TESTS_ROOT_DIR}/Tools/Communication/MsgPack.cpp" "${TESTS_ROOT_DIR}/Tools/Communication/MsgPack.h"
+    "${TESTS_ROOT_DIR}/Tools/Debugging/TimingHistogram.cpp" "${TESTS_ROOT_DIR}/Tools/Debugging/TimingHistogram.h"
     "${TESTS_ROOT_DIR}/Tools/Debugging/TimingManager.cpp" "${TESTS_ROOT_DIR}/Tools/Debugging/TimingManager.h"
+    "${TESTS_ROOT_DIR}/Tools/ImageProcessing/HoughLines.cpp" "${TESTS_ROOT_DIR}/Tools/ImageProcessing/HoughLines.h"
+    "${TESTS_ROOT_DIR}/Tools/ImageProcessing/Sobel.cpp" "${TESTS_ROOT_DIR}/Tools/ImageProcessing/Sobel.h"
+    "${TESTS_ROOT_DIR}/Tools/Math/AngularPartition.h"
     "${TESTS_ROOT_DIR}/Tools/Math/Random.cpp" "${TESTS_ROOT_DIR}/Tools/Math/Random.h"
     "${TESTS_ROOT_DIR}/Tools/Math/RotationMatrix.cpp" "${TESTS_ROOT_DIR}/Tools/Math/RotationMatrix.h"
+    "${TESTS_ROOT_DIR}/Tools/Math/Sector.cpp" "${TESTS_ROOT_DIR}/Tools/Math/Sector.h"
     "${TESTS_ROOT_DIR}/Tools/Logging/LoggingTools.cpp" "${TESTS_ROOT_DIR}/Tools/Logging/LoggingTools.h"
     "${TESTS_ROOT_DIR}/Tools/MessageQueue/*.cpp" "${TESTS_ROOT_DIR}/Tools/MessageQueue/*.h"
     "${TESTS_ROOT_DIR}/Tools/Module/*.cpp" "${TESTS_ROOT_DIR}/Tools/Module/*.h"
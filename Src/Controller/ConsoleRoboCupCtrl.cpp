@@ -19,6 +19,7 @@
 
 #include <SimRobotEditor.h>
 
+#include <QCoreApplication>
 #include <QDir>
 #include <QDirIterator>
 #include <QFileDialog>
@@ -138,8 +139,26 @@ void ConsoleRoboCupCtrl::update()
 
   SimulatedRobot::applyBallFriction(ballFriction);
 
+  if(lockstep)
+    lockstepDeadline = Time::getRealSystemTime() + lockstepTimeout;
   RoboCupCtrl::update();
 
+  if(gameEvaluation.update(gameController, robots, simStepLength))
+  {
+    printLn("Evaluation finished");
+    if(quitAfterEvaluation)
+      QCoreApplication::quit();
+  }
+
+  if(runningBenchmarks)
+    for(ControllerRobot* robot : robots)
+      if(robot->getLocalRobot()->hasFinishedBenchmark() && --runningBenchmarks == 0)
+      {
+        printLn("Benchmark finished");
+        if(quitAfterBenchmark)
+          QCoreApplication::quit();
+      }
+
   for(RemoteRobot* remoteRobot : remoteRobots)
     remoteRobot->update();
   {
@@ -354,6 +373,27 @@ void ConsoleRoboCupCtrl::executeConsoleCommand(std::string command, RobotTextCon
     else if(buffer == "off")
       gameController.automatic &= ~mask;
   }
+  else if(buffer == "bench")
+  {
+    std::vector<std::string> fileNames;
+    for(stream >> buffer; !buffer.empty(); stream >> buffer)
+      fileNames.push_back(buffer);
+    quitAfterBenchmark = !fileNames.empty() && fileNames.back() == "quit";
+    if(quitAfterBenchmark)
+      fileNames.pop_back();
+    if(fileNames.empty() || fileNames.size() > 3)
+      printLn("Syntax Error");
+    else
+    {
+      fileNames.resize(3);
+      runningBenchmarks = 0;
+      for(ControllerRobot* robot : robots)
+        if(robot->getLocalRobot()->startBenchmark(fileNames[0], fileNames[1], fileNames[2]))
+          ++runningBenchmarks;
+      if(!runningBenchmarks)
+        printLn("No robot replays a log file!");
+    }
+  }
   else if(buffer == "ci")
   {
     if(is2D || !calcImage(stream))
@@ -377,6 +417,19 @@ void ConsoleRoboCupCtrl::executeConsoleCommand(std::string command, RobotTextCon
       delayTime = 1000.f / std::max(1, atoi(buffer.c_str()));
     }
   }
+  else if(buffer == "eval")
+  {
+    std::string fileName;
+    float duration = 0.f;
+    stream >> fileName >> duration >> buffer;
+    if(fileName.empty() || duration <= 0.f || (!buffer.empty() && buffer != "quit"))
+      printLn("Syntax Error");
+    else
+    {
+      gameEvaluation.start(fileName, duration, robots);
+      quitAfterEvaluation = buffer == "quit";
+    }
+  }
   else if(buffer == "gc")
   {
     if(!gameController.handleGlobalConsole(stream))
@@ -439,10 +492,16 @@ void ConsoleRoboCupCtrl::executeConsoleCommand(std::string command, RobotTextCon
   else if(buffer == "st")
   {
     stream >> buffer;
-    if(buffer == "on" || buffer.empty())
+    if(buffer == "on" || buffer.empty() || buffer == "lockstep")
+    {
       Time::setSimulatedTime(true);
+      lockstep = buffer == "lockstep";
+    }
     else if(buffer == "off")
+    {
       Time::setSimulatedTime(false);
+      lockstep = false;
+    }
     else
       printLn("Syntax Error");
   }
@@ -508,12 +567,14 @@ void ConsoleRoboCupCtrl::help(In& stream)
   list("  sml <directory> : Starts robots reading their input from all log files in subfolders.", pattern, true);
   list("Global commands:", pattern, true);
   list("  ar {<feature>} off | on : Switches automatic referee on or off.", pattern, true);
+  list("  bench <report> [<joint requests> [<baseline>]] [quit] : Write the execution times of the Motion modules to a file when the log file was replayed completely, save the joint requests, compare them with the ones saved earlier, and optionally quit.", pattern, true);
   list("  call <file> [<file>] : Execute a script file. If the optional script file is present, execute it instead.", pattern, true);
   if(!is2D)
     list("  ci off | on | <fps> : Switch the calculation of images on or off or activate it and set the frame rate.", pattern, true);
   list("  cls : Clear console window.", pattern, true);
   list("  dt off | on | <fps> : Delay time of a simulation step to real time or a certain number of frames per second.", pattern, true);
   list("  echo <text> : Print text into console window. Useful in console.con.", pattern, true);
+  list("  eval <file> <seconds> [quit] : Write statistics about the game to a file after the given simulated time and optionally quit.", pattern, true);
   list("  gc initial | ready | set | playing | finished | goalByFirstTeam | goalBySecondTeam | kickOffFirstTeam | kickOffSecondTeam | manualPlacementFirstTeam | manualPlacementSecondTeam | goalKickForFirstTeam | goalKickForSecondTeam | pushingFreeKickForFirstTeam | pushingFreeKickForSecondTeam | cornerKickForFirstTeam | cornerKickForSecondTeam | kickInForFirstTeam | kickInForSecondTeam | penaltyKickForFirstTeam | penaltyKickForSecondTeam | gameNormal | gamePenaltyShootout | competitionPhasePlayoff | competitionPhaseRoundRobin | competitionTypeNormal : Set GameController state.", pattern, true);
   list("  ( help | ? ) [<pattern>] : Display this text.", pattern, true);
   if(is2D)
@@ -521,10 +582,11 @@ void ConsoleRoboCupCtrl::help(In& stream)
   else
     list("  mvo <name> <x> <y> <z> [<rotx> <roty> <rotz>] : Move the object with the given name to the given position.", pattern, true);
   list("  robot ? | all | <name> {<name>} : Connect console to a set of active robots. Alternatively, double click on robot.", pattern, true);
-  list("  st off | on : Switch simulation of time on or off.", pattern, true);
+  list("  st off | on | lockstep : Switch simulation of time on or off. With lockstep, each step also waits for the robot code to process the previous one (use dt off to run faster than real time).", pattern, true);
   list("  # <text> : Comment.", pattern, true);
   list("Robot commands:", pattern, true);
   list("  bc [<red%> [<green%> [<blue%>]]] : Set the background color of all 3-D views.", pattern, true);
+  list("  dis [<pattern>] : Show the encoding and size per frame of the debug images received.", pattern, true);
   list("  dr ? [<pattern>] | off | <key> ( off | on ) : Send debug request.", pattern, true);
   list("  get ? [<pattern>] | <key> [?]: Show debug data or show its specification.", pattern, true);
   list("  jc hide | show | motion ( 1 | 2 ) <command> | ( press | release ) <button> <command> : Set joystick motion (use $1 .. $8) or button command.", pattern, true);
@@ -534,13 +596,16 @@ void ConsoleRoboCupCtrl::help(In& stream)
     list("  kick : Adds the KickEngine view.", pattern, true);
   list("  log start | stop | clear | full | jpeg : Record log file and (de)activate image compression.", pattern, true);
   list("  log save [split <parts>] [<file>] : Save log file with given name or modified current log file name. Split command saves in given number of parts", pattern, true);
+  list("  log resetTimingHistograms : Clear the timing histograms of all threads, e.g. before a log replay.", pattern, true);
   list("  log saveAudio [<file>] : Save audio data from log.", pattern, true);
   list("  log saveChoregrapheTimeline [<file>] : Save joint requests from log as Choregraphe timeline.", pattern, true);
   list("  log saveImages [raw] [onlyPlaying] [<takeEachNth>] [<dir>] : Save images from log.", pattern, true);
   list("  log saveInertialSensorData [<file>] : Save the inertial sensor data from the log into a dataset. Require motion log.", pattern, true);
   list("  log saveJointAngleData [<file>] : Save the joint angle data from the lot into a dataset. Require motion log.", pattern, true);
   list("  log saveLabeledBallSpots [<file>] : Extracts labeled BallSpots.", pattern, true);
+  list("  log saveSensorData [<prefix>] : Save the inertial sensor data and the joint angle data from the log in a single pass. Require motion log.", pattern, true);
   list("  log saveTiming [<file>] : Save timing data from log to csv.", pattern, true);
+  list("  log saveTimingHistograms [<file>] : Save the timing histograms of all threads to csv, e.g. at the end of a log replay.", pattern, true);
   list("  log trim ( until <end frame> | from <start frame> | between <start frame> <end frame> ) : Keep only the given section of the log. WARNING: Overwrites the log file!", pattern, true);
   list("  log ? [<pattern>] : Display information about log file.", pattern, true);
   list("  log load <file> | clear : Load log-file or clear all frames.", pattern, true);
@@ -550,6 +615,7 @@ void ConsoleRoboCupCtrl::help(In& stream)
   list("  log start | pause | stop | forward [image] | backward [image] | repeat | goto <number> | time <minutes> <seconds> | cycle | once | fastForward | fastBackward : Replay log file.", pattern, true);
   list("  log mr [legacy] [list] : Generate module requests to replay log file.", pattern, true);
   list("  log analyzeRobotStatus : Find timestamps with joints that are defect or gyros not updating.", pattern, true);
+  list("  log benchmarkJPEG : Compare single and parallel JPEG compression of the images in the log.", pattern, true);
   list("  msg off | on | log <file> | enable | disable : Switch output of text messages on or off. Log text messages to a file. Switch message handling on or off.", pattern, true);
   list("  mr ? [<pattern>] | modules [<pattern>] | save | <representation> ( ? [<pattern>] | ( <module> | off ) [<thread>] | default ) : Send module request.", pattern, true);
   if(is2D)
@@ -741,12 +807,15 @@ void ConsoleRoboCupCtrl::createCompletion()
     "ar off",
     "ar on",
     "bc",
+    "bench",
     "call",
     "cls",
+    "dis",
     "dr off",
     "dt off",
     "dt on",
     "echo",
+    "eval",
     "help",
     "jc motion",
     "jc hide",
@@ -760,13 +829,16 @@ void ConsoleRoboCupCtrl::createCompletion()
     "log save split",
     "log full",
     "log jpeg",
+    "log resetTimingHistograms",
     "log saveAudio",
     "log saveChoregrapheTimeline",
     "log saveImages raw onlyPlaying",
     "log saveInertialSensorData",
     "log saveLabeledBallSpots gray",
     "log saveJointAngleData",
+    "log saveSensorData",
     "log saveTiming",
+    "log saveTimingHistograms",
     "log trim from",
     "log trim until",
     "log trim between",
@@ -794,6 +866,7 @@ void ConsoleRoboCupCtrl::createCompletion()
     "log keep penaltyMarkPercept",
     "log keep option",
     "log analyzeRobotStatus",
+    "log benchmarkJPEG",
     "mr modules",
     "mr save",
     "msg off",
@@ -811,6 +884,7 @@ void ConsoleRoboCupCtrl::createCompletion()
     "sml",
     "st off",
     "st on",
+    "st lockstep",
     "v3 image Upper",
     "v3 image jpeg Upper",
     "v3 image Lower",
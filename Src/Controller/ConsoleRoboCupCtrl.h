@@ -13,6 +13,7 @@
 #include <QString>
 
 #include "BHToolBar.h"
+#include "GameEvaluation.h"
 #include "RoboCupCtrl.h"
 #include "RobotTextConsole.h"
 
@@ -30,6 +31,9 @@ public:
   bool calculateImage = true; /**< Decides whether images are calculated by the simulator. */
   unsigned calculateImageFps; /**< Declares the simulated image frame rate. */
   unsigned globalNextImageTimestamp = 0;  /**< The theoretical timestamp of the next image to be calculated shared among all robots to synchronize image calculation. */
+  bool lockstep = false; /**< Does each simulation step wait until the robot code processed the data of the previous one? */
+  static constexpr int lockstepTimeout = 1000; /**< How long a simulation step waits for all acknowledgements in lockstep mode (in ms, real time). */
+  unsigned lockstepDeadline = 0; /**< The real time until which the robots wait for acknowledgements in the current simulation step. */
 
 private:
   SystemCall::Mode mode; /**< The mode of the robot currently constructed. */
@@ -50,6 +54,10 @@ private:
   const RobotTextConsole::PlotViews* plotViews = nullptr; /**< Points to the map of plot views used for tab-completion. */
   BHToolBar toolBar; /**< The toolbar shown for this controller. */
   static constexpr float ballFriction = -0.35f; /**< The ball friction acceleration (2D only). */
+  GameEvaluation gameEvaluation; /**< Collects statistics about the game if requested by the command "eval". */
+  bool quitAfterEvaluation = false; /**< Quit SimRobot when the evaluation is finished? */
+  unsigned runningBenchmarks = 0; /**< The number of robots running a benchmark started by the command "bench". */
+  bool quitAfterBenchmark = false; /**< Quit SimRobot when all benchmarks are finished? */
 
 public:
   /**
@@ -34,6 +34,8 @@ public:
 
   RobotTextConsole* getRobotThread() const { return robotThread; }
 
+  LocalRobot* getLocalRobot() const { return robotThread; }
+
 private:
   LocalRobot* robotThread;
 };
@@ -193,6 +193,19 @@ public:
    */
   void setTeamInfos(Settings::TeamColor firstTeamColor, Settings::TeamColor secondTeamColor);
 
+  /**
+   * Returns the current score of a team.
+   * @param team 0 for the first team, 1 for the second team.
+   * @return The number of goals the team scored.
+   */
+  int getScore(int team) const {return teamInfos[team].score;}
+
+  /**
+   * Returns which team touched the ball last.
+   * @return 0 for the first team, 1 for the second team, -1 if nobody touched the ball yet.
+   */
+  int getLastBallContactTeam() const {return lastBallContactTime ? lastBallContactPose.rotation == 0.f ? 1 : 0 : -1;}
+
 private:
 
   /**
@@ -0,0 +1,94 @@
+/**
+ * @file Controller/GameEvaluation.cpp
+ *
+ * This file implements a class that collects statistics about a simulated
+ * game and writes a summary after a given duration.
+ */
+
+#include "GameEvaluation.h"
+#include "Controller/ControllerRobot.h"
+#include "Controller/GameController.h"
+#include "Tools/Streams/OutStreams.h"
+#include <algorithm>
+#include <vector>
+
+void GameEvaluation::start(const std::string& fileName, float duration, const std::list<ControllerRobot*>& robots)
+{
+  this->fileName = fileName;
+  this->duration = duration * 1000.f;
+  elapsed = 0.f;
+  possession[0] = possession[1] = 0.f;
+  initialScoreKnown = false;
+  for(ControllerRobot* robot : robots)
+    robot->getLocalRobot()->resetStatistics();
+}
+
+bool GameEvaluation::update(const GameController& gameController, const std::list<ControllerRobot*>& robots, float stepLength)
+{
+  if(!isActive())
+    return false;
+
+  // The scores are read in the first step, because the start script might change them.
+  if(!initialScoreKnown)
+  {
+    initialScore[0] = gameController.getScore(0);
+    initialScore[1] = gameController.getScore(1);
+    initialScoreKnown = true;
+  }
+
+  const int team = gameController.getLastBallContactTeam();
+  if(team >= 0)
+    possession[team] += stepLength;
+  elapsed += stepLength;
+  if(elapsed < duration)
+    return false;
+
+  write(gameController, robots);
+  fileName.clear();
+  return true;
+}
+
+bool GameEvaluation::write(const GameController& gameController, const std::list<ControllerRobot*>& robots) const
+{
+  OutTextRawFile file(fileName);
+  if(!file.exists())
+    return false;
+
+  struct RobotStatistics
+  {
+    std::string name;
+    LocalRobot::Statistics statistics;
+  };
+  std::vector<RobotStatistics> robotStatistics;
+  unsigned roleSwitches = 0;
+  unsigned cognitionFrames = 0;
+  float cognitionTimeSum = 0.f;
+  float cognitionTimeMax = 0.f;
+  for(ControllerRobot* robot : robots)
+  {
+    robotStatistics.push_back({robot->getName(), robot->getLocalRobot()->getStatistics()});
+    const LocalRobot::Statistics& statistics = robotStatistics.back().statistics;
+    roleSwitches += statistics.roleSwitches;
+    cognitionFrames += statistics.cognitionFrames;
+    cognitionTimeSum += statistics.cognitionTimeSum;
+    cognitionTimeMax = std::max(cognitionTimeMax, statistics.cognitionTimeMax);
+  }
+
+  const std::string sep = ";";
+  const float possessionSum = std::max(1.f, possession[0] + possession[1]);
+  file << "duration" << sep << "goalsFirstTeam" << sep << "goalsSecondTeam" << sep
+       << "possessionFirstTeam" << sep << "possessionSecondTeam" << sep << "roleSwitches" << sep
+       << "cognitionTimeAvg" << sep << "cognitionTimeMax" << endl;
+  file << elapsed / 1000.f << sep
+       << gameController.getScore(0) - initialScore[0] << sep << gameController.getScore(1) - initialScore[1] << sep
+       << possession[0] / possessionSum << sep << possession[1] / possessionSum << sep << roleSwitches << sep
+       << (cognitionFrames ? cognitionTimeSum / static_cast<float>(cognitionFrames) : 0.f) << sep << cognitionTimeMax << endl;
+
+  file << endl << "robot" << sep << "roleSwitches" << sep << "cognitionFrames" << sep
+       << "cognitionTimeAvg" << sep << "cognitionTimeMax" << endl;
+  for(const RobotStatistics& robot : robotStatistics)
+    file << robot.name << sep << robot.statistics.roleSwitches << sep << robot.statistics.cognitionFrames << sep
+         << (robot.statistics.cognitionFrames ? robot.statistics.cognitionTimeSum / static_cast<float>(robot.statistics.cognitionFrames) : 0.f) << sep
+         << robot.statistics.cognitionTimeMax << endl;
+  return true;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file Controller/GameEvaluation.h
+ *
+ * This file declares a class that collects statistics about a simulated game
+ * and writes a summary after a given duration. It is used to run many games
+ * without a user interface (see Make/Common/evaluateGames).
+ */
+
+#pragma once
+
+#include <list>
+#include <string>
+
+class ControllerRobot;
+class GameController;
+
+class GameEvaluation
+{
+public:
+  /**
+   * Starts an evaluation. The statistics are collected from now on.
+   * @param fileName The name of the file the summary is written to.
+   * @param duration The duration of the evaluation in simulated seconds.
+   * @param robots All simulated robots. Their statistics are reset.
+   */
+  void start(const std::string& fileName, float duration, const std::list<ControllerRobot*>& robots);
+
+  /** Is an evaluation running? */
+  bool isActive() const {return !fileName.empty();}
+
+  /**
+   * Updates the statistics. Must be called once per simulation step.
+   * @param gameController The game controller that knows the score and the last ball contact.
+   * @param robots All simulated robots.
+   * @param stepLength The duration of a simulation step in ms.
+   * @return Did the evaluation end in this step, i.e. was the summary written?
+   */
+  bool update(const GameController& gameController, const std::list<ControllerRobot*>& robots, float stepLength);
+
+private:
+  std::string fileName; /**< The file the summary is written to. Empty if no evaluation is running. */
+  float duration = 0.f; /**< The duration of the evaluation (in ms). */
+  float elapsed = 0.f; /**< The simulated time since the evaluation started (in ms). */
+  float possession[2] = {0.f, 0.f}; /**< For how long did each team touch the ball last (in ms)? */
+  int initialScore[2] = {0, 0}; /**< The scores when the evaluation started. */
+  bool initialScoreKnown = false; /**< Were the initial scores already read? */
+
+  /**
+   * Writes the summary.
+   * @param gameController The game controller that knows the score.
+   * @param robots All simulated robots.
+   * @return Could the file be written?
+   */
+  bool write(const GameController& gameController, const std::list<ControllerRobot*>& robots) const;
+};
@@ -12,10 +12,12 @@
 #include "Controller/SimulatedRobot2D.h"
 #include "Controller/SimulatedRobot3D.h"
 #include "Platform/Time.h"
+#include "Representations/BehaviorControl/TeamBehaviorStatus.h"
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Sensing/FallDownState.h"
 #include "Representations/Sensing/GroundContactState.h"
 #include "Threads/Debug.h"
+#include <algorithm>
 
 LocalRobot::LocalRobot(const Settings& settings, const std::string& robotName, Debug* debug) :
   RobotTextConsole(settings, robotName, connectReceiverWithRobot(debug), connectSenderWithRobot(debug)),
@@ -63,6 +65,7 @@ bool LocalRobot::main()
       // Only one thread can access *this now.
       SYNC;
 
+      unsigned framesSent = 0;
       if(mode == SystemCall::simulatedRobot)
       {
         if(!ctrl->is2D)
@@ -81,6 +84,7 @@ bool LocalRobot::main()
             debugSender->out.finishMessage(idGroundTruthOdometryData);
             debugSender->out.bin << "Motion";
             debugSender->out.finishMessage(idFrameFinished);
+            ++framesSent;
             jointLastTimestampSent = jointSensorData.timestamp;
           }
 
@@ -108,6 +112,7 @@ bool LocalRobot::main()
             debugSender->out.finishMessage(idGroundTruthWorldState);
             debugSender->out.bin << perception;
             debugSender->out.finishMessage(idFrameFinished);
+            ++framesSent;
 
             debugSender->out.bin << "Cognition";
             debugSender->out.finishMessage(idFrameBegin);
@@ -124,6 +129,7 @@ bool LocalRobot::main()
             debugSender->out.finishMessage(idGroundTruthWorldState);
             debugSender->out.bin << "Cognition";
             debugSender->out.finishMessage(idFrameFinished);
+            ++framesSent;
             imageLastTimestampSent = cameraImage.timestamp;
           }
         }
@@ -172,8 +178,11 @@ bool LocalRobot::main()
           debugSender->out.finishMessage(idGroundTruthWorldState);
           debugSender->out.bin << "Cognition";
           debugSender->out.finishMessage(idFrameFinished);
+          ++framesSent;
         }
       }
+      if(ctrl->lockstep)
+        pendingAcknowledgements += framesSent;
       debugSender->send(true);
     }
 
@@ -187,6 +196,7 @@ void LocalRobot::update()
   RobotTextConsole::update();
 
   updatedSignal.wait();
+  waitForAcknowledgements();
 
   // Only one thread can access *this now.
   {
@@ -197,6 +207,14 @@ void LocalRobot::update()
       std::string threadIdentifier = logPlayer.getThreadIdentifierOfNextFrame();
       if(threadIdentifier != "" && threadData[threadIdentifier].logAcknowledged && logPlayer.replay())
         threadData[threadIdentifier].logAcknowledged = false;
+      else if(motionBenchmark.isActive() && logPlayer.state == LogPlayer::playing
+              && logPlayer.currentFrameNumber == logPlayer.numberOfFrames - 1
+              && std::all_of(threadData.begin(), threadData.end(), [](const auto& entry) {return entry.second.logAcknowledged;}))
+      {
+        // All frames were replayed and acknowledged. The results of a frame arrive together with its acknowledgement.
+        printLn("Benchmark: " + motionBenchmark.finish());
+        benchmarkFinished = true;
+      }
       if(puppet)
       {
         if(RobotTextConsole::jointSensorData.timestamp)
@@ -302,6 +320,134 @@ void LocalRobot::update()
   trigger(); // invoke a call of main()
 }
 
+bool LocalRobot::handleMessage(InMessage& message)
+{
+  switch(message.getMessageID())
+  {
+    case idLogResponse:
+      if(mode == SystemCall::simulatedRobot && ctrl->lockstep)
+        acknowledgedSignal.post();
+      break;
+    case idTeamBehaviorStatus:
+    {
+      TeamBehaviorStatus teamBehaviorStatus;
+      message.bin >> teamBehaviorStatus;
+      message.resetReadPosition();
+      if(teamBehaviorStatus.role.role != lastRole && lastRole != PlayerRole::none)
+        ++statistics.roleSwitches;
+      lastRole = teamBehaviorStatus.role.role;
+      break;
+    }
+    case idStopwatch:
+      if(threadIdentifier == "Cognition")
+      {
+        updateTimingStatistics(message);
+        message.resetReadPosition();
+      }
+      else if(threadIdentifier == "Motion")
+      {
+        motionBenchmark.addTimes(message);
+        message.resetReadPosition();
+      }
+      break;
+    case idJointRequest:
+      if(threadIdentifier == "Motion")
+      {
+        motionBenchmark.addJointRequest(message);
+        message.resetReadPosition();
+      }
+      break;
+    default:
+      ;
+  }
+  return RobotTextConsole::handleMessage(message);
+}
+
+void LocalRobot::updateTimingStatistics(InMessage& message)
+{
+  // Same format as read by TimeInfo::handleMessage
+  unsigned short nameCount;
+  message.bin >> nameCount;
+  for(unsigned short i = 0; i < nameCount; ++i)
+  {
+    unsigned short watchId;
+    std::string watchName;
+    message.bin >> watchId >> watchName;
+    if(watchName == "AllModules")
+      allModulesWatchId = watchId;
+  }
+
+  unsigned short dataCount;
+  message.bin >> dataCount;
+  for(unsigned short i = 0; i < dataCount; ++i)
+  {
+    unsigned short watchId;
+    unsigned time;
+    message.bin >> watchId >> time;
+    if(watchId == allModulesWatchId)
+    {
+      const float duration = static_cast<float>(time) / 1000.f;
+      ++statistics.cognitionFrames;
+      statistics.cognitionTimeSum += duration;
+      statistics.cognitionTimeMax = std::max(statistics.cognitionTimeMax, duration);
+    }
+  }
+}
+
+LocalRobot::Statistics LocalRobot::getStatistics()
+{
+  SYNC;
+  return statistics;
+}
+
+void LocalRobot::resetStatistics()
+{
+  SYNC;
+  statistics = Statistics();
+  lastRole = PlayerRole::none;
+}
+
+bool LocalRobot::startBenchmark(const std::string& reportFileName, const std::string& jointRequestsFileName, const std::string& baselineFileName)
+{
+  SYNC;
+  if(mode != SystemCall::logFileReplay)
+    return false;
+  motionBenchmark.start(reportFileName, jointRequestsFileName, baselineFileName);
+  benchmarkFinished = false;
+  return true;
+}
+
+bool LocalRobot::hasFinishedBenchmark()
+{
+  SYNC;
+  const bool finished = benchmarkFinished;
+  benchmarkFinished = false;
+  return finished;
+}
+
+void LocalRobot::waitForAcknowledgements()
+{
+  // Only the thread that called update() changes the counter between main() and the next update().
+  if(lockstep != ctrl->lockstep)
+  {
+    // Frames sent and acknowledged before the switch would not match anymore.
+    lockstep = ctrl->lockstep;
+    pendingAcknowledgements = 0;
+    while(acknowledgedSignal.tryWait());
+  }
+
+  for(; pendingAcknowledgements > 0; --pendingAcknowledgements)
+  {
+    const int timeLeft = static_cast<int>(ctrl->lockstepDeadline - Time::getRealSystemTime());
+    if(!(timeLeft > 0 ? acknowledgedSignal.wait(static_cast<unsigned>(timeLeft)) : acknowledgedSignal.tryWait()))
+    {
+      while(acknowledgedSignal.tryWait()); // forget late acknowledgements
+      break;
+    }
+  }
+  pendingAcknowledgements = 0;
+}
+
 DebugReceiver<MessageQueue>* LocalRobot::connectReceiverWithRobot(Debug* debug)
 {
   ASSERT(!debug->debugSender);
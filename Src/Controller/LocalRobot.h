@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include "Controller/MotionBenchmark.h"
 #include "Controller/RobotTextConsole.h"
+#include "Representations/BehaviorControl/PlayerRole.h"
 #include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Infrastructure/GroundTruthWorldState.h"
 #include "Representations/Infrastructure/CameraImage.h"
@@ -31,6 +33,16 @@ class SimulatedRobot;
  */
 class LocalRobot : public RobotTextConsole
 {
+public:
+  /** Statistics about the robot code collected for the evaluation of games. */
+  struct Statistics
+  {
+    unsigned roleSwitches = 0; /**< How often did the role in the TeamBehaviorStatus change? */
+    unsigned cognitionFrames = 0; /**< The number of Cognition frames for which timing data was received. */
+    float cognitionTimeSum = 0.f; /**< The sum of the execution times of all modules in Cognition (in ms). */
+    float cognitionTimeMax = 0.f; /**< The longest execution time of all modules in Cognition (in ms). */
+  };
+
 private:
   CameraImage cameraImage; /**< The simulated camera image sent to the robot code. */
   CameraInfo cameraInfo; /**< The information about the camera that took the image sent to the robot code. */
@@ -47,7 +59,15 @@ private:
   std::unique_ptr<SimulatedRobot> simulatedRobot; /**< The interface to simulated objects. */
   Semaphore updateSignal; /**< A signal used for synchronizing main() and update(). */
   Semaphore updatedSignal; /**< A signal used for yielding processing time to main(). */
+  Semaphore acknowledgedSignal; /**< Posted for each frame the robot code acknowledged in lockstep mode. */
+  unsigned pendingAcknowledgements = 0; /**< The number of frames sent in lockstep mode that were not acknowledged yet. */
+  bool lockstep = false; /**< Was lockstep mode active when the acknowledgements were waited for the last time? */
   SimRobotCore2::Body* puppet = nullptr; /**< A pointer to the puppet when there is one during log file replay. Otherwise 0. */
+  Statistics statistics; /**< Statistics about the robot code (only collected if the corresponding data is requested). */
+  PlayerRole::RoleType lastRole = PlayerRole::none; /**< The role last received in the TeamBehaviorStatus. */
+  unsigned short allModulesWatchId = 0xffff; /**< The id of the stopwatch measuring all modules of Cognition. */
+  MotionBenchmark motionBenchmark; /**< Collects the Motion timing and joint requests while replaying a log file if requested. */
+  bool benchmarkFinished = false; /**< Did the benchmark finish since the last call of hasFinishedBenchmark()? */
 
 public:
   /**
@@ -69,7 +89,52 @@ public:
    */
   void update() override;
 
+  /** Returns the statistics about the robot code. */
+  Statistics getStatistics();
+
+  /** Resets the statistics about the robot code. */
+  void resetStatistics();
+
+  /**
+   * Starts a benchmark of the Motion thread that ends when the log file was
+   * replayed completely (see MotionBenchmark::start).
+   * @param reportFileName The name of the file the report is written to.
+   * @param jointRequestsFileName The name of the file the joint requests are written to or "".
+   * @param baselineFileName The name of the file the joint requests are compared with or "".
+   * @return Was the benchmark started, i.e. is this robot replaying a log file?
+   */
+  bool startBenchmark(const std::string& reportFileName, const std::string& jointRequestsFileName, const std::string& baselineFileName);
+
+  /** Did the benchmark finish since the last call of this function? */
+  bool hasFinishedBenchmark();
+
 private:
+  /**
+   * The function is called for every incoming debug message.
+   * In lockstep mode, it signals the acknowledgement of a frame. It also
+   * collects the statistics from role and timing messages and passes the
+   * Motion timing and joint requests to a running benchmark.
+   * @param message An interface to read the message from the queue.
+   * @return Has the message been handled?
+   */
+  bool handleMessage(InMessage& message) override;
+
+  /**
+   * In lockstep mode, the function waits until the robot code processed all
+   * frames sent in the previous simulation step. All robots wait until the
+   * same deadline, so robots that do not respond in time delay a simulation
+   * step only once. If lockstep mode was toggled, the acknowledgements
+   * pending are discarded.
+   */
+  void waitForAcknowledgements();
+
+  /**
+   * The function updates the Cognition timing statistics from a stopwatch
+   * message. The message must be reset afterwards.
+   * @param message The stopwatch message.
+   */
+  void updateTimingStatistics(InMessage& message);
+
   /**
    * The function connects the robot to the returned receiver.
    *
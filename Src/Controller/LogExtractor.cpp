@@ -41,8 +41,14 @@
 #include "Tools/Motion/SensorData.h"
 #include "Tools/RingBuffer.h"
 #include "Tools/Streams/TypeInfo.h"
+#include "Tools/WorkerPool.h"
 #include <QImage>
 #include <QDir>
+#include <cctype>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <memory>
 #include <type_traits>
 
 /**
@@ -66,6 +72,141 @@
 // The extra comma for the last representation seems to be no problem.
 #define _DECLARE_REPRESENTATIONS_AND_MAP_LIST(type) { id##type, &the##type },
 
+/**
+ * A table with one row per frame. It is stored column by column, so that it
+ * can be written both as semicolon-separated file and as NumPy arrays after
+ * the log was processed.
+ */
+class LogExtractor::Table
+{
+private:
+  /** The interface of a column independent of its type. */
+  struct Column
+  {
+    std::string name; /**< The name in the header of the CSV file. */
+
+    Column(const std::string& name) : name(name) {}
+    virtual ~Column() = default;
+
+    /** Appends the current value. */
+    virtual void addRow() = 0;
+
+    /**
+     * Writes a value as text.
+     * @param stream The stream to write to.
+     * @param row The row of the value.
+     */
+    virtual void write(Out& stream, size_t row) const = 0;
+
+    /**
+     * Writes all values as NumPy array.
+     * @param fileName The name of the .npy file.
+     * @return Was the file written?
+     */
+    virtual bool writeNumPy(const std::string& fileName) const = 0;
+  };
+
+  template<typename T> struct TypedColumn : public Column
+  {
+    std::function<T()> get; /**< Returns the current value. */
+    std::vector<T> values; /**< All values added so far. */
+
+    TypedColumn(const std::string& name, const std::function<T()>& get) : Column(name), get(get) {}
+
+    void addRow() override {values.push_back(get());}
+
+    void write(Out& stream, size_t row) const override {stream << values[row];}
+
+    bool writeNumPy(const std::string& fileName) const override
+    {
+      static_assert(std::is_same<T, float>::value || std::is_same<T, unsigned>::value, "Unsupported column type");
+      OutBinaryFile stream(fileName);
+      if(!stream.exists())
+        return false;
+
+      // Format version 1.0. The header is padded, so that the data is 64 byte aligned.
+      std::string header = std::string("{'descr': '<") + (std::is_same<T, float>::value ? "f4" : "u4")
+                           + "', 'fortran_order': False, 'shape': (" + std::to_string(values.size()) + ",), }";
+      header.append(63 - (10 + header.size()) % 64, ' ');
+      header += '\n';
+      const unsigned short headerSize = static_cast<unsigned short>(header.size());
+      stream.write("\x93NUMPY\x01\x00", 8);
+      stream.write(&headerSize, sizeof(headerSize));
+      stream.write(header.data(), header.size());
+      stream.write(values.data(), values.size() * sizeof(T));
+      return true;
+    }
+  };
+
+  std::vector<std::unique_ptr<Column>> columns;
+  size_t numOfRows = 0;
+
+public:
+  std::string fileName; /**< The name of the CSV file. The NumPy arrays are written to a folder of the same name without extension. */
+
+  Table(const std::string& fileName) :
+    fileName(File::isAbsolute(fileName.c_str()) ? fileName : std::string(File::getBHDir()) + "/Config/" + fileName)
+  {}
+
+  /**
+   * Adds a column.
+   * @param name The name of the column.
+   * @param get Returns the value of the column in the current frame.
+   */
+  template<typename T> void add(const std::string& name, const std::function<T()>& get)
+  {
+    columns.emplace_back(std::make_unique<TypedColumn<T>>(name, get));
+  }
+
+  /** Adds a row with the current values of all columns. */
+  void addRow()
+  {
+    for(const std::unique_ptr<Column>& column : columns)
+      column->addRow();
+    ++numOfRows;
+  }
+
+  /**
+   * Writes the table.
+   * @return Were all files written?
+   */
+  bool write() const
+  {
+    OutTextRawFile file(fileName);
+    if(!file.exists())
+      return false;
+    const std::string sep = ";";
+    for(size_t i = 0; i < columns.size(); ++i)
+      file << (i ? sep : "") << columns[i]->name;
+    file << endl;
+    for(size_t row = 0; row < numOfRows; ++row)
+    {
+      for(size_t i = 0; i < columns.size(); ++i)
+      {
+        if(i)
+          file << sep;
+        columns[i]->write(file, row);
+      }
+      file << endl;
+    }
+
+    const std::string folder = fileName.substr(0, fileName.rfind('.')) + "/";
+    QDir().mkpath(folder.c_str());
+    bool success = true;
+    for(const std::unique_ptr<Column>& column : columns)
+    {
+      std::string name;
+      for(char c : column->name)
+        if(std::isalnum(static_cast<unsigned char>(c)))
+          name += c;
+        else if(!name.empty() && name.back() != '_')
+          name += '_';
+      success &= column->writeNumPy(folder + name + ".npy");
+    }
+    return success;
+  }
+};
+
 LogExtractor::LogExtractor(LogPlayer& logPlayer) : logPlayer(logPlayer) {}
 
 bool LogExtractor::save(const std::string& fileName, const TypeInfo* typeInfo)
@@ -277,10 +418,15 @@ bool LogExtractor::saveImages(const std::string& path, const bool raw, const boo
 
   int skippedImageCount = 0;
 
+  // Decoding, encoding and writing the images runs in parallel. The number of
+  // images in flight is limited to bound the memory used.
+  const size_t maxPending = 2 * WorkerPool::getShared().getNumOfWorkers();
+  std::deque<std::future<void>> pending;
+
   // Use DECLARE_REPRESENTATIONS_AND_MAP as soon as the hack is no longer needed
-  return goThroughLog(
-           representations,
-           [&](const std::string&)
+  const bool finished = goThroughLog(
+                          representations,
+                          [&](const std::string&)
   {
     if(onlyPlaying &&
        (theGameInfo.state != STATE_PLAYING // isStateValid
@@ -289,117 +435,124 @@ bool LogExtractor::saveImages(const std::string& path, const bool raw, const boo
             && theFallDownState.state != FallDownState::staggering)/*isStanding*/))
       return true;
 
-    if(theJPEGImage.timestamp)
-    {
-      theJPEGImage.toCameraImage(theCameraImage); // Assume that CameraImage and JPEGImage are not logged at the same time.
-      theJPEGImage.timestamp = 0;
-    }
-
-    CameraImage* imageToExport = nullptr;
-
-    if(theCameraImage.timestamp)
-      imageToExport = &theCameraImage;
-
-    if(imageToExport)
+    // Assume that CameraImage and JPEGImage are not logged at the same time.
+    const unsigned timestamp = theJPEGImage.timestamp ? theJPEGImage.timestamp : theCameraImage.timestamp;
+    if(timestamp)
     {
       // Frame skipping: only count frames if they are from the upper camera so
       // that always a pair of lower and upper frames is saved
       if(theCameraInfo.camera == CameraInfo::upper && ++skippedImageCount == takeEachNthFrame)
         skippedImageCount = 0;
       if(skippedImageCount != 0)
+      {
+        theJPEGImage.timestamp = theCameraImage.timestamp = 0;
         return true;
+      }
 
-      // Open PNG file
-      const std::string filename = ImageExport::expandImageFileName(folderPath + (theCameraInfo.camera == CameraInfo::upper ? "upper" : "lower"), imageToExport->timestamp);
-      QFile qfile(filename.c_str());
-      qfile.open(QIODevice::WriteOnly);
-
-      // Write image
-      ImageExport::exportImage(*imageToExport, qfile, raw ? ImageExport::raw : ImageExport::rgb);
-      imageToExport->timestamp = 0;
-
-      // Remove IEND chunk
-      qfile.resize(qfile.size() - 12);
-
-      // Write metadata
+      const std::string filename = ImageExport::expandImageFileName(folderPath + (theCameraInfo.camera == CameraInfo::upper ? "upper" : "lower"), timestamp);
       OutBinaryMemory metaData;
       metaData << theCameraInfo;
       metaData << theCameraMatrix;
       metaData << theImageCoordinateSystem;
-      const unsigned int size = static_cast<unsigned int>(metaData.size());
-      for(size_t i = 0; i < 4; i++)
-        qfile.putChar(reinterpret_cast<const char*>(&size)[3 - i]);
-      qfile.write("bhMn");
-      qfile.write(metaData.data(), metaData.size());
-      const unsigned int crc = CRC().update(crcLut, "bhMn", 4).update(crcLut, metaData.data(), metaData.size()).finish();
-      for(size_t i = 0; i < 4; i++)
-        qfile.putChar(reinterpret_cast<const char*>(&crc)[3 - i]);
-
-      // Write IEND chunk
-      const std::array<char, 12> endChunk{ 0, 0, 0, 0, 'I', 'E', 'N', 'D', char(0xae), char(0x42), char(0x60), char(0x82) };
-      qfile.write(endChunk.data(), endChunk.size());
-      qfile.close();
+
+      if(pending.size() >= maxPending)
+      {
+        pending.front().get();
+        pending.pop_front();
+      }
+      pending.emplace_back(WorkerPool::getShared().run(
+                             [&crcLut, raw, filename,
+                              metaData = std::string(metaData.data(), metaData.size()),
+                              jpegImage = theJPEGImage.timestamp ? theJPEGImage : JPEGImage(),
+                              cameraImage = theJPEGImage.timestamp ? CameraImage() : theCameraImage]() mutable
+      {
+        if(jpegImage.timestamp)
+          jpegImage.toCameraImage(cameraImage);
+
+        // Open PNG file
+        QFile qfile(filename.c_str());
+        qfile.open(QIODevice::WriteOnly);
+
+        // Write image
+        ImageExport::exportImage(cameraImage, qfile, raw ? ImageExport::raw : ImageExport::rgb);
+
+        // Remove IEND chunk
+        qfile.resize(qfile.size() - 12);
+
+        // Write metadata
+        const unsigned int size = static_cast<unsigned int>(metaData.size());
+        for(size_t i = 0; i < 4; i++)
+          qfile.putChar(reinterpret_cast<const char*>(&size)[3 - i]);
+        qfile.write("bhMn");
+        qfile.write(metaData.data(), metaData.size());
+        const unsigned int crc = CRC().update(crcLut, "bhMn", 4).update(crcLut, metaData.data(), metaData.size()).finish();
+        for(size_t i = 0; i < 4; i++)
+          qfile.putChar(reinterpret_cast<const char*>(&crc)[3 - i]);
+
+        // Write IEND chunk
+        const std::array<char, 12> endChunk{ 0, 0, 0, 0, 'I', 'E', 'N', 'D', char(0xae), char(0x42), char(0x60), char(0x82) };
+        qfile.write(endChunk.data(), endChunk.size());
+        qfile.close();
+      }));
+      theJPEGImage.timestamp = theCameraImage.timestamp = 0;
     }
 
     return true;
   });
+
+  for(std::future<void>& image : pending)
+    image.get();
+  return finished;
 }
 
 bool LogExtractor::saveInertialSensorData(const std::string& path)
 {
-  DECLARE_REPRESENTATIONS_AND_MAP(
-  {,
-    FrameInfo,
-    InertialSensorData,
-  });
-
-  return saveCSV(path,
-                 [](Out& file, const std::string& sep)
-  {
-    file << "# frame index" << sep << "gyro x" << sep << "gyro y" << sep << "gyro z" << sep << "acc x" << sep << "acc y" << sep << "acc z" << sep << "angle x" << sep << "angle y";
-  },
-  representations,
-  [&](Out& file, const std::string& sep)
-  {
-    file << theFrameInfo.time << sep
-         << static_cast<float>(theInertialSensorData.gyro.x()) << sep
-         << static_cast<float>(theInertialSensorData.gyro.y()) << sep
-         << static_cast<float>(theInertialSensorData.gyro.z()) << sep
-         << theInertialSensorData.acc.x() << sep
-         << theInertialSensorData.acc.y() << sep
-         << theInertialSensorData.acc.z() << sep
-         << static_cast<float>(theInertialSensorData.angle.x()) << sep
-         << static_cast<float>(theInertialSensorData.angle.y());
-  });
+  return saveSensorData(path, "");
 }
 
 bool LogExtractor::saveJointAngleData(const std::string& path)
 {
-  DECLARE_REPRESENTATIONS_AND_MAP(
-  {,
-    FrameInfo,
-    JointAngles,
-    JointRequest,
-  });
+  return saveSensorData("", path);
+}
 
-  return saveCSV(path,
-                 [](Out& file, const std::string& sep)
+bool LogExtractor::saveSensorData(const std::string& inertialSensorDataPath, const std::string& jointAngleDataPath)
+{
+  FrameInfo theFrameInfo;
+  InertialSensorData theInertialSensorData;
+  JointAngles theJointAngles;
+  JointRequest theJointRequest;
+  std::map<const MessageID, Streamable*> representations = {{idFrameInfo, &theFrameInfo}};
+  std::vector<Table> tables;
+
+  if(!inertialSensorDataPath.empty())
   {
-    file << "frame index";
-    for(int i = 0; i < Joints::numOfJoints; i++)
-    {
-      file << sep << "request " << i << sep << "angle " << i;
-    }
-  },
-  representations,
-  [&](Out& file, const std::string& sep)
+    representations[idInertialSensorData] = &theInertialSensorData;
+    Table& table = tables.emplace_back(inertialSensorDataPath);
+    table.add<unsigned>("# frame index", [&] {return theFrameInfo.time;});
+    table.add<float>("gyro x", [&] {return static_cast<float>(theInertialSensorData.gyro.x());});
+    table.add<float>("gyro y", [&] {return static_cast<float>(theInertialSensorData.gyro.y());});
+    table.add<float>("gyro z", [&] {return static_cast<float>(theInertialSensorData.gyro.z());});
+    table.add<float>("acc x", [&] {return theInertialSensorData.acc.x();});
+    table.add<float>("acc y", [&] {return theInertialSensorData.acc.y();});
+    table.add<float>("acc z", [&] {return theInertialSensorData.acc.z();});
+    table.add<float>("angle x", [&] {return static_cast<float>(theInertialSensorData.angle.x());});
+    table.add<float>("angle y", [&] {return static_cast<float>(theInertialSensorData.angle.y());});
+  }
+
+  if(!jointAngleDataPath.empty())
   {
-    file << theFrameInfo.time;
+    representations[idJointAngles] = &theJointAngles;
+    representations[idJointRequest] = &theJointRequest;
+    Table& table = tables.emplace_back(jointAngleDataPath);
+    table.add<unsigned>("frame index", [&] {return theFrameInfo.time;});
     for(int i = 0; i < Joints::numOfJoints; i++)
     {
-      file << sep << theJointRequest.angles[i].toDegrees() << sep << theJointAngles.angles[i].toDegrees();
+      table.add<float>("request " + std::to_string(i), [&theJointRequest, i] {return theJointRequest.angles[i].toDegrees();});
+      table.add<float>("angle " + std::to_string(i), [&theJointAngles, i] {return theJointAngles.angles[i].toDegrees();});
     }
-  });
+  }
+
+  return saveTables(tables, representations);
 }
 
 bool LogExtractor::writeTimingData(const std::string& fileName)
@@ -613,6 +766,61 @@ bool LogExtractor::analyzeRobotStatus()
   return finished;
 }
 
+bool LogExtractor::benchmarkJPEG()
+{
+  DECLARE_REPRESENTATIONS_AND_MAP(
+  {,
+    CameraImage,
+    JPEGImage,
+  });
+
+  using Clock = std::chrono::steady_clock;
+  const unsigned numOfStripes = static_cast<unsigned>(WorkerPool::getShared().getNumOfWorkers());
+  double singleDuration = 0.0;
+  double parallelDuration = 0.0;
+  size_t singleSize = 0;
+  size_t parallelSize = 0;
+  int numOfImages = 0;
+
+  const bool finished = goThroughLog(
+                          representations,
+                          [&](const std::string&)
+  {
+    if(theJPEGImage.timestamp)
+    {
+      theJPEGImage.toCameraImage(theCameraImage); // Assume that CameraImage and JPEGImage are not logged at the same time.
+      theJPEGImage.timestamp = 0;
+    }
+    if(!theCameraImage.timestamp)
+      return true;
+
+    JPEGImage jpegImage;
+    Clock::time_point start = Clock::now();
+    jpegImage.compressAsync(theCameraImage, 1);
+    singleSize += jpegImage.getSize();
+    singleDuration += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    jpegImage.compressAsync(theCameraImage, numOfStripes);
+    parallelSize += jpegImage.getSize();
+    parallelDuration += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    ++numOfImages;
+    theCameraImage.timestamp = 0;
+    return true;
+  });
+
+  if(numOfImages)
+  {
+    OUTPUT_TEXT("Images: " << numOfImages);
+    OUTPUT_TEXT("1 stripe: " << singleDuration / numOfImages << " ms, " << singleSize / numOfImages << " bytes");
+    OUTPUT_TEXT(numOfStripes << " stripes: " << parallelDuration / numOfImages << " ms, " << parallelSize / numOfImages << " bytes");
+  }
+  else
+    OUTPUT_TEXT("No images found.");
+  return finished;
+}
+
 bool LogExtractor::saveLabeledBallSpots(const std::string& path)
 {
   DECLARE_REPRESENTATIONS_AND_MAP(
@@ -638,6 +846,7 @@ bool LogExtractor::saveLabeledBallSpots(const std::string& path)
   {
     if(theLabelImage.valid)
     {
+      GrayscaledImage grayscaled;
       for(const Vector2i& ballSpot : theBallSpots.ballSpots)
       {
         std::stringstream ss;
@@ -695,9 +904,14 @@ bool LogExtractor::saveLabeledBallSpots(const std::string& path)
           Vector2f ballSpotOnField;
           if(!Transformation::imageToRobotHorizontalPlane(ballSpot.cast<float>(), ballSpecification.radius, theCameraMatrix, theCameraInfo, ballSpotOnField))
             continue;
-          CameraImage cameraImage;
-          theJPEGImage.toCameraImage(cameraImage);
-          PatchUtilities::extractPatch(ballSpot, Vector2i(diameter, diameter), Vector2i(32, 32), cameraImage.getGrayscaled(), dest);
+          if(!grayscaled.width)
+          {
+            // Decode the image only once per frame, not once per ball spot.
+            CameraImage cameraImage;
+            theJPEGImage.toCameraImage(cameraImage);
+            grayscaled = cameraImage.getGrayscaled();
+          }
+          PatchUtilities::extractPatch(ballSpot, Vector2i(diameter, diameter), Vector2i(32, 32), grayscaled, dest);
           ImageExport::exportImage(dest, ss.str(), theLabelImage.frameTime, ImageExport::grayscale);
           file << imageNumber << sep
                << theLabelImage.frameTime << sep
@@ -755,6 +969,29 @@ bool LogExtractor::saveCSV(const std::string& fileName, const std::function<void
   return finished;
 }
 
+bool LogExtractor::saveTables(std::vector<Table>& tables, const std::map<const MessageID, Streamable*>& representations)
+{
+  logPlayer.stop(); // Just reset the LogPlayer to start
+  const bool finished = goThroughLog(representations, [&tables](const std::string&)
+  {
+    for(Table& table : tables)
+      table.addRow();
+    return true;
+  });
+
+  // Formatting the text is the expensive part, so all tables are written in parallel.
+  std::vector<std::future<bool>> written;
+  for(const Table& table : tables)
+    written.emplace_back(WorkerPool::getShared().run([&table] {return table.write();}));
+  bool success = finished;
+  for(size_t i = 0; i < tables.size(); ++i)
+    if(written[i].get())
+      OUTPUT_TEXT("File was created successfully: " << tables[i].fileName);
+    else
+      success = false;
+  return success;
+}
+
 bool LogExtractor::goThroughLog(const std::map<const MessageID, Streamable*>& representations, const std::function<bool(const std::string& frameType)>& executeAction)
 {
   std::string frameType;
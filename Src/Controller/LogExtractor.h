@@ -13,6 +13,7 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <vector>
 
 class LogPlayer;
 class Out;
@@ -88,6 +89,18 @@ public:
    */
   bool saveJointAngleData(const std::string& path);
 
+  /**
+   * Writes the inertial sensor data and the joint angle data in a single pass
+   * through the log. The files are the same as the ones written by
+   * saveInertialSensorData and saveJointAngleData.
+   * @param inertialSensorDataPath The path of the file for the inertial sensor
+   *                               data. Nothing is written if it is empty.
+   * @param jointAngleDataPath The path of the file for the joint angle data.
+   *                           Nothing is written if it is empty.
+   * @return whether writing the files was successful or not
+   */
+  bool saveSensorData(const std::string& inertialSensorDataPath, const std::string& jointAngleDataPath);
+
   /**
    * Writes all requested joint angles in a format, that can be pasted as body of an
    * <ActuatorList> tag inside a Choregraphe .xar file timeline. It is assumed that
@@ -109,6 +122,13 @@ public:
    */
   bool analyzeRobotStatus();
 
+  /**
+   * Compresses all images in the log with a single JPEG stripe and with
+   * parallel stripes and prints the average compression times and sizes.
+   * @return true if the benchmark was successful
+   */
+  bool benchmarkJPEG();
+
   /**
    * Saves images of ballSpots and related metadata according to imported labels
    * @param path The path of the file to which the data is written. In addition,
@@ -119,6 +139,8 @@ public:
   bool saveLabeledBallSpots(const std::string& path);
 
 private:
+  class Table;
+
   /**
    * The method creates a new folder with logname in the current logfolder, replacing the prefix.
    * @param prefix The prefix.
@@ -140,6 +162,16 @@ private:
    */
   bool saveCSV(const std::string& fileName, const std::function<void(Out& file, const std::string& sep)>& writeHeader, const std::map<const MessageID, Streamable*>& representations, const std::function<void(Out& file, const std::string& sep)>& writeInFile, const bool noEndl = false);
 
+  /**
+   * Fills several tables in a single pass through the log and writes them in
+   * parallel afterwards. Each table is written as semicolon-separated file and
+   * as a folder of NumPy arrays, one per column.
+   * @param tables The tables. Each gets a row per frame.
+   * @param representations Map with all Representations needed by any table.
+   * @return whether writing the files was successful or not.
+   */
+  bool saveTables(std::vector<Table>& tables, const std::map<const MessageID, Streamable*>& representations);
+
   /**
    * Go through the log and execute an action after each frame.
    * @param representations Map with all needed Representations.
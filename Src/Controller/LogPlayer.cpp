@@ -16,6 +16,7 @@
 #include "Representations/Modeling/LabelImage.h"
 #include "Tools/Debugging/DebugImages.h"
 #include "Tools/Logging/LoggingTools.h"
+#include <algorithm>
 
 #include <snappy-c.h>
 
@@ -338,16 +339,11 @@ MessageQueue LogPlayer::copyNextFrame()
 void LogPlayer::keep(const std::function<bool(InMessage&)>& filter)
 {
   stop();
-  LogPlayer temp(static_cast<MessageQueue&>(*this));
-  temp.setSize(queue.getSize());
-  moveAllMessages(temp);
-  for(temp.currentMessageNumber = 0; temp.currentMessageNumber < temp.getNumberOfMessages(); ++temp.currentMessageNumber)
+  queue.filter([&](int)
   {
-    temp.queue.setSelectedMessageForReading(temp.currentMessageNumber);
-    temp.in.text.reset();
-    if(filter(temp.in))
-      temp.copyMessage(temp.currentMessageNumber, *this);
-  }
+    in.text.reset();
+    return filter(in);
+  });
   countFrames();
   if(!frameIndex.empty())
     createIndices();
@@ -356,31 +352,30 @@ void LogPlayer::keep(const std::function<bool(InMessage&)>& filter)
 void LogPlayer::keepFrames(const std::function<bool(InMessage&)>& filter)
 {
   stop();
-  LogPlayer temp(static_cast<MessageQueue&>(*this));
-  temp.setSize(queue.getSize());
-  moveAllMessages(temp);
-  temp.queue.createIndex();
+
+  // Mark all messages of frames to keep first, because the decision is only made at the end of each frame.
+  std::vector<bool> keepMessage(getNumberOfMessages(), false);
   int frameStart = -1;
   bool keepFrame = false;
-  for(temp.currentMessageNumber = 0; temp.currentMessageNumber < temp.getNumberOfMessages(); ++temp.currentMessageNumber)
+  for(int i = 0; i < getNumberOfMessages(); ++i)
   {
-    temp.queue.setSelectedMessageForReading(temp.currentMessageNumber);
-    temp.in.text.reset();
-    keepFrame |= filter(temp.in);
-    if(temp.queue.getMessageID() == idFrameBegin)
+    queue.setSelectedMessageForReading(i);
+    in.text.reset();
+    keepFrame |= filter(in);
+    if(queue.getMessageID() == idFrameBegin)
     {
-      frameStart = temp.currentMessageNumber;
+      frameStart = i;
       keepFrame = false;
     }
-    else if(temp.queue.getMessageID() == idFrameFinished && keepFrame)
+    else if(queue.getMessageID() == idFrameFinished && keepFrame)
     {
-      int thisFrame = temp.currentMessageNumber;
-      for(temp.currentMessageNumber = frameStart; temp.currentMessageNumber <= thisFrame; ++temp.currentMessageNumber)
-        temp.copyMessage(temp.currentMessageNumber, *this);
-      temp.currentMessageNumber = thisFrame;
+      if(frameStart >= 0)
+        std::fill(keepMessage.begin() + frameStart, keepMessage.begin() + i + 1, true);
       keepFrame = false;
     }
   }
+
+  queue.filter([&](int message) {return keepMessage[message];});
   countFrames();
   if(!frameIndex.empty())
     createIndices();
@@ -389,29 +384,25 @@ void LogPlayer::keepFrames(const std::function<bool(InMessage&)>& filter)
 void LogPlayer::keepFramesByThreadIdentifier(const std::function<bool(std::string)>& filter)
 {
   stop();
-  LogPlayer temp(static_cast<MessageQueue&>(*this));
-  temp.setSize(queue.getSize());
-  moveAllMessages(temp);
-  temp.queue.createIndex();
+  std::vector<bool> keepMessage(getNumberOfMessages(), false);
   int frameStart = -1;
   bool keepFrame = false;
-  for(temp.currentMessageNumber = 0; temp.currentMessageNumber < temp.getNumberOfMessages(); ++temp.currentMessageNumber)
+  for(int i = 0; i < getNumberOfMessages(); ++i)
   {
-    temp.queue.setSelectedMessageForReading(temp.currentMessageNumber);
-    if(temp.queue.getMessageID() == idFrameBegin)
+    queue.setSelectedMessageForReading(i);
+    if(queue.getMessageID() == idFrameBegin)
     {
-      frameStart = temp.currentMessageNumber;
-      keepFrame = filter(temp.in.readThreadIdentifier());
+      frameStart = i;
+      keepFrame = filter(in.readThreadIdentifier());
     }
-    else if(temp.queue.getMessageID() == idFrameFinished && keepFrame)
+    else if(queue.getMessageID() == idFrameFinished && keepFrame)
     {
-      int thisFrame = temp.currentMessageNumber;
-      for(temp.currentMessageNumber = frameStart; temp.currentMessageNumber <= thisFrame; ++temp.currentMessageNumber)
-        temp.copyMessage(temp.currentMessageNumber, *this);
-      temp.currentMessageNumber = thisFrame;
+      std::fill(keepMessage.begin() + frameStart, keepMessage.begin() + i + 1, true);
       keepFrame = false;
     }
   }
+
+  queue.filter([&](int message) {return keepMessage[message];});
   countFrames();
   if(!frameIndex.empty())
     createIndices();
@@ -420,16 +411,9 @@ void LogPlayer::keepFramesByThreadIdentifier(const std::function<bool(std::strin
 void LogPlayer::trim(int startFrame, int endFrame)
 {
   stop();
-  LogPlayer temp(static_cast<MessageQueue&>(*this));
-  temp.setSize(queue.getSize());
-  moveAllMessages(temp);
-  temp.queue.createIndex();
-
-  for(int i = frameIndex[startFrame]; i < frameIndex[endFrame]; i++)
-  {
-    temp.copyMessage(i, *this);
-  }
-
+  const int begin = frameIndex[startFrame];
+  const int end = frameIndex[endFrame];
+  queue.filter([begin, end](int message) {return message >= begin && message < end;});
   countFrames();
   if(!frameIndex.empty())
     createIndices();
@@ -438,14 +422,29 @@ void LogPlayer::trim(int startFrame, int endFrame)
 void LogPlayer::keep(const std::vector<int>& messageNumbers)
 {
   stop();
-  LogPlayer temp(static_cast<MessageQueue&>(*this));
-  temp.setSize(queue.getSize());
-  moveAllMessages(temp);
-
-  for(auto& messageNumber : messageNumbers)
+  if(std::is_sorted(messageNumbers.begin(), messageNumbers.end(), std::less_equal<int>()))
   {
-    temp.queue.setSelectedMessageForReading(messageNumber);
-    temp.copyMessage(messageNumber, *this);
+    // The order is kept, so the messages can be filtered in place.
+    auto next = messageNumbers.begin();
+    queue.filter([&](int message)
+    {
+      if(next == messageNumbers.end() || *next != message)
+        return false;
+      ++next;
+      return true;
+    });
+  }
+  else
+  {
+    LogPlayer temp(static_cast<MessageQueue&>(*this));
+    temp.setSize(queue.getSize());
+    moveAllMessages(temp);
+
+    for(auto& messageNumber : messageNumbers)
+    {
+      temp.queue.setSelectedMessageForReading(messageNumber);
+      temp.copyMessage(messageNumber, *this);
+    }
   }
   countFrames();
   if(!frameIndex.empty())
@@ -478,7 +477,7 @@ void LogPlayer::statistics(int frequencies[numOfDataMessageIDs], unsigned* sizes
       {
         ++frequencies[queue.getMessageID()];
         if(sizes)
-          sizes[queue.getMessageID()] += queue.getMessageSize() + 4;
+          sizes[queue.getMessageID()] += queue.getMessageSize() + queue.getHeaderSize(queue.selectedMessageForReadingPosition);
       }
     }
     queue.setSelectedMessageForReading(current);
@@ -0,0 +1,207 @@
+/**
+ * @file Controller/MotionBenchmark.cpp
+ *
+ * This file implements a class that collects the execution times and heap
+ * allocations of the modules of the Motion thread while a log file is
+ * replayed and records the joint requests produced.
+ */
+
+#include "MotionBenchmark.h"
+#include "Tools/MessageQueue/InMessage.h"
+#include "Tools/Streams/InStreams.h"
+#include "Tools/Streams/OutStreams.h"
+#include <algorithm>
+#include <cmath>
+
+void MotionBenchmark::start(const std::string& reportFileName, const std::string& jointRequestsFileName, const std::string& baselineFileName)
+{
+  this->reportFileName = reportFileName;
+  this->jointRequestsFileName = jointRequestsFileName;
+  this->baselineFileName = baselineFileName;
+  watchNames.clear();
+  times.clear();
+  allocations.clear();
+  jointRequests.clear();
+}
+
+void MotionBenchmark::addTimes(InMessage& message)
+{
+  if(!isActive())
+    return;
+
+  // Same format as read by TimeInfo::handleMessage
+  unsigned short nameCount;
+  message.bin >> nameCount;
+  for(unsigned short i = 0; i < nameCount; ++i)
+  {
+    unsigned short watchId;
+    std::string watchName;
+    message.bin >> watchId >> watchName;
+    watchNames[watchId] = watchName;
+  }
+
+  unsigned short dataCount;
+  message.bin >> dataCount;
+  for(unsigned short i = 0; i < dataCount; ++i)
+  {
+    unsigned short watchId;
+    unsigned time;
+    message.bin >> watchId >> time;
+    times[watchId].push_back(time);
+  }
+
+  unsigned threadStartTime;
+  unsigned frameNo;
+  message.bin >> threadStartTime >> frameNo;
+  if(!message.bin.getEof())
+  {
+    unsigned short allocationCount;
+    message.bin >> allocationCount;
+    for(unsigned short i = 0; i < allocationCount; ++i)
+    {
+      unsigned short watchId;
+      unsigned count;
+      unsigned bytes;
+      message.bin >> watchId >> count >> bytes;
+      Allocations& watchAllocations = allocations[watchId];
+      watchAllocations.count += count;
+      watchAllocations.bytes += bytes;
+      watchAllocations.maxCount = std::max(watchAllocations.maxCount, count);
+    }
+  }
+}
+
+void MotionBenchmark::addJointRequest(InMessage& message)
+{
+  if(!isActive())
+    return;
+
+  jointRequests.emplace_back(message.getMessageSize());
+  if(!jointRequests.back().empty())
+    message.bin.read(jointRequests.back().data(), jointRequests.back().size());
+}
+
+std::string MotionBenchmark::finish()
+{
+  std::string summary = std::to_string(jointRequests.size()) + " joint requests";
+
+  if(!jointRequestsFileName.empty())
+  {
+    OutBinaryFile file(jointRequestsFileName);
+    if(file.exists())
+    {
+      file << static_cast<unsigned>(jointRequests.size());
+      for(const Data& data : jointRequests)
+      {
+        file << static_cast<unsigned>(data.size());
+        file.write(data.data(), data.size());
+      }
+    }
+    else
+      summary += ", cannot write " + jointRequestsFileName;
+  }
+
+  size_t differences = 0;
+  int firstDifference = -1;
+  if(!baselineFileName.empty())
+  {
+    if(compareWithBaseline(differences, firstDifference))
+      summary += ", " + std::to_string(differences) + " differ from the baseline";
+    else
+      summary += ", cannot read " + baselineFileName;
+  }
+
+  if(!writeReport(differences, firstDifference))
+    summary += ", cannot write " + reportFileName;
+
+  reportFileName.clear();
+  return summary;
+}
+
+bool MotionBenchmark::compareWithBaseline(size_t& differences, int& firstDifference) const
+{
+  InBinaryFile file(baselineFileName);
+  if(!file.exists())
+    return false;
+
+  unsigned numOfFrames;
+  file >> numOfFrames;
+  Data baseline;
+  for(unsigned i = 0; i < numOfFrames && i < jointRequests.size(); ++i)
+  {
+    unsigned size;
+    file >> size;
+    baseline.resize(size);
+    if(size)
+      file.read(baseline.data(), size);
+    if(baseline != jointRequests[i])
+    {
+      if(firstDifference < 0)
+        firstDifference = static_cast<int>(i);
+      ++differences;
+    }
+  }
+
+  const size_t numOfCommonFrames = std::min(static_cast<size_t>(numOfFrames), jointRequests.size());
+  if(numOfFrames != jointRequests.size())
+  {
+    if(firstDifference < 0)
+      firstDifference = static_cast<int>(numOfCommonFrames);
+    differences += std::max(static_cast<size_t>(numOfFrames), jointRequests.size()) - numOfCommonFrames;
+  }
+  return true;
+}
+
+bool MotionBenchmark::writeReport(size_t differences, int firstDifference) const
+{
+  OutTextRawFile file(reportFileName);
+  if(!file.exists())
+    return false;
+
+  struct Statistics
+  {
+    std::string name;
+    size_t samples;
+    float p50;
+    float p99;
+    float max;
+    float avg;
+    Allocations allocations;
+  };
+  std::vector<Statistics> statistics;
+  for(const auto& [watchId, watchTimes] : times)
+  {
+    const auto watchName = watchNames.find(watchId);
+    if(watchName == watchNames.end() || watchTimes.empty())
+      continue;
+
+    std::vector<unsigned> sorted(watchTimes);
+    std::sort(sorted.begin(), sorted.end());
+
+    // The nearest-rank method.
+    auto percentile = [&sorted](float p)
+    {
+      const size_t rank = static_cast<size_t>(std::ceil(p * static_cast<float>(sorted.size())));
+      return static_cast<float>(sorted[std::max(rank, size_t(1)) - 1]) / 1000.f;
+    };
+    unsigned long long sum = 0;
+    for(unsigned time : sorted)
+      sum += time;
+    statistics.push_back({watchName->second, sorted.size(), percentile(0.5f), percentile(0.99f),
+                          static_cast<float>(sorted.back()) / 1000.f,
+                          static_cast<float>(sum) / static_cast<float>(sorted.size()) / 1000.f,
+                          allocations.count(watchId) ? allocations.at(watchId) : Allocations()});
+  }
+  std::sort(statistics.begin(), statistics.end(), [](const Statistics& a, const Statistics& b) {return a.max > b.max;});
+
+  const std::string sep = ";";
+  file << "jointRequests" << sep << "differences" << sep << "firstDifference" << endl;
+  file << static_cast<unsigned>(jointRequests.size()) << sep << static_cast<unsigned>(differences) << sep << firstDifference << endl;
+
+  file << endl << "stopwatch" << sep << "samples" << sep << "p50" << sep << "p99" << sep << "max" << sep << "avg" << sep
+       << "allocations" << sep << "allocationsMax" << sep << "allocatedBytes" << endl;
+  for(const Statistics& s : statistics)
+    file << s.name << sep << static_cast<unsigned>(s.samples) << sep << s.p50 << sep << s.p99 << sep << s.max << sep << s.avg << sep
+         << static_cast<unsigned>(s.allocations.count) << sep << s.allocations.maxCount << sep << static_cast<unsigned>(s.allocations.bytes) << endl;
+  return true;
+}
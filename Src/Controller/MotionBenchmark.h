@@ -0,0 +1,91 @@
+/**
+ * @file Controller/MotionBenchmark.h
+ *
+ * This file declares a class that collects the execution times and heap
+ * allocations of the modules of the Motion thread while a log file is
+ * replayed and records the joint requests produced. The joint requests can
+ * be compared bitwise with the ones recorded in an earlier run (see
+ * Make/Common/benchmarkMotion).
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class InMessage;
+
+class MotionBenchmark
+{
+public:
+  /**
+   * Starts a benchmark. All data collected before is discarded.
+   * @param reportFileName The name of the file the report is written to.
+   * @param jointRequestsFileName The name of the file the joint requests are
+   *                              written to. No file is written if it is empty.
+   * @param baselineFileName The name of a file written by an earlier run as
+   *                         jointRequestsFileName. The joint requests are
+   *                         compared with its contents if it is not empty.
+   */
+  void start(const std::string& reportFileName, const std::string& jointRequestsFileName, const std::string& baselineFileName);
+
+  /** Is a benchmark running? */
+  bool isActive() const {return !reportFileName.empty();}
+
+  /**
+   * Collects the execution times and allocations from a stopwatch message of the Motion thread.
+   * The message must be reset afterwards.
+   * @param message The stopwatch message.
+   */
+  void addTimes(InMessage& message);
+
+  /**
+   * Records a joint request message of the Motion thread.
+   * The message must be reset afterwards.
+   * @param message The joint request message.
+   */
+  void addJointRequest(InMessage& message);
+
+  /**
+   * Ends the benchmark and writes the report and the joint requests.
+   * @return A short summary of the result.
+   */
+  std::string finish();
+
+private:
+  using Data = std::vector<char>; /**< The binary representation of a joint request. */
+
+  std::string reportFileName; /**< The file the report is written to. Empty if no benchmark is running. */
+  std::string jointRequestsFileName; /**< The file the joint requests are written to. */
+  std::string baselineFileName; /**< The file the joint requests are compared with. */
+  std::unordered_map<unsigned short, std::string> watchNames; /**< The names of the stopwatches by their ids. */
+  std::unordered_map<unsigned short, std::vector<unsigned>> times; /**< All execution times measured by each stopwatch (in µs). */
+
+  /** The heap allocations while a stopwatch was running. */
+  struct Allocations
+  {
+    unsigned long long count = 0; /**< The overall number of allocations. */
+    unsigned long long bytes = 0; /**< The overall number of bytes allocated. */
+    unsigned maxCount = 0; /**< The maximum number of allocations in a single frame. */
+  };
+  std::unordered_map<unsigned short, Allocations> allocations; /**< The heap allocations of each stopwatch. */
+  std::vector<Data> jointRequests; /**< All joint requests received in the order of the frames. */
+
+  /**
+   * Compares the joint requests with the ones in the baseline file.
+   * @param differences The number of frames in which they differ. Missing
+   *                    frames at the end of either sequence are counted as well.
+   * @param firstDifference The first frame in which they differ or -1 if there is none.
+   * @return Could the baseline file be read?
+   */
+  bool compareWithBaseline(size_t& differences, int& firstDifference) const;
+
+  /**
+   * Writes the report.
+   * @param differences The number of frames in which the joint requests differ from the baseline.
+   * @param firstDifference The first frame in which they differ or -1 if there is none.
+   * @return Could the file be written?
+   */
+  bool writeReport(size_t differences, int firstDifference) const;
+};
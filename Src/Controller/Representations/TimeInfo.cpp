@@ -11,6 +11,7 @@
 #include "Platform/Time.h"
 #include "Platform/BHAssert.h"
 #include <iostream>
+#include <vector>
 
 void TimeInfo::reset()
 {
@@ -46,6 +47,7 @@ bool TimeInfo::handleMessage(InMessage& message, bool justReadNames)
     unsigned short dataCount;
     message.bin >> dataCount;
 
+    std::vector<unsigned short> watchIds;
     for(int i = 0; i < dataCount; ++i)
     {
       unsigned short watchId;
@@ -53,7 +55,10 @@ bool TimeInfo::handleMessage(InMessage& message, bool justReadNames)
       message.bin >> watchId;
       message.bin >> time;
       if(!justReadNames)
+      {
         infos[watchId].push_front(static_cast<float>(time));
+        watchIds.push_back(watchId);
+      }
       infos[watchId].timestamp = Time::getCurrentSystemTime();
     }
 
@@ -65,6 +70,43 @@ bool TimeInfo::handleMessage(InMessage& message, bool justReadNames)
     unsigned frameNo;
     message.bin >> frameNo;
 
+    // Older messages do not contain allocations.
+    std::unordered_map<unsigned short, std::pair<unsigned, unsigned>> allocations;
+    if(!message.bin.getEof())
+    {
+      unsigned short allocationCount;
+      message.bin >> allocationCount;
+      for(int i = 0; i < allocationCount; ++i)
+      {
+        unsigned short watchId;
+        std::pair<unsigned, unsigned> countAndBytes;
+        message.bin >> watchId >> countAndBytes.first >> countAndBytes.second;
+        allocations[watchId] = countAndBytes;
+      }
+    }
+    for(unsigned short watchId : watchIds)
+    {
+      const auto countAndBytes = allocations.find(watchId);
+      Info& info = infos[watchId];
+      info.allocations.push_front(countAndBytes == allocations.end() ? 0.f : static_cast<float>(countAndBytes->second.first));
+      info.allocatedBytes.push_front(countAndBytes == allocations.end() ? 0.f : static_cast<float>(countAndBytes->second.second));
+    }
+
+    // Only a few histograms are sent per frame. Older messages do not contain them.
+    if(!message.bin.getEof())
+    {
+      unsigned short histogramCount;
+      message.bin >> histogramCount;
+      for(int i = 0; i < histogramCount; ++i)
+      {
+        unsigned short watchId;
+        message.bin >> watchId;
+        Info& info = infos[watchId];
+        message.bin >> info.misses;
+        info.histogram.read(message.bin);
+      }
+    }
+
     int diff = frameNo - lastFrameNo;
     //sometimes we do not get data every frame. Compensate by assuming that the missing frames have
     // the same timing as the last one
@@ -89,6 +131,20 @@ void TimeInfo::getStatistics(const Info& info, float& minTime, float& maxTime, f
   maxTime = info.maximum() / 1000.0f;
 }
 
+void TimeInfo::getAllocationStatistics(const Info& info, float& avgAllocations, float& avgBytes) const
+{
+  avgAllocations = info.allocations.average();
+  avgBytes = info.allocatedBytes.average();
+}
+
+void TimeInfo::getPercentiles(const Info& info, float& p50, float& p90, float& p99, float& p999) const
+{
+  p50 = static_cast<float>(info.histogram.getPercentile(0.5f)) / 1000.0f;
+  p90 = static_cast<float>(info.histogram.getPercentile(0.9f)) / 1000.0f;
+  p99 = static_cast<float>(info.histogram.getPercentile(0.99f)) / 1000.0f;
+  p999 = static_cast<float>(info.histogram.getPercentile(0.999f)) / 1000.0f;
+}
+
 void TimeInfo::getThreadStatistics(float& outAvgFreq, float& outMin, float& outMax) const
 {
   outAvgFreq = threadDeltas.sum() != 0.f ? 1000.0f / threadDeltas.average() : 0.f;
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Tools/RingBufferWithSum.h"
+#include "Tools/Debugging/TimingHistogram.h"
 
 #include <string>
 #include <unordered_map>
@@ -20,6 +21,10 @@ class InfoWithTimestamp : public RingBufferWithSum<float, 100>
 {
 public:
   unsigned int timestamp = 0;
+  RingBufferWithSum<float, 100> allocations; /**< The number of heap allocations per frame. */
+  RingBufferWithSum<float, 100> allocatedBytes; /**< The number of bytes allocated per frame. */
+  TimingHistogram histogram; /**< The times of all frames since the start of the thread or the last reset as received last. */
+  unsigned misses = 0; /**< The number of frames since the start of the thread or the last reset that exceeded the deadline. */
 };
 
 /**
@@ -72,6 +77,24 @@ public:
    */
   void getStatistics(const Info& info, float& outMinTime, float& outMaxTime, float& outAvgTime) const;
 
+  /**
+   * The function returns statistics about the heap allocations while a certain stop watch was running.
+   * @param info Information on the stop watch to query.
+   * @param avgAllocations The average number of allocations per frame is returned to this variable.
+   * @param avgBytes The average number of bytes allocated per frame is returned to this variable.
+   */
+  void getAllocationStatistics(const Info& info, float& avgAllocations, float& avgBytes) const;
+
+  /**
+   * The function returns percentiles of all times measured by a certain stop watch since the start of its thread.
+   * @param info Information on the stop watch to query.
+   * @param p50 The median is returned to this variable in ms.
+   * @param p90 The 90th percentile is returned to this variable in ms.
+   * @param p99 The 99th percentile is returned to this variable in ms.
+   * @param p999 The 99.9th percentile is returned to this variable in ms.
+   */
+  void getPercentiles(const Info& info, float& p50, float& p90, float& p99, float& p999) const;
+
   /**
    * Returns the frequency of the process attached to this time info.
    */
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <map>
 #include <cctype>
 #include "Platform/Time.h"
 #include "Representations/Infrastructure/CameraInfo.h"
@@ -271,13 +272,18 @@ bool RobotTextConsole::handleMessage(InMessage& message)
       return true;
     }
     case idDebugImage:
+    case idCompressedDebugImage:
     {
       std::string id;
       message.bin >> id;
       if(!incompleteImages[id].image)
         incompleteImages[id].image = new DebugImage();
-      message.bin >> *incompleteImages[id].image;
+      if(message.getMessageID() == idCompressedDebugImage)
+        incompleteImages[id].image->readCompressed(message.bin);
+      else
+        message.bin >> *incompleteImages[id].image;
       incompleteImages[id].image->timestamp = Time::getCurrentSystemTime();
+      incompleteImages[id].streamedSize = message.getMessageSize();
       break;
     }
     case idFsrSensorData:
@@ -378,6 +384,7 @@ bool RobotTextConsole::handleMessage(InMessage& message)
         ImagePtr& imagePtr = data.images[pair.first];
         imagePtr.image = pair.second.image;
         imagePtr.threadIdentifier = threadIdentifier;
+        imagePtr.streamedSize = pair.second.streamedSize;
         pair.second.image = nullptr;
       }
 
@@ -819,6 +826,8 @@ bool RobotTextConsole::handleConsoleLine(const std::string& line)
     ctrl->printLn("_cls");
     result = true;
   }
+  else if(command == "dis")
+    result = debugImageStatistics(stream);
   else if(command == "dr")
   {
     PREREQUISITE(idDebugResponse);
@@ -1241,6 +1250,8 @@ bool RobotTextConsole::log(In& stream)
   }
   else if(command == "analyzeRobotStatus")
     return logExtractor.analyzeRobotStatus();
+  else if(command == "benchmarkJPEG")
+    return logExtractor.benchmarkJPEG();
   else if(command == "saveImages")
   {
     SYNC;
@@ -1281,10 +1292,17 @@ bool RobotTextConsole::log(In& stream)
 
     return logExtractor.saveImages(command, raw, onlyPlaying, takeEachNthFrame);
   }
+  else if(command == "resetTimingHistograms")
+  {
+    SYNC;
+    resetTimingHistograms();
+    return true;
+  }
   else if(command == "saveInertialSensorData"
           || command == "saveJointAngleData"
           || command == "saveLabeledBallSpots"
-          || command == "saveTiming")
+          || command == "saveTiming"
+          || command == "saveTimingHistograms")
   {
     SYNC;
     std::string name;
@@ -1308,6 +1326,23 @@ bool RobotTextConsole::log(In& stream)
       return logExtractor.saveLabeledBallSpots(name);
     else if(command == "saveTiming")
       return logExtractor.writeTimingData(name);;
+    else if(command == "saveTimingHistograms")
+      return saveTimingHistograms(name);
+  }
+  else if(command == "saveSensorData")
+  {
+    SYNC;
+    std::string name;
+    stream >> name;
+    if(name.empty())
+    {
+      std::string::size_type pos = logPlayer.logfilePath.rfind('.');
+      if(pos == std::string::npos)
+        return false;
+      else
+        name = logPlayer.logfilePath.substr(0, pos);
+    }
+    return logExtractor.saveSensorData(name + "_InertialSensorData.csv", name + "_JointAngleData.csv");
   }
   else if(command == "saveChoregrapheTimeline")
   {
@@ -1958,6 +1993,54 @@ void RobotTextConsole::printType(const std::string& type, const std::string& fie
   }
 }
 
+bool RobotTextConsole::saveTimingHistograms(const std::string& fileName) const
+{
+  OutTextRawFile file(fileName);
+  if(!file.exists())
+    return false;
+
+  // Sort by thread and stopwatch to simplify comparing files.
+  std::map<std::string, std::map<std::string, const TimeInfo::Info*>> histograms;
+  for(const auto& [thread, data] : threadData)
+    for(const auto& [watchId, info] : data.timeInfo.infos)
+      if(info.histogram.getTotal())
+        histograms[thread][data.timeInfo.getName(watchId)] = &info;
+
+  const std::string sep = ";";
+  file << "thread" << sep << "stopwatch" << sep << "samples" << sep << "p50" << sep << "p90" << sep << "p99" << sep << "p99.9" << sep << "max" << sep << "misses" << endl;
+  for(const auto& [thread, infos] : histograms)
+    for(const auto& [name, info] : infos)
+    {
+      const TimingHistogram& histogram = info->histogram;
+      file << thread << sep << name << sep << histogram.getTotal() << sep
+           << histogram.getPercentile(0.5f) / 1000.f << sep << histogram.getPercentile(0.9f) / 1000.f << sep
+           << histogram.getPercentile(0.99f) / 1000.f << sep << histogram.getPercentile(0.999f) / 1000.f << sep
+           << histogram.getPercentile(1.f) / 1000.f << sep << info->misses << endl;
+    }
+
+  file << endl << "thread" << sep << "stopwatch" << sep << "lowerBound" << sep << "upperBound" << sep << "count" << endl;
+  for(const auto& [thread, infos] : histograms)
+    for(const auto& [name, info] : infos)
+      for(unsigned i = 0; i < TimingHistogram::numOfBuckets; ++i)
+        if(info->histogram.getCount(i))
+          file << thread << sep << name << sep << TimingHistogram::getLowerBound(i) / 1000.f << sep
+               << TimingHistogram::getUpperBound(i) / 1000.f << sep
+               << info->histogram.getCount(i) << endl;
+  return true;
+}
+
+void RobotTextConsole::resetTimingHistograms()
+{
+  debugSender->out.bin << DebugRequest("timing:resetHistograms", true);
+  debugSender->out.finishMessage(idDebugRequest);
+  for(auto& [thread, data] : threadData)
+    for(auto& [watchId, info] : data.timeInfo.infos)
+    {
+      info.histogram.clear();
+      info.misses = 0;
+    }
+}
+
 bool RobotTextConsole::repoll(In&)
 {
   polled[idDebugResponse] = polled[idDrawingManager] = polled[idDrawingManager3D] = false;
@@ -2567,6 +2650,23 @@ bool RobotTextConsole::viewImage(In& stream)
   return false;
 }
 
+bool RobotTextConsole::debugImageStatistics(In& stream)
+{
+  std::string pattern;
+  stream >> pattern;
+  SYNC;
+  for(const auto& [thread, data] : threadData)
+    for(const auto& [name, imagePtr] : data.images)
+      if(imagePtr.image && imagePtr.streamedSize && (pattern.empty() || (thread + ":" + name).find(pattern) != std::string::npos))
+      {
+        const size_t rawSize = imagePtr.image->width * imagePtr.image->height * PixelTypes::pixelSize(imagePtr.image->type);
+        ctrl->printLn(thread + ":" + name + ": " + TypeRegistry::getEnumName(imagePtr.image->encoding) + ", "
+                      + std::to_string(imagePtr.streamedSize) + " bytes/frame ("
+                      + std::to_string(rawSize ? imagePtr.streamedSize * 100 / rawSize : 0) + "% of raw)");
+      }
+  return true;
+}
+
 bool RobotTextConsole::viewImageCommand(In& stream)
 {
   std::string view;
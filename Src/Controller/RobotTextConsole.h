@@ -79,6 +79,7 @@ public:
   {
     DebugImage* image = nullptr;
     std::string threadIdentifier;
+    size_t streamedSize = 0; /**< The size of the message that contained the image. */
 
     ~ImagePtr() { reset(); }
 
@@ -232,6 +233,7 @@ protected:
   Vector3f movePos = Vector3f::Zero(); /**< The position the robot is moved to. */
   Vector3f moveRot = Vector3f::Zero(); /**< The rotation the robot is moved to. */
   bool jointCalibrationChanged = false; /**< Was the joint calibration changed since setting it for the local robot? */
+  std::string threadIdentifier; /** The thread from which messages are currently read. */
 
   // Representations received
   FrameInfo frameInfo; /**< The new frame info received from the robot code. */
@@ -258,7 +260,6 @@ private:
   int waitingFor[numOfMessageIDs]; /**< Each entry states for how many information packets the thread waits. */
   bool polled[numOfMessageIDs]; /**< Each entry states whether certain information is up-to-date (if not waiting for). */
   std::string getOrSetWaitsFor; /**< The name of the representation get or set are waiting for. If empty, they are not waiting for any. */
-  std::string threadIdentifier; /** The thread from which messages are currently read. */
 
   // Flags
   bool printMessages = true; /**< Decides whether to output text messages in the console window. */
@@ -466,6 +467,20 @@ private:
   /** Send module request to robot if it was changed. */
   void sendModuleRequest();
 
+  /**
+   * Writes the timing histograms of all threads to a csv file. The file
+   * contains a summary per stopwatch followed by the non-empty buckets.
+   * @param fileName The name of the file.
+   * @return Could the file be written?
+   */
+  bool saveTimingHistograms(const std::string& fileName) const;
+
+  /**
+   * Clears the timing histograms of all threads, both the ones received and,
+   * through a debug request, the ones the threads collect.
+   */
+  void resetTimingHistograms();
+
   //!@name Handler for different console commands
   //!@{
   bool msg(In&);
@@ -490,6 +505,7 @@ private:
   bool viewDrawing(In& stream, RobotTextConsole::Views& views, const char* type);
   bool viewImage(In& stream);
   bool viewImageCommand(In& stream);
+  bool debugImageStatistics(In& stream);
   bool viewPlot(In& stream);
   bool viewPlotDrawing(In& stream);
   //!@}
@@ -38,19 +38,26 @@ struct Row
   NumberTableWidgetItem* min;
   NumberTableWidgetItem* max;
   NumberTableWidgetItem* avg;
+  NumberTableWidgetItem* p50;
+  NumberTableWidgetItem* p90;
+  NumberTableWidgetItem* p99;
+  NumberTableWidgetItem* p999;
+  NumberTableWidgetItem* misses;
+  NumberTableWidgetItem* allocations;
+  NumberTableWidgetItem* bytes;
 };
 
 TimeWidget::TimeWidget(TimeView& timeView) : timeView(timeView)
 {
   table = new QTableWidget();
-  table->setColumnCount(4);
+  table->setColumnCount(11);
   QStringList headerNames;
-  headerNames << "Stopwatch" << "Min" << "Max" << "Avg";
+  headerNames << "Stopwatch" << "Min" << "Max" << "Avg" << "P50" << "P90" << "P99" << "P99.9" << "Misses" << "Allocs" << "Bytes";
   table->setHorizontalHeaderLabels(headerNames);
   table->verticalHeader()->setVisible(false);
   table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
   table->verticalHeader()->setDefaultSectionSize(15);
-  table->horizontalHeader()->setSectionResizeMode(3, QHeaderView::Stretch);
+  table->horizontalHeader()->setSectionResizeMode(10, QHeaderView::Stretch);
   table->setEditTriggers(QAbstractItemView::NoEditTriggers);
   table->setAlternatingRowColors(true);
   table->setSortingEnabled(true);
@@ -147,12 +154,26 @@ void TimeWidget::update()
         currentRow->max = new NumberTableWidgetItem();
         currentRow->min = new NumberTableWidgetItem();
         currentRow->name = new QTableWidgetItem();
+        currentRow->p50 = new NumberTableWidgetItem();
+        currentRow->p90 = new NumberTableWidgetItem();
+        currentRow->p99 = new NumberTableWidgetItem();
+        currentRow->p999 = new NumberTableWidgetItem();
+        currentRow->misses = new NumberTableWidgetItem();
+        currentRow->allocations = new NumberTableWidgetItem();
+        currentRow->bytes = new NumberTableWidgetItem();
         const int rowCount = table->rowCount();
         table->setRowCount(rowCount + 1);
         table->setItem(rowCount, 0, currentRow->name);
         table->setItem(rowCount, 1, currentRow->min);
         table->setItem(rowCount, 2, currentRow->max);
         table->setItem(rowCount, 3, currentRow->avg);
+        table->setItem(rowCount, 4, currentRow->p50);
+        table->setItem(rowCount, 5, currentRow->p90);
+        table->setItem(rowCount, 6, currentRow->p99);
+        table->setItem(rowCount, 7, currentRow->p999);
+        table->setItem(rowCount, 8, currentRow->misses);
+        table->setItem(rowCount, 9, currentRow->allocations);
+        table->setItem(rowCount, 10, currentRow->bytes);
         items[infoPair.first] = currentRow;
       }
       float minTime = -1, maxTime = -1, avgTime = -1;
@@ -163,6 +184,17 @@ void TimeWidget::update()
       currentRow->avg->setText(QString::number(avgTime));
       currentRow->min->setText(QString::number(minTime));
       currentRow->max->setText(QString::number(maxTime));
+      float p50 = 0.f, p90 = 0.f, p99 = 0.f, p999 = 0.f;
+      timeView.info.getPercentiles(infoPair.second, p50, p90, p99, p999);
+      currentRow->p50->setText(QString::number(p50));
+      currentRow->p90->setText(QString::number(p90));
+      currentRow->p99->setText(QString::number(p99));
+      currentRow->p999->setText(QString::number(p999));
+      currentRow->misses->setText(QString::number(infoPair.second.misses));
+      float avgAllocations = 0.f, avgBytes = 0.f;
+      timeView.info.getAllocationStatistics(infoPair.second, avgAllocations, avgBytes);
+      currentRow->allocations->setText(QString::number(avgAllocations));
+      currentRow->bytes->setText(QString::number(avgBytes, 'f', 0));
       currentRow->name->setText(QString(name.c_str())); //refresh name every time to eliminate unknown
     }
   }
@@ -29,7 +29,9 @@ class QTableWidget;
 /**
  * @class TimeView
  *
- * A class to represent a view with information about the timing of modules.
+ * A class to represent a view with information about the timing of modules
+ * and their heap allocations per frame. The percentiles and deadline misses
+ * cover all frames since the start of the thread.
  *
  * @author Colin Graf
  */
@@ -41,8 +41,7 @@ std::vector<ModuleBase::Info> BehaviorControl::getExtModuleInfo()
 
 void BehaviorControl::update(ActivationGraph& activationGraph)
 {
-  activationGraph.graph.clear();
-  activationGraph.currentDepth = 0;
+  activationGraph.clear();
 
   theBehaviorStatus.passTarget = -1;
   theBehaviorStatus.walkingTo = Vector2f::Zero();
@@ -64,7 +63,7 @@ void BehaviorControl::update(ActivationGraph& activationGraph)
   theCardRegistry.preProcess(theFrameInfo.time);
 
   ASSERT(activationGraph.graph.empty());
-  activationGraph.graph.emplace_back("BehaviorControl", 0, TypeRegistry::getEnumName(status), theFrameInfo.time, 0, std::vector<std::string>());
+  activationGraph.addNode("BehaviorControl", 0, TypeRegistry::getEnumName(status), theFrameInfo.time, 0);
   this->execute();
   activationGraph.graph[0].state = TypeRegistry::getEnumName(status);
 
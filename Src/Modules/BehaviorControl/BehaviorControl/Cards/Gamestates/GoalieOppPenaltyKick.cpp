@@ -61,7 +61,7 @@ class GoalieOppPenaltyKickCard : public GoalieOppPenaltyKickCardBase
    */
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   void execute() override
@@ -65,7 +65,7 @@ class OppCornerKickCard : public OppCornerKickCardBase
    */
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   option
@@ -60,7 +60,7 @@ class OppGoalFreeKickCard : public OppGoalFreeKickCardBase
    */
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   option
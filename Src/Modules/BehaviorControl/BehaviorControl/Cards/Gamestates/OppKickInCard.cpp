@@ -88,7 +88,7 @@ class OppKickInCard : public OppKickInCardBase
    */
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   option
@@ -86,7 +86,7 @@ class OppKickoffCard : public OppKickoffCardBase
    */
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   option
@@ -73,7 +73,7 @@ class OppPushingFreeKickCard : public OppPushingFreeKickCardBase
    */
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   option
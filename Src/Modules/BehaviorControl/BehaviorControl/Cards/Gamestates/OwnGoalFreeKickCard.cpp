@@ -74,7 +74,7 @@ class OwnGoalFreeKickCard : public OwnGoalFreeKickCardBase
    */
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   option
@@ -95,7 +95,7 @@ class OwnKickInCard : public OwnKickInCardBase
         || theGameInfo.setPlay != SET_PLAY_KICK_IN;
         */
     // added AM
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   void execute() override
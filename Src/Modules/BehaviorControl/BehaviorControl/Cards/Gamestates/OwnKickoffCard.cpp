@@ -78,7 +78,7 @@ class OwnKickoffCard : public OwnKickoffCardBase
    */
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   };
 
   void execute() override
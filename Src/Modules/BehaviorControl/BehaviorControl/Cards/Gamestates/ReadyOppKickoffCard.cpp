@@ -62,7 +62,7 @@ class ReadyOppKickoffCard : public ReadyOppKickoffCardBase
    */
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
     void execute() override
     {
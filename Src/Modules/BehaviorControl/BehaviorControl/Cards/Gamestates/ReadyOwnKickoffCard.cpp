@@ -57,7 +57,7 @@ class ReadyOwnKickoffCard : public ReadyOwnKickoffCardBase
    */
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   void execute() override
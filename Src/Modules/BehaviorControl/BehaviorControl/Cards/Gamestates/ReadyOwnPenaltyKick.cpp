@@ -64,7 +64,7 @@ class ReadyOwnPenaltyKickCard : public ReadyOwnPenaltyKickCardBase
    */
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   void execute() override
@@ -102,7 +102,7 @@ class ClearOwnHalfCard : public ClearOwnHalfCardBase
 
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
  
@@ -110,7 +110,7 @@ class ClearOwnHalfCardGoalie : public ClearOwnHalfCardGoalieBase
 
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
  
@@ -95,7 +95,7 @@ class DefenseChaseBallCard : public DefenseChaseBallCardBase
 
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   option
@@ -101,7 +101,7 @@ class DefenseCoverBackCard : public DefenseCoverBackCardBase
 
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   void execute() override {
@@ -93,7 +93,7 @@ class GoalieLongShotCard : public GoalieLongShotCardBase
 
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
 
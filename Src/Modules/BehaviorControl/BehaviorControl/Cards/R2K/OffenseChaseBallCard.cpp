@@ -95,7 +95,7 @@ class OffenseChaseBallCard : public OffenseChaseBallCardBase
 
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   option
@@ -83,7 +83,7 @@ class OffenseFastGoalKick : public OffenseFastGoalKickBase
 
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
 
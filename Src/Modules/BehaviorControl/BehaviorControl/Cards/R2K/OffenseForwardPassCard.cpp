@@ -114,7 +114,7 @@ class OffenseForwardPassCard : public OffenseForwardPassCardBase
     
     bool postconditions() const override
     {
-        return !preconditions();
+        return !checkPreconditions();
     }
 
     Vector2f getTarget() {
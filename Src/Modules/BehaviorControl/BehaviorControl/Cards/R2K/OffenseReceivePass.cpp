@@ -87,7 +87,7 @@ class OffenseReceivePassCard : public OffenseReceivePassCardBase
     
     bool postconditions() const override
     {
-        return !preconditions();
+        return !checkPreconditions();
     }
     
     void execute() override
@@ -82,7 +82,7 @@ class ReferenceCard : public ReferenceCardBase
 
   bool postconditions() const override
   {
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   option
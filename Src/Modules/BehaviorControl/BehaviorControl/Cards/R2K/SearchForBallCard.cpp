@@ -93,7 +93,7 @@ class SearchForBallCard : public SearchForBallCardBase
   bool postconditions() const override
   {
     //int timeSinceLastStart = theFrameInfo.getTimeSince(startTime);
-    return !preconditions();
+    return !checkPreconditions();
   }
 
   option
@@ -66,7 +66,7 @@ class WalkTestCard : public WalkTestCardBase
 
   bool postconditions() const override
   {
-    return !preconditions();  
+    return !checkPreconditions();  
   }
 
   // check whether the robot position is close enough on a target (epsilon-environment), set epsilon within this function
@@ -31,8 +31,7 @@ std::vector<ModuleBase::Info> TeamBehaviorControl::getExtModuleInfo()
 
 void TeamBehaviorControl::update(TeamActivationGraph& teamActivationGraph)
 {
-  teamActivationGraph.graph.clear();
-  teamActivationGraph.currentDepth = 0;
+  teamActivationGraph.clear();
 
   theTeamSkillRegistry.modifyAllParameters();
   theTeamCardRegistry.modifyAllParameters();
@@ -40,7 +39,7 @@ void TeamBehaviorControl::update(TeamActivationGraph& teamActivationGraph)
   theTeamSkillRegistry.preProcess(theFrameInfo.time);
   theTeamCardRegistry.preProcess(theFrameInfo.time);
 
-  teamActivationGraph.graph.emplace_back("TeamBehaviorControl", 0, "", theFrameInfo.time, 0, std::vector<std::string>());
+  teamActivationGraph.addNode("TeamBehaviorControl", 0, "", theFrameInfo.time, 0);
   CardBase* card = theTeamCardRegistry.getCard(rootCard);
   ASSERT(card);
   card->call();
@@ -2,6 +2,8 @@
 #include "Tools/Math/Geometry.h"
 #include "Tools/Math/Probabilistics.h"
 #include "Tools/Framework/Configuration.h"
+#include "Tools/WorkerPool.h"
+#include <chrono>
 
 #define drawID "module:ShotPredictor"
 
@@ -14,6 +16,8 @@ ShotPredictor::ShotPredictor() {
 
 void ShotPredictor::update(Shots& shotData) {
     DECLARE_DEBUG_DRAWING(drawID, "drawingOnField"); // Shot Predictor Debug drawing
+    DEBUG_RESPONSE_ONCE("module:ShotPredictor:benchmark")
+      benchmark();
 
     Vector2f goalLeftRelative = theRobotPose.toRelative(goalLeft);
     Vector2f goalRightRelative = theRobotPose.toRelative(goalRight);
@@ -37,7 +41,7 @@ float ShotPredictor::estimateTimeToAlign(Angle& direction, Shot& shot) {
     return t;
 }
 
-SectorList ShotPredictor::getMissSectors(Shot& shot, Vector2f& targetLineStartRelative, Vector2f& targetLineEndRelative) {
+SectorList ShotPredictor::getMissSectors(const Vector2f& targetLineStartRelative, const Vector2f& targetLineEndRelative) const {
   SectorList miss = SectorList();
   Vector2f lineStartBallRelative = targetLineStartRelative - theFieldBall.positionRelative;
   Vector2f lineEndBallRelative = targetLineEndRelative - theFieldBall.positionRelative;
@@ -47,10 +51,8 @@ SectorList ShotPredictor::getMissSectors(Shot& shot, Vector2f& targetLineStartRe
   return miss;
 }
 
-SectorList ShotPredictor::getInsterceptSectors(Shot& shot){
-  auto prediction = predictObstacles(shot.executionTime);
-  SectorList blocked;
-  for(auto obstacle : prediction)
+void ShotPredictor::addInsterceptSectors(const std::vector<ObstaclePrediction>& prediction, SectorList& blocked) const {
+  for(const ObstaclePrediction& obstacle : prediction)
   {
       Vector2f posBallRelative = obstacle.pos - theFieldBall.positionRelative;
       Vector2f tp1, tp2;
@@ -62,54 +64,39 @@ SectorList ShotPredictor::getInsterceptSectors(Shot& shot){
           blocked.addSector(Sector(-pi, pi - 0.00001f));
           break;
       }
-
-      tp1 += theFieldBall.positionRelative;
-      tp2 += theFieldBall.positionRelative;
-      LINE(drawID, tp1.x(), tp1.y(), tp2.x(), tp2.y(), 10, Drawings::dottedPen, ColorRGBA::blue);
   }
-  return blocked;
 }
 
-void ShotPredictor::calcShotFailProbability(Shot& shot, Vector2f& targetLineStartRelative, Vector2f& targetLineEndRelative){
-    shot.failureProbability = 0;
-
-    if ((theFieldBall.positionOnField - shot.target).norm() > shot.kickType.range) {
-        shot.failureProbability = 1;
-        return;
-    }
+float ShotPredictor::calcShotFailProbability(const ShotTarget& target, const KickTypeData& kickType, Angle targetDirection) const {
+    if ((theFieldBall.positionOnField - target.target).norm() > kickType.range)
+        return 1;
 
-    SectorList shotFailureSectors; // Must be BALL Relative
-    shotFailureSectors.join(getMissSectors(shot, targetLineStartRelative, targetLineEndRelative));
-    shotFailureSectors.join(getInsterceptSectors(shot));
-    // NOTE: There is a bug in the addSectorLogic!!!!!
-
-    Angle targetDirection = (theRobotPose.toRelative(shot.target) - theFieldBall.positionRelative).angle(); 
-    for(auto sector : shotFailureSectors)
+    float failureProbability = 0;
+    for(const Sector& sector : target.failureSectors)
     {
-        DRAW_SECTOR(drawID, sector, Pose2f(theFieldBall.positionRelative));
-
         // Note about probability of intervals on circles 
         // Mathematically you need to do an infinite sum over the intervals offset by 2 pi repeatedly in both directions
         // But for smaller SD it's enough to do 3 intervals: the base interval and +/- 2 pi
         // Imagine unrolling the Sectors onto a flat number line, since that's where probabilities operate.
       
         // Convert to float to allow for negative Values required for proper intervals
-        float angleMax = sector.max.normalize();
-        float angleMin = sector.min.normalize();
+        float angleMax = Angle::normalize(sector.max);
+        float angleMin = Angle::normalize(sector.min);
         if(angleMax <= angleMin) { // if sector overlaps the 0 Angle, convert min to negative value
             angleMin -= pi2; 
         } 
         // ASSERT(angleMin < angleMax); // Fails due to Compiler optimization where angles are NaN Values
 
-        shot.failureProbability += probabilityOfInterval(targetDirection, shot.kickType.angleAccSD, angleMin, angleMax);
-        shot.failureProbability += probabilityOfInterval(targetDirection, shot.kickType.angleAccSD, angleMin + pi2, angleMax + pi2);
-        shot.failureProbability += probabilityOfInterval(targetDirection, shot.kickType.angleAccSD, angleMin - pi2, angleMax - pi2);
+        failureProbability += probabilityOfInterval(targetDirection, kickType.angleAccSD, angleMin, angleMax);
+        failureProbability += probabilityOfInterval(targetDirection, kickType.angleAccSD, angleMin + pi2, angleMax + pi2);
+        failureProbability += probabilityOfInterval(targetDirection, kickType.angleAccSD, angleMin - pi2, angleMax - pi2);
     }
+    return failureProbability;
 }
 
-std::vector<ObstaclePrediction> ShotPredictor::predictObstacles(float time) {
-    std::vector<ObstaclePrediction> prediction;
-    for(auto o : theObstacleModel.obstacles)
+void ShotPredictor::predictObstacles(float time, std::vector<ObstaclePrediction>& prediction) const {
+    prediction.clear();
+    for(const Obstacle& o : theObstacleModel.obstacles)
     {
         if(o.isOpponent()) { // Obstacle is Opponent
             Vector2f toBall = (theFieldBall.positionRelative - o.center);
@@ -118,66 +105,143 @@ std::vector<ObstaclePrediction> ShotPredictor::predictObstacles(float time) {
             // Enemy will reach the ball before me!
             if(distTravelled > toBall.norm()) {
                 prediction.clear();
-                ObstaclePrediction p = {theFieldBall.positionRelative, (o.left - o.right).norm() / 2 + ballRadius};
-                prediction.push_back(p);
+                prediction.push_back({theFieldBall.positionRelative, (o.left - o.right).norm() / 2 + ballRadius});
                 break;
             }
 
-            Vector2f posRelative = o.center + toBall.normalized() * distTravelled;
-            ObstaclePrediction p = {posRelative, (o.left - o.right).norm() / 2 + ballRadius};
-            prediction.push_back(p);
-            CIRCLE(drawID, posRelative.x(), posRelative.y(), p.range, 10, Drawings::dottedPen, ColorRGBA::red, Drawings::noBrush, ColorRGBA::blue);
-            
+            prediction.push_back({o.center + toBall.normalized() * distTravelled, (o.left - o.right).norm() / 2 + ballRadius});
         } else if (!o.isTeammate()) // Obstacle is random object
         {
-            ObstaclePrediction p = {o.center, (o.left - o.right).norm() / 2 + ballRadius}; 
-            prediction.push_back(p);
-            CIRCLE(drawID, o.center.x(), o.center.y(), p.range, 10, Drawings::dottedPen, ColorRGBA::red, Drawings::noBrush, ColorRGBA::blue);
+            prediction.push_back({o.center, (o.left - o.right).norm() / 2 + ballRadius});
         } 
     }
-    return prediction;
+}
+
+void ShotPredictor::evaluateTarget(ShotTarget& target, const SectorList& missSectors) const {
+    predictObstacles(target.executionTime, target.obstacles);
+
+    // Must be BALL Relative
+    target.failureSectors = missSectors;
+    addInsterceptSectors(target.obstacles, target.failureSectors);
+
+    Angle targetDirection = (theRobotPose.toRelative(target.target) - theFieldBall.positionRelative).angle();
+    target.failureProbabilities.resize(kicks.size());
+    for(size_t i = 0; i < kicks.size(); ++i)
+        target.failureProbabilities[i] = calcShotFailProbability(target, kicks[i], targetDirection);
+}
+
+void ShotPredictor::drawTarget(const ShotTarget& target) const {
+    COMPLEX_DRAWING(drawID)
+    {
+        for(const ObstaclePrediction& obstacle : target.obstacles)
+        {
+            CIRCLE(drawID, obstacle.pos.x(), obstacle.pos.y(), obstacle.range, 10, Drawings::dottedPen, ColorRGBA::red, Drawings::noBrush, ColorRGBA::blue);
+            Vector2f tp1, tp2;
+            if(Geometry::getTangentPoints(Vector2f::Zero(), Geometry::Circle(obstacle.pos - theFieldBall.positionRelative, obstacle.range), tp1, tp2)) {
+                tp1 += theFieldBall.positionRelative;
+                tp2 += theFieldBall.positionRelative;
+                LINE(drawID, tp1.x(), tp1.y(), tp2.x(), tp2.y(), 10, Drawings::dottedPen, ColorRGBA::blue);
+            }
+        }
+
+        for(const Sector& sector : target.failureSectors)
+        {
+            DRAW_SECTOR(drawID, sector, Pose2f(theFieldBall.positionRelative));
+        }
+
+        // Draw Considered Lines, colored by the kick type evaluated last
+        const float failureProbability = target.failureProbabilities.empty() ? 1.f : target.failureProbabilities.back();
+        const Vector2f targetRelative = theRobotPose.toRelative(target.target);
+        LINE(drawID, theFieldBall.positionRelative.x(), theFieldBall.positionRelative.y(), targetRelative.x(), targetRelative.y(), 5, Drawings::solidPen, ColorRGBA((char)(failureProbability * 255), (char)((1 - failureProbability) * 255), 0));
+        DRAW_TEXT(drawID, targetRelative.x(), targetRelative.y(), 40, ColorRGBA::black, failureProbability);
+    }
 }
 
 Shot ShotPredictor::getBestThruShot(const Vector2f& lineStart, const Vector2f& lineEnd, const size_t scanFidelity) {
-    Shot best;
-    best.failureProbability = 10;
-    Shot current;
     Vector2f dir = (lineEnd - lineStart) / (float) scanFidelity;
+    Vector2f startRelative = theRobotPose.toRelative(lineStart);
+    Vector2f endRelative = theRobotPose.toRelative(lineEnd);
+    const SectorList missSectors = getMissSectors(startRelative, endRelative);
 
+    // The time to kick only depends on the target. As before, it is estimated
+    // with the kick type that was evaluated last for the previous target.
+    Shot current;
     current.power = 1;
-    
+    targets.resize(scanFidelity + 1);
     for (size_t i = 0; i <= scanFidelity; i++)
     {
         current.target = lineStart + dir * i;
-
         current.executionTime = estimateTimeToKick(current);
-        Vector2f startRelative = theRobotPose.toRelative(lineStart);
-        Vector2f endRelative = theRobotPose.toRelative(lineEnd);
+        targets[i].target = current.target;
+        targets[i].executionTime = current.executionTime;
+        if(!kicks.empty())
+            current.kickType = kicks.back();
+    }
 
-        for (auto &kickType : kicks)
+    // The targets are independent of each other. Each job evaluates a consecutive range of them.
+    // The jobs are urgent, because this thread waits for them.
+    const size_t parts = std::max(static_cast<size_t>(1), std::min(static_cast<size_t>(numOfJobs), targets.size()));
+    const auto evaluateTargets = [this, &missSectors, parts](size_t part)
+    {
+        for(size_t i = targets.size() * part / parts; i < targets.size() * (part + 1) / parts; ++i)
+            evaluateTarget(targets[i], missSectors);
+    };
+    for(size_t part = 1; part < parts; ++part)
+        jobs.emplace_back(WorkerPool::getShared().run([&evaluateTargets, part] { evaluateTargets(part); }, WorkerPool::Priority::urgent));
+    evaluateTargets(0);
+    for(std::future<void>& job : jobs)
+        job.get();
+    jobs.clear();
+
+    // Select the best shot in the same order as a sequential evaluation would do.
+    Shot best;
+    best.failureProbability = 10;
+    for (const ShotTarget& target : targets)
+    {
+        current.target = target.target;
+        current.executionTime = target.executionTime;
+        for (size_t i = 0; i < kicks.size(); ++i)
         {
-            current.kickType = kickType;
-            calcShotFailProbability(current, startRelative, endRelative);
+            current.failureProbability = target.failureProbabilities[i];
 
             if (current.failureProbability < best.failureProbability) 
             {
                 best = current;
+                best.kickType = kicks[i];
             }
             else if (current.failureProbability == best.failureProbability) {
                 if ((best.target - theFieldBall.positionOnField).norm() > (current.target - theFieldBall.positionOnField).norm())
                 {
                     best = current;
+                    best.kickType = kicks[i];
                 }            
             }
         }
-        
-        // Draw Considered Lines
-        LINE(drawID, theFieldBall.positionRelative.x(), theFieldBall.positionRelative.y(), theRobotPose.toRelative(current.target).x(), theRobotPose.toRelative(current.target).y(), 5, Drawings::solidPen, ColorRGBA((char)(current.failureProbability * 255), (char)((1 - current.failureProbability) * 255), 0));
-        DRAW_TEXT(drawID, theRobotPose.toRelative(current.target).x(), theRobotPose.toRelative(current.target).y(), 40, ColorRGBA::black, current.failureProbability);
+        drawTarget(target);
     }
 
     // Draw best
     CIRCLE(drawID, theRobotPose.toRelative(best.target).x(), theRobotPose.toRelative(best.target).y(), 50, 10, Drawings::dottedPen, ColorRGBA::black, Drawings::noBrush, ColorRGBA::blue);
     return best;
 
-}
\ No newline at end of file
+}
+
+void ShotPredictor::benchmark() {
+    constexpr int repetitions = 100;
+    const unsigned configuredJobs = numOfJobs;
+    Shot shots[2];
+    double durations[2];
+    for(int run = 0; run < 2; ++run)
+    {
+        numOfJobs = run ? configuredJobs : 1;
+        const auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < repetitions; ++i)
+            shots[run] = getBestThruShot(goalLeft, goalRight);
+        durations[run] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+    }
+    numOfJobs = configuredJobs;
+
+    OUTPUT_TEXT("ShotPredictor: " << static_cast<unsigned>(theObstacleModel.obstacles.size()) << " obstacles, " << static_cast<unsigned>(kicks.size()) << " kick types: "
+                << durations[0] << " µs sequential, " << durations[1] << " µs in " << configuredJobs << " jobs"
+                << (shots[0].failureProbability == shots[1].failureProbability && shots[0].target == shots[1].target ? "" : " (results differ!)"));
+}
@@ -8,6 +8,7 @@
 #include "Representations/Modeling/RobotPose.h"
 #include "Tools/Debugging/DebugDrawings.h"
 #include "Tools/Math/Sector.h"
+#include <future>
 
 struct ObstaclePrediction {
   Vector2f pos;
@@ -28,14 +29,44 @@ MODULE(ShotPredictor,
     (std::vector<KickTypeData>) kicks,
     (Pose2f) maxSpeed, // Copied from WalkingEngine. Temporary until Someone finds out how to read the configs of other Modules
     (float) opponentSpeedModifier,
+    (unsigned) numOfJobs, // The number of parts the targets are split into to be evaluated in parallel. 1 evaluates them in this thread only.
   }),
 });
 
 class ShotPredictor: public ShotPredictorBase
 {
 private:
+  /**
+   * The evaluation of a single target on the target line. Everything except
+   * the failure probabilities does not depend on the kick type.
+   */
+  struct ShotTarget
+  {
+    Vector2f target;
+    float executionTime;
+    std::vector<ObstaclePrediction> obstacles; // Robot relative
+    SectorList failureSectors; // Ball relative
+    std::vector<float> failureProbabilities; // One per entry in kicks
+  };
+
   Vector2f goalLeft;
   Vector2f goalRight;
+  std::vector<ShotTarget> targets; // The targets evaluated last. Kept to reuse their memory.
+  std::vector<std::future<void>> jobs; // The jobs evaluating targets in parallel.
+
+  /**
+   * Evaluates a target for all kick types. This method is executed by worker
+   * threads, i.e. it must not draw or change anything but the target.
+   * @param target The target. Its position and execution time must already be set.
+   * @param missSectors The ball relative sectors that miss the target line.
+   */
+  void evaluateTarget(ShotTarget& target, const SectorList& missSectors) const;
+
+  /** Draws the evaluation of a target. */
+  void drawTarget(const ShotTarget& target) const;
+
+  /** Evaluates the shots of the current frame repeatedly, with and without parallelization. */
+  void benchmark();
 
 public:
 
@@ -48,11 +79,11 @@ public:
   float estimateTimeToKick(Shot& shot);
   float estimateTimeToAlign(Angle& direction, Shot& shot);
 
-  std::vector<ObstaclePrediction> predictObstacles(float time);
+  void predictObstacles(float time, std::vector<ObstaclePrediction>& prediction) const;
 
-  SectorList getInsterceptSectors(Shot& shot);
-  SectorList getMissSectors(Shot& shot, Vector2f& targetLineStartRelative, Vector2f& targetLineEndRelative);
-  void calcShotFailProbability(Shot& shot, Vector2f& targetLineStartRelative, Vector2f& targetLineEndRelative);
+  void addInsterceptSectors(const std::vector<ObstaclePrediction>& prediction, SectorList& sectors) const;
+  SectorList getMissSectors(const Vector2f& targetLineStartRelative, const Vector2f& targetLineEndRelative) const;
+  float calcShotFailProbability(const ShotTarget& target, const KickTypeData& kickType, Angle targetDirection) const;
 
   Shot getBestThruShot(const Vector2f& lineStart, const Vector2f& lineEnd, const size_t scanFidelity = 25U);
 
@@ -12,6 +12,7 @@
 #include "Tools/Debugging/Annotation.h"
 #include "Tools/Math/Transformation.h"
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 
 MAKE_MODULE(AutomaticCameraCalibrator, infrastructure);
@@ -98,6 +99,9 @@ void AutomaticCameraCalibrator::update(CameraCalibration& cameraCalibration)
     }
   }
 
+  DEBUG_RESPONSE_ONCE("module:AutomaticCameraCalibrator:benchmarkOptimizer")
+    benchmarkOptimizer();
+
   if(state == State::recordSamples && currentSampleConfiguration && theCalibrationRequest.sampleConfigurationRequest)
   {
     recordSamples();
@@ -149,19 +153,31 @@ bool AutomaticCameraCalibrator::fitLine(CorrectedLine& cline)
   const int minIndex = static_cast<int>(minAngle * numOfAngles / 180_deg) % numOfAngles;
   const int maxIndex = static_cast<int>(maxAngle * numOfAngles / 180_deg) % numOfAngles;
 
-  // Calculate the values in the hough space
+  // Calculate the values in the hough space and determine its local maxima
   const int dMax = static_cast<int>(std::ceil(std::hypot(sobelImage.height, sobelImage.width)));
-  std::vector<std::vector<int> > houghSpace(numOfAngles, std::vector<int>(2 * dMax + 1, 0));
-  calcHoughSpace(sobelImage, minIndex, maxIndex, dMax, houghSpace);
+  std::vector<HoughLines::Maximum> localMaxima;
+  const float sobelThresh = determineSobelThresh(sobelImage);
+  HoughLines::findLocalMaxima(sobelImage, sobelThresh, cosAngles, sinAngles, minIndex, maxIndex, dMax, localMaxima);
 
-  // Determine the local maxima in the hough space
-  std::vector<Maximum> localMaxima;
-  determineLocalMaxima(houghSpace, minIndex, maxIndex, localMaxima);
+  // Measures the Hough transform on the current patch, e.g. while replaying a log of a calibration.
+  DEBUG_RESPONSE_ONCE("module:AutomaticCameraCalibrator:benchmarkHoughLines")
+  {
+    constexpr int repetitions = 1000;
+    std::vector<HoughLines::Maximum> maxima;
+    const auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < repetitions; ++i)
+    {
+      maxima.clear();
+      HoughLines::findLocalMaxima(sobelImage, sobelThresh, cosAngles, sinAngles, minIndex, maxIndex, dMax, maxima);
+    }
+    const double duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+    OUTPUT_TEXT("AutomaticCameraCalibrator: Hough lines in " << sobelImage.width << "x" << sobelImage.height << " pixels took " << duration << " ms");
+  }
 
   if(localMaxima.size() > 1)
   {
     // Calculate the corrected start/end of the upper or lower edge
-    std::sort(localMaxima.begin(), localMaxima.end(), [](const Maximum& a, const Maximum& b) { return a.maxAcc > b.maxAcc; });
+    std::sort(localMaxima.begin(), localMaxima.end(), [](const HoughLines::Maximum& a, const HoughLines::Maximum& b) { return a.maxAcc > b.maxAcc; });
     int angle = localMaxima[0].angleIndex, distance = localMaxima[0].distanceIndex - dMax;
     Vector2f pointOnLine = Vector2f(distance * cosAngles[angle], distance * sinAngles[angle]) + Vector2f(startX, startY);
     Vector2f n0 = Vector2f(cosAngles[angle], sinAngles[angle]);
@@ -259,58 +275,6 @@ float AutomaticCameraCalibrator::determineSobelThresh(const Sobel::SobelImage& s
   return sqr(std::sqrt(static_cast<float>(thresh)) * sobelThreshValue);
 }
 
-void AutomaticCameraCalibrator::calcHoughSpace(const Sobel::SobelImage& sobelImage, const int minIndex, const int maxIndex, const int dMax, std::vector<std::vector<int> >& houghSpace)
-{
-  const float thresh = determineSobelThresh(sobelImage);
-  for(unsigned int y = 1; y < sobelImage.height - 1; ++y)
-    for(unsigned int x = 1; x < sobelImage.width - 1; ++x)
-    {
-      const Sobel::SobelPixel& pixel = sobelImage[y][x];
-      if(pixel.x * pixel.x + pixel.y * pixel.y >= thresh)
-      {
-        for(int index = minIndex; index != maxIndex; ++index)
-        {
-          int d = static_cast<int>(std::ceil(x * cosAngles[index] + y * sinAngles[index]));
-          ++houghSpace[index][d + dMax];
-          if(minIndex > maxIndex && index == numOfAngles - 1)
-            index = -1;
-        }
-      }
-    }
-}
-
-void AutomaticCameraCalibrator::determineLocalMaxima(const std::vector<std::vector<int> >& houghSpace, const int minIndex, const int maxIndex, std::vector<Maximum>& localMaxima)
-{
-  const int maxDisIndex = static_cast<int>(houghSpace[0].size());
-  auto localMaximum = [&houghSpace, maxDisIndex](const int value, const int angleIndex, const int distanceIndex, const int numOfAngles) -> bool
-  {
-    for(int i = -1; i <= 1; ++i)
-    {
-      int index = ((angleIndex + i) + numOfAngles) % numOfAngles;
-      for(int j = std::max(0, distanceIndex - 1); j <= std::min(maxDisIndex - 1, distanceIndex + 1); ++j)
-      {
-        if(index == angleIndex && j == distanceIndex)
-          continue;
-        if(houghSpace[index][j] > value)
-          return false;
-      }
-    }
-    return true;
-  };
-
-  for(int angleIndex = minIndex; angleIndex != maxIndex; ++angleIndex)
-  {
-    for(int distanceIndex = 0; distanceIndex < maxDisIndex; ++distanceIndex)
-    {
-      int value = houghSpace[angleIndex][distanceIndex];
-      if(value != 0 && localMaximum(value, angleIndex, distanceIndex, numOfAngles))
-        localMaxima.push_back({value, angleIndex, distanceIndex});
-    }
-    if(minIndex > maxIndex && angleIndex == numOfAngles - 1)
-      angleIndex = -1;
-  }
-}
-
 #define ADD_SAMPLE(sampleType, SampleName, first, second) \
   if(currentSampleConfiguration->needToRecord(samples, sampleType)) \
   { \
@@ -510,7 +474,7 @@ void AutomaticCameraCalibrator::optimize()
 {
   if(!optimizer)
   {
-    optimizer = std::make_unique<GaussNewtonOptimizer<numOfParameterTranslations>>(functor);
+    optimizer = std::make_unique<LevenbergMarquardtOptimizer<numOfParameterTranslations>>(functor);
     optimizationParameters = pack(theCameraCalibration);
     successiveConvergences = 0;
   }
@@ -523,13 +487,12 @@ void AutomaticCameraCalibrator::optimize()
       return;
     }
 
-    for(size_t i = 0; i < functor.getNumOfMeasurements(); ++i)
+    // The optimizer already knows the errors for the new parameters.
+    const VectorXf& errors = optimizer->getErrors();
+    if((errors.array() >= notValidError).any())
     {
-      if(functor(optimizationParameters, i) >= notValidError)
-      {
-        resetOptimization(false);
-        return;
-      }
+      resetOptimization(false);
+      return;
     }
 
     OUTPUT_TEXT("AutomaticCameraCalibrator: delta = " << delta << "\n");
@@ -545,10 +508,7 @@ void AutomaticCameraCalibrator::optimize()
       successiveConvergences = 0;
     if(successiveConvergences > 0)
     {
-      float error = 0;
-      for(size_t i = 0; i < samples.size(); i++)
-        error += functor(optimizationParameters, i);
-      error /= static_cast<float>(samples.size());
+      const float error = errors.mean();
       if(successiveConvergences == 1 || error < lowestError)
       {
         lowestError = error;
@@ -566,6 +526,32 @@ void AutomaticCameraCalibrator::optimize()
   }
 }
 
+void AutomaticCameraCalibrator::benchmarkOptimizer()
+{
+  if(samples.size() < numOfParameterTranslations)
+  {
+    OUTPUT_TEXT("AutomaticCameraCalibrator: not enough samples recorded");
+    return;
+  }
+
+  for(const bool parallel : {false, true})
+  {
+    LevenbergMarquardtOptimizer<numOfParameterTranslations> optimizer(functor, LevenbergMarquardtOptimizer<numOfParameterTranslations>::Loss::squared, 1.f, parallel);
+    Parameters params = pack(theCameraCalibration);
+    unsigned iterations = 0;
+    float delta = std::numeric_limits<float>::max();
+    const auto start = std::chrono::steady_clock::now();
+    while(iterations < 1000 && std::isfinite(delta) && std::abs(delta) >= terminationCriterion)
+    {
+      delta = optimizer.iterate(params, Parameters::Constant(0.0001f));
+      ++iterations;
+    }
+    const double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    OUTPUT_TEXT("AutomaticCameraCalibrator: " << (parallel ? "parallel" : "sequential") << ", " << static_cast<unsigned>(samples.size()) << " samples, "
+                << iterations << " iterations, " << iterations / duration << " iterations/s, mean error " << optimizer.getErrors().mean());
+  }
+}
+
 void AutomaticCameraCalibrator::resetOptimization(const bool finished)
 {
   if(finished)
@@ -643,7 +629,6 @@ void AutomaticCameraCalibrator::updateSampleConfiguration()
   if(!CHECK_LINE_PROJECTION(line1, coordSys, cameraMatrix, cameraInfo) || \
      !CHECK_LINE_PROJECTION(line2, coordSys, cameraMatrix, cameraInfo)) \
   { \
-    OUTPUT_TEXT(SampleName << " projection error!"); \
     return calibrator.notValidError; \
   }
 
@@ -651,7 +636,6 @@ void AutomaticCameraCalibrator::updateSampleConfiguration()
   if(!CHECK_LINE_PROJECTION(line, coordSys, cameraMatrix, cameraInfo) || \
      !Transformation::imageToRobot(coordSys.toCorrected(p), cameraMatrix, cameraInfo, p2)) \
   { \
-    OUTPUT_TEXT(SampleName << " projection error!"); \
     return calibrator.notValidError; \
   }
 
@@ -668,7 +652,6 @@ float AutomaticCameraCalibrator::CornerAngleSample::computeError(const CameraMat
 
   const float cornerAngle = calculateAngle(cLine1.aOnField, cLine1.bOnField, cLine2.aOnField, cLine2.bOnField);
   const float cornerAngleError = std::abs(90_deg - cornerAngle);
-  OUTPUT_TEXT("Angle 90: " << cornerAngle << ", error: " << cornerAngleError);
   return cornerAngleError / calibrator.angleErrorDivisor;
 }
 
@@ -678,7 +661,6 @@ float AutomaticCameraCalibrator::ParallelAngleSample::computeError(const CameraM
 
   const float parallelAngle = calculateAngle(cLine1.aOnField, cLine1.bOnField, cLine2.aOnField, cLine2.bOnField);
   const float parallelAngleError = std::min(parallelAngle, 180_deg - parallelAngle);
-  OUTPUT_TEXT("Angle 180: " << parallelAngle << ", error: " << parallelAngleError);
   return parallelAngleError / calibrator.angleErrorDivisor;
 }
 
@@ -703,13 +685,11 @@ float AutomaticCameraCalibrator::ParallelLinesDistanceSample::computeError(const
   const float combinedOffset = distance1 > 0 ? cLine1.offset - cLine2.offset : cLine2.offset - cLine1.offset;
 
   const float optimalDistance = calibrator.theFieldDimensions.xPosOpponentGroundLine - calibrator.theFieldDimensions.xPosOpponentGoalArea + combinedOffset;
-  std::vector<float> distanceErrorList;
-  distanceErrorList.push_back(std::max(0.f, (std::abs(std::abs(distance1) - optimalDistance) - distance1ErrorRange)));
-  distanceErrorList.push_back(std::max(0.f, (std::abs(std::abs(distance2) - optimalDistance) - distance2ErrorRange)));
-  distanceErrorList.push_back(std::max(0.f, (std::abs(std::abs(distance3) - optimalDistance) - distance3ErrorRange)));
-  distanceErrorList.push_back(std::max(0.f, (std::abs(std::abs(distance4) - optimalDistance) - distance4ErrorRange)));
-  const float lineDistanceError = *std::max_element(distanceErrorList.cbegin(), distanceErrorList.cend());
-  OUTPUT_TEXT("LineDistanceError: " << lineDistanceError);
+  const float lineDistanceError = std::max({0.f,
+                                             std::abs(std::abs(distance1) - optimalDistance) - distance1ErrorRange,
+                                             std::abs(std::abs(distance2) - optimalDistance) - distance2ErrorRange,
+                                             std::abs(std::abs(distance3) - optimalDistance) - distance3ErrorRange,
+                                             std::abs(std::abs(distance4) - optimalDistance) - distance4ErrorRange});
   return lineDistanceError / calibrator.distanceErrorDivisor;
 }
 
@@ -722,7 +702,6 @@ float AutomaticCameraCalibrator::GoalAreaDistanceSample::computeError(const Came
   const float goalAreaDistance = std::abs(Geometry::getDistanceToLine(line, penaltyMarkOnField));
   const float goalAreaDistanceError = std::abs(goalAreaDistance - (calibrator.theFieldDimensions.xPosOpponentGoalArea -
                                                calibrator.theFieldDimensions.xPosOpponentPenaltyMark + cLine.offset));
-  OUTPUT_TEXT("PenaltyDistanceError: " << goalAreaDistanceError);
   return goalAreaDistanceError / calibrator.distanceErrorDivisor;
 }
 
@@ -735,7 +714,6 @@ float AutomaticCameraCalibrator::GroundLineDistanceSample::computeError(const Ca
   const float groundLineDistance = std::abs(Geometry::getDistanceToLine(line, penaltyMarkOnField));
   const float groundLineDistanceError = std::abs(groundLineDistance - (calibrator.theFieldDimensions.xPosOpponentGroundLine -
                                                  calibrator.theFieldDimensions.xPosOpponentPenaltyMark + cLine.offset));
-  OUTPUT_TEXT("GroundLineDistanceError: " << groundLineDistanceError);
   return groundLineDistanceError / calibrator.distanceErrorDivisor;
 }
 
@@ -28,9 +28,10 @@
 #include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
 #include "Representations/Sensing/GroundContactState.h"
 #include "Representations/Sensing/TorsoMatrix.h"
+#include "Tools/ImageProcessing/HoughLines.h"
 #include "Tools/ImageProcessing/Sobel.h"
 #include "Tools/Module/Module.h"
-#include "Tools/Optimization/GaussNewtonOptimizer.h"
+#include "Tools/Optimization/LevenbergMarquardtOptimizer.h"
 
 STREAMABLE_WITH_BASE(LowerECImage, ECImage, {, });
 STREAMABLE_WITH_BASE(UpperECImage, ECImage, {, });
@@ -95,14 +96,6 @@ private:
     bodyTiltCorrection,
   });
 
-  /** This struct represents a local maximum in the hough space. */
-  struct Maximum
-  {
-    int maxAcc; /**< The accumulator value of the local maximum. */
-    int angleIndex; /**< The angle index of the local maximum in the hough space. */
-    int distanceIndex; /**< The distance index of the local maximum in the hough space. */
-  };
-
   /** This struct represents a corrected line with its offset. */
   struct CorrectedLine
   {
@@ -229,16 +222,17 @@ private:
     mutable CorrectedLine cLine; /**< The corrected ground line. */
   };
 
-  using Parameters = GaussNewtonOptimizer<numOfParameterTranslations>::Vector;
+  using Parameters = LevenbergMarquardtOptimizer<numOfParameterTranslations>::Vector;
 
   /** This struct is used to evaluate the error by the optimizer. */
-  struct Functor : public GaussNewtonOptimizer<numOfParameterTranslations>::Functor
+  struct Functor : public LevenbergMarquardtOptimizer<numOfParameterTranslations>::Functor
   {
     /** Constructor. */
     Functor(AutomaticCameraCalibrator& calibrator) : calibrator(calibrator) {}
 
     /**
-     * Calculates a specific row of the residual vector.
+     * Calculates a specific row of the residual vector. The optimizer calls
+     * this concurrently for different rows.
      * @param params The function parameters for which to calculate the residual.
      * @param measurement The component index for which to calculate the residual.
      * @return The residual.
@@ -305,33 +299,18 @@ private:
    */
   float determineSobelThresh(const Sobel::SobelImage& sobelImage);
 
-  /**
-   * Performs the hough lines transformation to find lines in the given Sobel image.
-   * @param sobelImage The Sobel image in which lines should be searched.
-   * @param minIndex The minimum angle index to be considered.
-   * @param maxIndex The maximum angle index to be considered.
-   * @param dMax The maximum distance a line can possibly have in the given Sobel image.
-   * @param houghSpace The hough space to be calculated.
-   */
-  void calcHoughSpace(const Sobel::SobelImage& sobelImage, const int minIndex, const int maxIndex,
-                      const int dMax, std::vector<std::vector<int> >& houghSpace);
-
-  /**
-   * Searches the hough space for local maxima.
-   * @param houghSpace The hough space to be searched.
-   * @param minIndex The minimum angle index from which the hough space is to be considered.
-   * @param maxIndex The maximum angle index up to which the hough space is to be considered.
-   * @param localMaxima The Container in which the local maxima should be stored.
-   */
-  void determineLocalMaxima(const std::vector<std::vector<int> >& houghSpace, const int minIndex,
-                            const int maxIndex, std::vector<Maximum>& localMaxima);
-
   /** Records samples from the current image. */
   void recordSamples();
 
   /** Executes one optimization step and checks for termination. */
   void optimize();
 
+  /**
+   * Optimizes the samples recorded from the current calibration once sequentially
+   * and once in parallel and reports the iterations/s and the remaining error.
+   */
+  void benchmarkOptimizer();
+
   /**
    * Resets the optimization state.
    * @param finished Whether the optimization is finished or just has to be restarted..
@@ -372,7 +351,7 @@ private:
   State state; /**< The state in which the calibrator currently is. */
   int inStateSince; /**< The frameInfo.time when the current state was set. */
 
-  std::unique_ptr<GaussNewtonOptimizer<numOfParameterTranslations>> optimizer; /**< The optimizer (can be null if the optimization is not running). */
+  std::unique_ptr<LevenbergMarquardtOptimizer<numOfParameterTranslations>> optimizer; /**< The optimizer (can be null if the optimization is not running). */
   Functor functor; /**< The functor that calculates the error for the optimizer. */
   Parameters optimizationParameters; /**< The parameters on which the optimizer operates. */
   unsigned successiveConvergences = 0, optimizationSteps = 0; /**<  The successive number of times the termination criterion has been fulfilled (only valid during optimization). */
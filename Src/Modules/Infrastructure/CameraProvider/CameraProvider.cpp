@@ -28,7 +28,7 @@ bool CameraProvider::resetPending = false;
 #endif
 
 CameraProvider::CameraProvider()
-  : whichCamera(Thread::getCurrentThreadName() == "Upper" ?  CameraInfo::upper : CameraInfo::lower),
+  : whichCamera(Thread::getCurrentThreadName().find("Upper") == 0 ?  CameraInfo::upper : CameraInfo::lower),
     cameraInfo(whichCamera)
 {
   VERIFY(readCameraIntrinsics());
@@ -114,7 +114,8 @@ void CameraProvider::update(CameraImage& theCameraImage)
 
 void CameraProvider::update(JPEGImage& jpegImage)
 {
-  jpegImage = theCameraImage;
+  // The image is compressed in parallel. Streaming it waits for the result.
+  jpegImage.compressAsync(theCameraImage);
 }
 
 void CameraProvider::update(CameraInfo& cameraInfo)
@@ -0,0 +1,16 @@
+/**
+ * @file CognitionProvider.cpp
+ *
+ * This file implements a module that provides representations from the Cognition
+ * thread to the perception threads.
+ */
+
+#include "CognitionProvider.h"
+
+MAKE_MODULE(CognitionProvider, infrastructure);
+
+void CognitionProvider::update(ExpectedObstacleModel& theExpectedObstacleModel)
+{
+  static_cast<ObstacleModel&>(theExpectedObstacleModel) = theCognitionObstacleModel;
+  theExpectedObstacleModel.timestamp = theCognitionFrameInfo.time;
+}
@@ -0,0 +1,30 @@
+/**
+ * @file CognitionProvider.h
+ *
+ * This file declares a module that provides representations from the Cognition
+ * thread to the perception threads.
+ */
+
+#pragma once
+
+#include "Representations/Infrastructure/FrameInfo.h"
+#include "Representations/Modeling/ObstacleModel.h"
+#include "Tools/Module/Module.h"
+
+STREAMABLE_WITH_BASE(CognitionObstacleModel, ObstacleModel, {,});
+
+MODULE(CognitionProvider,
+{,
+  REQUIRES(CognitionFrameInfo),
+  REQUIRES(CognitionObstacleModel),
+  PROVIDES(ExpectedObstacleModel),
+});
+
+class CognitionProvider : public CognitionProviderBase
+{
+  /**
+   * This method is called when the representation provided needs to be updated.
+   * @param theExpectedObstacleModel The representation updated.
+   */
+  void update(ExpectedObstacleModel& theExpectedObstacleModel) override;
+};
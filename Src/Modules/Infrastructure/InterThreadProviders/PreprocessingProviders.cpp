@@ -0,0 +1,11 @@
+/**
+ * @file PreprocessingProviders.cpp
+ *
+ * This file implements modules that provide the representations computed by an
+ * image preprocessing thread in the perception thread of the same camera.
+ */
+
+#include "PreprocessingProviders.h"
+
+MAKE_MODULE(UpperPreprocessingProvider, infrastructure);
+MAKE_MODULE(LowerPreprocessingProvider, infrastructure);
@@ -0,0 +1,121 @@
+/**
+ * @file PreprocessingProviders.h
+ *
+ * This file declares modules that provide the representations computed by an
+ * image preprocessing thread in the perception thread of the same camera.
+ * They are only used if the perception of a camera is split into a
+ * preprocessing stage (threads UpperPreprocessing and LowerPreprocessing) and
+ * a high-level stage (threads Upper and Lower), which run in parallel on
+ * consecutive images.
+ *
+ * The representations are double buffered by the inter-thread packets: while
+ * the high-level stage works on the data of image n, the preprocessing stage
+ * already fills its own instances with the data of image n+1.
+ */
+
+#pragma once
+
+#include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/Infrastructure/CameraStatus.h"
+#include "Representations/Infrastructure/FrameInfo.h"
+#include "Representations/Perception/ImagePreprocessing/BodyContour.h"
+#include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
+#include "Representations/Perception/ImagePreprocessing/CNSImage.h"
+#include "Representations/Perception/ImagePreprocessing/ColorScanLineRegions.h"
+#include "Representations/Perception/ImagePreprocessing/ECImage.h"
+#include "Representations/Perception/ImagePreprocessing/FieldBoundary.h"
+#include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
+#include "Representations/Perception/ImagePreprocessing/ImageRegions.h"
+#include "Representations/Perception/ImagePreprocessing/RelativeFieldColors.h"
+#include "Representations/Perception/ImagePreprocessing/ScanGrid.h"
+#include "Tools/Module/Module.h"
+
+// Declare the alias of a representation received from a preprocessing thread
+#define DECLARE(Thread, Representation) \
+  STREAMABLE_WITH_BASE(Thread##Preprocessing##Representation, Representation, {, })
+
+// Require the alias and provide the representation
+#define FORWARDS(Thread, Representation) \
+  REQUIRES(Thread##Preprocessing##Representation), \
+  PROVIDES(Representation)
+
+// The same, but the representation cannot be MODIFYed (used for images)
+#define FORWARDS_WITHOUT_MODIFY(Thread, Representation) \
+  REQUIRES(Thread##Preprocessing##Representation), \
+  PROVIDES_WITHOUT_MODIFY(Representation)
+
+// Copy the alias into the representation provided
+#define UPDATE(Thread, Representation) \
+  void update(Representation& the##Representation) override \
+  { \
+    the##Representation = static_cast<const Representation&>(the##Thread##Preprocessing##Representation); \
+  }
+
+/**
+ * Declares the aliases and the module that forwards the results of the
+ * preprocessing thread of a camera. The thread must be called
+ * <Thread>Preprocessing.
+ * @param Thread The name of the high-level perception thread (Upper or Lower).
+ */
+#define PREPROCESSING_PROVIDER(Thread) \
+  DECLARE(Thread, BodyContour); \
+  DECLARE(Thread, CameraInfo); \
+  DECLARE(Thread, CameraMatrix); \
+  DECLARE(Thread, CameraStatus); \
+  DECLARE(Thread, CNSImage); \
+  DECLARE(Thread, ColorScanLineRegionsHorizontal); \
+  DECLARE(Thread, ColorScanLineRegionsVerticalClipped); \
+  DECLARE(Thread, ECImage); \
+  DECLARE(Thread, FieldBoundary); \
+  DECLARE(Thread, FrameInfo); \
+  DECLARE(Thread, ImageCoordinateSystem); \
+  DECLARE(Thread, PenaltyMarkRegions); \
+  DECLARE(Thread, RelativeFieldColors); \
+  DECLARE(Thread, RobotCameraMatrix); \
+  DECLARE(Thread, ScanGrid); \
+  \
+  MODULE(Thread##PreprocessingProvider, \
+  {, \
+    FORWARDS(Thread, BodyContour), \
+    FORWARDS(Thread, CameraInfo), \
+    FORWARDS(Thread, CameraMatrix), \
+    FORWARDS(Thread, CameraStatus), \
+    FORWARDS_WITHOUT_MODIFY(Thread, CNSImage), \
+    FORWARDS(Thread, ColorScanLineRegionsHorizontal), \
+    FORWARDS(Thread, ColorScanLineRegionsVerticalClipped), \
+    FORWARDS_WITHOUT_MODIFY(Thread, ECImage), \
+    FORWARDS(Thread, FieldBoundary), \
+    FORWARDS(Thread, FrameInfo), \
+    FORWARDS(Thread, ImageCoordinateSystem), \
+    FORWARDS(Thread, PenaltyMarkRegions), \
+    FORWARDS(Thread, RelativeFieldColors), \
+    FORWARDS(Thread, RobotCameraMatrix), \
+    FORWARDS(Thread, ScanGrid), \
+  }); \
+  \
+  class Thread##PreprocessingProvider : public Thread##PreprocessingProviderBase \
+  { \
+    UPDATE(Thread, BodyContour) \
+    UPDATE(Thread, CameraInfo) \
+    UPDATE(Thread, CameraMatrix) \
+    UPDATE(Thread, CameraStatus) \
+    UPDATE(Thread, CNSImage) \
+    UPDATE(Thread, ColorScanLineRegionsHorizontal) \
+    UPDATE(Thread, ColorScanLineRegionsVerticalClipped) \
+    UPDATE(Thread, ECImage) \
+    UPDATE(Thread, FieldBoundary) \
+    UPDATE(Thread, FrameInfo) \
+    UPDATE(Thread, PenaltyMarkRegions) \
+    UPDATE(Thread, RelativeFieldColors) \
+    UPDATE(Thread, RobotCameraMatrix) \
+    UPDATE(Thread, ScanGrid) \
+    \
+    void update(ImageCoordinateSystem& theImageCoordinateSystem) override \
+    { \
+      theImageCoordinateSystem = the##Thread##PreprocessingImageCoordinateSystem; \
+      theImageCoordinateSystem.cameraInfo = the##Thread##PreprocessingCameraInfo; \
+    } \
+  }
+
+PREPROCESSING_PROVIDER(Upper);
+PREPROCESSING_PROVIDER(Lower);
@@ -345,105 +345,127 @@ void NaoProvider::update(SystemSensorData& theSystemSensorData)
 
 void NaoProvider::receivePacket()
 {
-  // Read maximum size for first packet, but the smaller size for all further packets.
-  const long bytesRead = recv(socket, reinterpret_cast<char*>(receivedPacket), sizeof(receivedPacket), 0);
-  if(bytesRead < 0)
-    OUTPUT_ERROR("Could not receive packet from NAO");
-  else
+  // Drop the previous packet, but keep the bytes received behind it, because they belong to this one.
+  if(receivedPacketSize && bytesBuffered >= receivedPacketSize)
   {
-    timeWhenPacketReceived = std::max(Time::getCurrentSystemTime(), timeWhenPacketReceived + 1);
+    bytesBuffered -= receivedPacketSize;
+    std::memmove(receivedPacket, receivedPacket + receivedPacketSize, bytesBuffered);
+  }
 
-    // Initialize tables if they have not been so far
-    if(!batteryLevel)
+  // Receive until a complete packet is buffered, no matter how the stream fragments it.
+  MsgPack::Entry entries[256];
+  size_t numOfEntries = 0;
+  const bool firstPacket = !receivedPacketSize;
+  while(!receivedPacketSize || bytesBuffered < receivedPacketSize)
+  {
+    const size_t bytesToRead = (receivedPacketSize ? receivedPacketSize : sizeof(receivedPacket)) - bytesBuffered;
+    if(!bytesToRead)
     {
-      MsgPack::parse(receivedPacket, bytesRead,
+      OUTPUT_ERROR("Could not parse packet from NAO");
+      bytesBuffered = 0;
+      return;
+    }
+    const long bytesRead = recv(socket, reinterpret_cast<char*>(receivedPacket + bytesBuffered), bytesToRead, 0);
+    if(bytesRead <= 0)
+    {
+      OUTPUT_ERROR("Could not receive packet from NAO");
+      return;
+    }
+    bytesBuffered += static_cast<size_t>(bytesRead);
 
-        // Most data is encoded as float 32
-        [this](const std::string& key, const unsigned char* p)
-        {
-          const std::string::size_type pos = key.find(":");
-          ASSERT(pos != std::string::npos);
-          const std::string category = key.substr(0, pos);
-          const int index = std::stoi(key.substr(pos + 1));
-
-          if(category == "Current")
-            jointCurrents[jointMappings[index]] = p;
-          else if(category == "Position")
-            jointAngles[jointMappings[index]] = p;
-          else if(category == "Temperature")
-            jointTemperatures[jointMappings[index]] = p;
-          else if(category == "FSR")
-            fsrs[index / FsrSensors::numOfFsrSensors][index % FsrSensors::numOfFsrSensors] = p;
-          else if(category == "Accelerometer")
-            accs[index] = p;
-          else if(category == "Gyroscope")
-            gyros[index] = p;
-          else if(category == "Angles")
-            torsoAngles[index] = p;
-          else if(category == "Touch")
-            keys[keyMappings[index]] = p;
-          else if(category == "Battery")
-          {
-            if(index == 0)
-              batteryLevel = p;
-            else if(index == 1)
-              batteryCharging = p;
-            else if(index == 2)
-              batteryCurrent = p;
-            else
-              batteryTemperature = p;
-          }
-          else if(category != "Sonar" && category != "Stiffness")
-            OUTPUT_WARNING("Unknown key " << key);
-        },
-
-        // Only joint temperature statuses are encoded as positive fixint
-        [this](const std::string& key, const unsigned char* p)
-        {
-          const std::string::size_type pos = key.find(":");
-          ASSERT(pos != std::string::npos);
-          const std::string category = key.substr(0, pos);
-          const int index = std::stoi(key.substr(pos + 1));
+    // The size of the packets is known as soon as the first one was parsed successfully.
+    if(!receivedPacketSize)
+      receivedPacketSize = MsgPack::parse(receivedPacket, bytesBuffered, entries, sizeof(entries) / sizeof(entries[0]), numOfEntries);
+  }
+
+  timeWhenPacketReceived = std::max(Time::getCurrentSystemTime(), timeWhenPacketReceived + 1);
+
+  // Initialize tables if they have not been so far
+  if(firstPacket)
+  {
+    for(size_t i = 0; i < numOfEntries; ++i)
+    {
+      const MsgPack::Entry& entry = entries[i];
+      const int index = entry.index;
+      const unsigned char* p = entry.value;
 
-          if(category == "Status")
-            jointStatuses[jointMappings[index]] = p;
+      // Most data is encoded as float 32
+      if(entry.type == MsgPack::float32)
+      {
+        ASSERT(index >= 0);
+        if(entry.is("Current"))
+          jointCurrents[jointMappings[index]] = p;
+        else if(entry.is("Position"))
+          jointAngles[jointMappings[index]] = p;
+        else if(entry.is("Temperature"))
+          jointTemperatures[jointMappings[index]] = p;
+        else if(entry.is("FSR"))
+          fsrs[index / FsrSensors::numOfFsrSensors][index % FsrSensors::numOfFsrSensors] = p;
+        else if(entry.is("Accelerometer"))
+          accs[index] = p;
+        else if(entry.is("Gyroscope"))
+          gyros[index] = p;
+        else if(entry.is("Angles"))
+          torsoAngles[index] = p;
+        else if(entry.is("Touch"))
+          keys[keyMappings[index]] = p;
+        else if(entry.is("Battery"))
+        {
+          if(index == 0)
+            batteryLevel = p;
+          else if(index == 1)
+            batteryCharging = p;
+          else if(index == 2)
+            batteryCurrent = p;
           else
-            OUTPUT_WARNING("Unknown key " << key);
-        },
-
-        // Ignore strings
-        [](const std::string&, const unsigned char*, size_t) {});
-
-      // Initialize the packet to send to LoLA
-      // Please note that the code assumes that the order of sensors and actuators is the same
-      unsigned char* p = packetToSend;
-      MsgPack::writeMapHeader(10, p);
-
-      // Determine addresses for target positions
-      MsgPack::write("Position", p);
-      MsgPack::writeArrayHeader(Joints::numOfJoints - 1, p);
-      for(int i = 0; i < Joints::numOfJoints - 1; ++i)
-        jointRequests[jointMappings[i]] = MsgPack::write(0.f, p);
-
-      // Determine addresses for stiffnesses
-      MsgPack::write("Stiffness", p);
-      MsgPack::writeArrayHeader(Joints::numOfJoints - 1, p);
-      for(int i = 0; i < Joints::numOfJoints - 1; ++i)
-        jointStiffnesses[jointMappings[i]] = MsgPack::write(0.f, p);
-
-      // Determine addresses for LEDs
-      writeLEDs("REar", rightEarMappings, LEDRequest::chestRed - LEDRequest::earsRight0Deg, p);
-      writeLEDs("LEar", leftEarMappings, LEDRequest::earsRight0Deg - LEDRequest::earsLeft0Deg, p);
-      writeLEDs("Chest", chestMappings, LEDRequest::headRearLeft0 - LEDRequest::chestRed, p);
-      writeLEDs("LEye", leftEyeMappings, LEDRequest::faceRightRed0Deg - LEDRequest::faceLeftRed0Deg, p);
-      writeLEDs("REye", rightEyeMappings, LEDRequest::earsLeft0Deg - LEDRequest::faceRightRed0Deg, p);
-      writeLEDs("LFoot", leftFootMappings, LEDRequest::footRightRed - LEDRequest::footLeftRed, p);
-      writeLEDs("RFoot", rightFootMappings, LEDRequest::numOfLEDs - LEDRequest::footRightRed, p);
-      writeLEDs("Skull", skullMappings, LEDRequest::footLeftRed - LEDRequest::headRearLeft0, p);
-
-      packetToSendSize = static_cast<int>(p - packetToSend);
-      ASSERT(packetToSendSize <= static_cast<int>(sizeof(packetToSend)));
+            batteryTemperature = p;
+        }
+        else if(!entry.is("Sonar") && !entry.is("Stiffness"))
+          OUTPUT_WARNING("Unknown key " << std::string(entry.name, entry.nameLength) << ":" << index);
+      }
+
+      // Only joint temperature statuses are encoded as positive fixint
+      else if(entry.type == MsgPack::positiveFixint)
+      {
+        ASSERT(index >= 0);
+        if(entry.is("Status"))
+          jointStatuses[jointMappings[index]] = p;
+        else
+          OUTPUT_WARNING("Unknown key " << std::string(entry.name, entry.nameLength) << ":" << index);
+      }
+
+      // Ignore strings
     }
+
+    // Initialize the packet to send to LoLA
+    // Please note that the code assumes that the order of sensors and actuators is the same
+    unsigned char* p = packetToSend;
+    MsgPack::writeMapHeader(10, p);
+
+    // Determine addresses for target positions
+    MsgPack::write("Position", p);
+    MsgPack::writeArrayHeader(Joints::numOfJoints - 1, p);
+    for(int i = 0; i < Joints::numOfJoints - 1; ++i)
+      jointRequests[jointMappings[i]] = MsgPack::write(0.f, p);
+
+    // Determine addresses for stiffnesses
+    MsgPack::write("Stiffness", p);
+    MsgPack::writeArrayHeader(Joints::numOfJoints - 1, p);
+    for(int i = 0; i < Joints::numOfJoints - 1; ++i)
+      jointStiffnesses[jointMappings[i]] = MsgPack::write(0.f, p);
+
+    // Determine addresses for LEDs
+    writeLEDs("REar", rightEarMappings, LEDRequest::chestRed - LEDRequest::earsRight0Deg, p);
+    writeLEDs("LEar", leftEarMappings, LEDRequest::earsRight0Deg - LEDRequest::earsLeft0Deg, p);
+    writeLEDs("Chest", chestMappings, LEDRequest::headRearLeft0 - LEDRequest::chestRed, p);
+    writeLEDs("LEye", leftEyeMappings, LEDRequest::faceRightRed0Deg - LEDRequest::faceLeftRed0Deg, p);
+    writeLEDs("REye", rightEyeMappings, LEDRequest::earsLeft0Deg - LEDRequest::faceRightRed0Deg, p);
+    writeLEDs("LFoot", leftFootMappings, LEDRequest::footRightRed - LEDRequest::footLeftRed, p);
+    writeLEDs("RFoot", rightFootMappings, LEDRequest::numOfLEDs - LEDRequest::footRightRed, p);
+    writeLEDs("Skull", skullMappings, LEDRequest::footLeftRed - LEDRequest::headRearLeft0, p);
+
+    packetToSendSize = static_cast<int>(p - packetToSend);
+    ASSERT(packetToSendSize <= static_cast<int>(sizeof(packetToSend)));
   }
 }
 
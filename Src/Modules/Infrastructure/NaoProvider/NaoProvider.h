@@ -58,7 +58,9 @@ class NaoProvider : public NaoProviderBase
   static const LEDRequest::LED rightFootMappings[LEDRequest::numOfLEDs - LEDRequest::footRightRed]; /**< Mappings from LoLA's LED indices to B-Human's LED indices. */
 
   int socket; /**< Socket to connect to LoLA. */
-  unsigned char receivedPacket[896]; /**< The last packet received from LoLA. */
+  unsigned char receivedPacket[896]; /**< The last packet received from LoLA, possibly followed by the beginning of the next one. */
+  size_t receivedPacketSize = 0; /**< The size of the packets sent by LoLA. 0 until the first packet was received. */
+  size_t bytesBuffered = 0; /**< The number of bytes in receivedPacket. */
   unsigned char packetToSend[1000]; /**< The packet to send to LoLA. */
   size_t packetToSendSize; /**< The size of the packet to send. */
 
@@ -124,6 +126,10 @@ class NaoProvider : public NaoProviderBase
    * Wait for a packet from LoLA and accept it. The packet is present in the
    * field receivedPacket. If this is the first packet accepted, all the pointers
    * intended to point into receivedPacket and packetToSend are initialized.
+   * The size of the packets is determined by parsing the first one. All further
+   * packets are expected to have the same size and layout. Packets are read
+   * completely, even if the stream delivers them in several fragments. Bytes
+   * received behind a packet are kept as the beginning of the next one.
    */
   void receivePacket();
 
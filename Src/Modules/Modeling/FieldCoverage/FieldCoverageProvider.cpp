@@ -39,6 +39,7 @@ void FieldCoverageProvider::update(FieldCoverage& fieldCoverage)
         if(sqrDistance < sqrBallVisibilityRange && !isViewBlocked(angle, sqrDistance))
         {
           c.timestamp = theFrameInfo.time;
+          fieldCoverage.lines[nextLineToCalculate].version = theFrameInfo.time;
         }
       }
     }
@@ -91,6 +92,7 @@ void FieldCoverageProvider::init(FieldCoverage& fieldCoverage)
   {
     fieldCoverage.lines[y].y = static_cast<int>(y);
     fieldCoverage.lines[y].timestamps.resize(numOfCellsX, time);
+    fieldCoverage.lines[y].version = time;
   }
 
   float positionOnFieldX = theFieldDimensions.xPosOwnGroundLine + cellLengthX / 2.f;
@@ -4,7 +4,9 @@
  */
 
 #include "GlobalFieldCoverageProvider.h"
+#include "Tools/Debugging/Debugging.h"
 #include <algorithm>
+#include <chrono>
 #include <string>
 
 MAKE_MODULE(GlobalFieldCoverageProvider, modeling);
@@ -14,35 +16,21 @@ void GlobalFieldCoverageProvider::update(GlobalFieldCoverage& globalFieldCoverag
   if(!initDone)
     init(globalFieldCoverage);
 
+  DEBUG_RESPONSE_ONCE("module:GlobalFieldCoverageProvider:benchmark")
+    benchmark(globalFieldCoverage);
+
   if(theExtendedGameInfo.gameStateLastFrame != STATE_SET && theGameInfo.state == STATE_SET)
   {
     const int min = -static_cast<int>(Vector2f(theFieldDimensions.xPosOpponentGroundLine, theFieldDimensions.yPosLeftSideline).squaredNorm()) / 1000;
-    for(size_t i = 0; i < globalFieldCoverage.grid.size(); ++i)
-    {
-      globalFieldCoverage.grid[i].timestamp = theFrameInfo.time;
-      globalFieldCoverage.grid[i].coverage = min + static_cast<int>(globalFieldCoverage.grid[i].positionOnField.squaredNorm()) / 1000;
-    }
+    for(GlobalFieldCoverage::Cell& cell : globalFieldCoverage.grid)
+      setCell(cell, theFrameInfo.time, min + static_cast<int>(cell.positionOnField.squaredNorm()) / 1000);
   }
 
-  auto addLine = [&](const FieldCoverage::GridLine& line)
-  {
-    const size_t base = line.y * line.timestamps.size();
-
-    for(size_t x = 0; x < line.timestamps.size(); ++x)
-    {
-      if(line.timestamps[x] > globalFieldCoverage.grid[base + x].timestamp)
-      {
-        globalFieldCoverage.grid[base + x].timestamp = line.timestamps[x];
-        globalFieldCoverage.grid[base + x].coverage = line.timestamps[x];
-      }
-    }
-  };
-
-  for(size_t y = 0; y < theFieldCoverage.lines.size(); ++y)
-    addLine(theFieldCoverage.lines[y]);
+  // Since the timestamps of the cells never decrease, a line that was merged
+  // before cannot change the grid again unless it changed itself.
+  merge(globalFieldCoverage, theFieldCoverage, ownVersions);
   for(const auto& teammate : theTeamData.teammates)
-    for(size_t y = 0; y < teammate.theFieldCoverage.lines.size(); ++y)
-      addLine(teammate.theFieldCoverage.lines[y]);
+    merge(globalFieldCoverage, teammate.theFieldCoverage, teammateVersions[teammate.number]);
 
   if(theTeamBallModel.isValid)
     setCoverageAtFieldPosition(globalFieldCoverage, theTeamBallModel.position, 0);
@@ -50,13 +38,31 @@ void GlobalFieldCoverageProvider::update(GlobalFieldCoverage& globalFieldCoverag
     setCoverageAtFieldPosition(globalFieldCoverage, theRobotPose * theBallModel.estimate.position, 0);
   setCoverageAtFieldPosition(globalFieldCoverage, theRobotPose.translation, theFrameInfo.time);
 
-  globalFieldCoverage.meanCoverage = 0;
-  for(size_t i = 0; i < globalFieldCoverage.grid.size(); ++i)
-    globalFieldCoverage.meanCoverage += globalFieldCoverage.grid[i].coverage;
-  globalFieldCoverage.meanCoverage /= static_cast<int>(globalFieldCoverage.grid.size());
+  globalFieldCoverage.meanCoverage = static_cast<int>(coverageSum / static_cast<long long>(globalFieldCoverage.grid.size()));
+}
+
+void GlobalFieldCoverageProvider::merge(GlobalFieldCoverage& globalFieldCoverage, const FieldCoverage& fieldCoverage, LineVersions& versions)
+{
+  for(size_t y = 0; y < fieldCoverage.lines.size(); ++y)
+    if(fieldCoverage.lines[y].version != versions[y])
+    {
+      versions[y] = fieldCoverage.lines[y].version;
+      addLine(globalFieldCoverage, fieldCoverage.lines[y]);
+    }
 }
 
-void GlobalFieldCoverageProvider::setCoverageAtFieldPosition(GlobalFieldCoverage& globalFieldCoverage, const Vector2f& positionOnField, const int coverage) const
+void GlobalFieldCoverageProvider::addLine(GlobalFieldCoverage& globalFieldCoverage, const FieldCoverage::GridLine& line)
+{
+  const size_t base = line.y * line.timestamps.size();
+
+  for(size_t x = 0; x < line.timestamps.size(); ++x)
+  {
+    if(line.timestamps[x] > globalFieldCoverage.grid[base + x].timestamp)
+      setCell(globalFieldCoverage.grid[base + x], line.timestamps[x], line.timestamps[x]);
+  }
+}
+
+void GlobalFieldCoverageProvider::setCoverageAtFieldPosition(GlobalFieldCoverage& globalFieldCoverage, const Vector2f& positionOnField, const int coverage)
 {
   if(theFieldDimensions.isInsideField(positionOnField))
   {
@@ -65,8 +71,7 @@ void GlobalFieldCoverageProvider::setCoverageAtFieldPosition(GlobalFieldCoverage
     const int x = std::min(static_cast<int>((positionOnField.x() - theFieldDimensions.xPosOwnGroundLine) / globalFieldCoverage.cellLengthX), globalFieldCoverage.numOfCellsX - 1);
     const int y = std::min(static_cast<int>((positionOnField.y() - theFieldDimensions.yPosRightSideline) / globalFieldCoverage.cellLengthY), globalFieldCoverage.numOfCellsY - 1);
 
-    globalFieldCoverage.grid[y * globalFieldCoverage.numOfCellsX + x].timestamp = theFrameInfo.time;
-    globalFieldCoverage.grid[y * globalFieldCoverage.numOfCellsX + x].coverage = coverage;
+    setCell(globalFieldCoverage.grid[y * globalFieldCoverage.numOfCellsX + x], theFrameInfo.time, coverage);
   }
 }
 
@@ -87,9 +92,46 @@ void GlobalFieldCoverageProvider::init(GlobalFieldCoverage& globalFieldCoverage)
     for(int x = 0; x < globalFieldCoverage.numOfCellsX; ++x)
     {
       globalFieldCoverage.grid.emplace_back(time, time, positionOnFieldX, positionOnFieldY, globalFieldCoverage.cellLengthX, globalFieldCoverage.cellLengthY);
+      coverageSum += time;
       positionOnFieldX += globalFieldCoverage.cellLengthX;
     }
     positionOnFieldX = theFieldDimensions.xPosOwnGroundLine + globalFieldCoverage.cellLengthX / 2.f;
     positionOnFieldY += globalFieldCoverage.cellLengthY;
   }
 }
+
+void GlobalFieldCoverageProvider::benchmark(const GlobalFieldCoverage& globalFieldCoverage)
+{
+  // The own field coverage and those of 6 teammates, each of which changes one line per frame.
+  constexpr int numOfSources = 7;
+  constexpr int numOfFrames = 1000;
+  std::vector<FieldCoverage> sources(numOfSources, theFieldCoverage);
+  std::vector<LineVersions> versions(numOfSources);
+  double durations[2];
+  const long long coverageSumBefore = coverageSum;
+  for(int incremental = 0; incremental < 2; ++incremental)
+  {
+    GlobalFieldCoverage grid = globalFieldCoverage;
+    std::fill(versions.begin(), versions.end(), LineVersions());
+    const auto start = std::chrono::steady_clock::now();
+    for(int frame = 0; frame < numOfFrames; ++frame)
+    {
+      for(int source = 0; source < numOfSources; ++source)
+      {
+        FieldCoverage::GridLine& line = sources[source].lines[(frame + source) % sources[source].lines.size()];
+        for(unsigned& timestamp : line.timestamps)
+          timestamp = theFrameInfo.time + frame + 1;
+        line.version = theFrameInfo.time + frame + 1;
+        if(incremental)
+          merge(grid, sources[source], versions[source]);
+        else
+          for(const FieldCoverage::GridLine& gridLine : sources[source].lines)
+            addLine(grid, gridLine);
+      }
+    }
+    durations[incremental] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / numOfFrames;
+  }
+  coverageSum = coverageSumBefore;
+
+  OUTPUT_TEXT("GlobalFieldCoverageProvider: all lines " << durations[0] << " µs/frame, changed lines " << durations[1] << " µs/frame");
+}
@@ -16,6 +16,8 @@
 #include "Representations/Modeling/RobotPose.h"
 #include "Representations/Modeling/TeamBallModel.h"
 #include "Tools/Module/Module.h"
+#include <array>
+#include <unordered_map>
 
 MODULE(GlobalFieldCoverageProvider,
 {,
@@ -34,10 +36,40 @@ MODULE(GlobalFieldCoverageProvider,
 
 class GlobalFieldCoverageProvider : public GlobalFieldCoverageProviderBase
 {
+  /** The versions of the lines of a field coverage that were merged into the grid. */
+  using LineVersions = std::array<unsigned, std::tuple_size<decltype(FieldCoverage::lines)>::value>;
+
   void update(GlobalFieldCoverage& globalFieldCoverage) override;
 
   bool initDone = false;
   void init(GlobalFieldCoverage& globalFieldCoverage);
 
-  void setCoverageAtFieldPosition(GlobalFieldCoverage& globalFieldCoverage, const Vector2f& positionOnField, const int coverage) const;
+  void setCoverageAtFieldPosition(GlobalFieldCoverage& globalFieldCoverage, const Vector2f& positionOnField, const int coverage);
+
+  /**
+   * Merges the lines of a field coverage into the grid that changed since
+   * they were merged the last time.
+   * @param globalFieldCoverage The grid.
+   * @param fieldCoverage The field coverage of this robot or of a teammate.
+   * @param versions The versions of the lines merged before. They are updated.
+   */
+  void merge(GlobalFieldCoverage& globalFieldCoverage, const FieldCoverage& fieldCoverage, LineVersions& versions);
+
+  /** Merges a line into the grid. */
+  void addLine(GlobalFieldCoverage& globalFieldCoverage, const FieldCoverage::GridLine& line);
+
+  /** Sets a cell of the grid and keeps the sum of the coverages up to date. */
+  void setCell(GlobalFieldCoverage::Cell& cell, unsigned timestamp, int coverage)
+  {
+    coverageSum += static_cast<long long>(coverage) - cell.coverage;
+    cell.timestamp = timestamp;
+    cell.coverage = coverage;
+  }
+
+  /** Compares merging all lines of 7 robots with merging only the lines that changed. */
+  void benchmark(const GlobalFieldCoverage& globalFieldCoverage);
+
+  long long coverageSum = 0; /**< The sum of the coverages of all cells. */
+  LineVersions ownVersions = {}; /**< The versions of the lines of this robot merged. */
+  std::unordered_map<int, LineVersions> teammateVersions; /**< The versions of the lines merged per teammate number. */
 };
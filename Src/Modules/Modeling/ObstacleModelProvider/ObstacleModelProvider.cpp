@@ -125,8 +125,7 @@ void ObstacleModelProvider::dynamic()
 
 void ObstacleModelProvider::addArmContacts()
 {
-  merged.clear();
-  merged.resize(obstacleHypotheses.size());
+  merged.reset();
 
   FOREACH_ENUM(Arms::Arm, arm)
   {
@@ -151,8 +150,7 @@ void ObstacleModelProvider::addArmContacts()
 
 void ObstacleModelProvider::addFootContacts()
 {
-  merged.clear();
-  merged.resize(obstacleHypotheses.size());
+  merged.reset();
 
   FOREACH_ENUM(Legs::Leg, leg)
   {
@@ -180,8 +178,7 @@ void ObstacleModelProvider::addPlayerPercepts()
   if(theObstaclesFieldPercept.obstacles.empty())
     return;
 
-  merged.clear();
-  merged.resize(obstacleHypotheses.size());
+  merged.reset();
 
   const Vector2f& robotRotationDeviation = theMotionInfo.executedPhase == MotionPhase::stand ? pRobotRotationDeviationInStand : pRobotRotationDeviation;
 
@@ -211,8 +208,8 @@ void ObstacleModelProvider::tryToMerge(const ObstacleHypothesis& measurement)
 {
   if(obstacleHypotheses.empty())
   {
-    obstacleHypotheses.emplace_back(measurement);
-    merged.push_back(true);
+    obstacleHypotheses.push_back(measurement);
+    merged[0] = true;
     return;
   }
 
@@ -252,8 +249,11 @@ void ObstacleModelProvider::tryToMerge(const ObstacleHypothesis& measurement)
   }
 
   // Did not find possible match.
-  obstacleHypotheses.emplace_back(measurement);
-  merged.push_back(true);
+  if(!obstacleHypotheses.full())
+  {
+    merged[obstacleHypotheses.size()] = true;
+    obstacleHypotheses.push_back(measurement);
+  }
 }
 
 void ObstacleModelProvider::considerTeamData()
@@ -32,6 +32,8 @@
 #include "Representations/Sensing/RobotModel.h"
 #include "Representations/Sensing/TorsoMatrix.h"
 #include "Tools/Module/Module.h"
+#include "Tools/ObjectPool.h"
+#include <bitset>
 
 MODULE(ObstacleModelProvider,
 {,
@@ -121,8 +123,10 @@ class ObstacleModelProvider : public ObstacleModelProviderBase
   // Used for writing annotations only once per contact.
   bool armContact[Arms::numOfArms] = { false, false }, footContact[Legs::numOfLegs] = { false, false };
 
-  std::vector<ObstacleHypothesis, Eigen::aligned_allocator<ObstacleHypothesis>> obstacleHypotheses; /**< List of obstacles. */
-  std::vector<bool> merged; /**< This is to merge obstacles once for every "percept" per frame. */
+  static constexpr std::size_t maxNumOfHypotheses = 64; /**< More hypotheses are not tracked. Measurements that would add more are ignored. */
+
+  ObjectPool<ObstacleHypothesis, maxNumOfHypotheses> obstacleHypotheses; /**< List of obstacles. */
+  std::bitset<maxNumOfHypotheses> merged; /**< This is to merge obstacles once for every "percept" per frame. */
 
   /** The function is called when the representation provided needs to be updated. */
   void update(ObstacleModel& obstacleModel) override;
@@ -32,26 +32,25 @@ void TeamPlayersLocator::update(TeamPlayersModel& teamPlayersModel)
   auto& obstacles = teamPlayersModel.obstacles;
   DECLARE_DEBUG_DRAWING("module:TeamPlayersLocator:others", "drawingOnField");
   obstacles.clear();
-  ownTeam.clear();
+  ownTeam.fill(nullptr);
+  others.clear();
 
   if(theRobotInfo.penalty != PENALTY_NONE || !theGroundContactState.contact || theFallDownState.state != theFallDownState.upright)
     return;
 
-  std::vector<std::pair<Obstacle, unsigned char>, Eigen::aligned_allocator<std::pair<Obstacle, unsigned char>>> others;
-
   for(auto& goalPost : goalPosts)
   {
     obstacles.push_back(goalPost);
   }
 
-  ownTeam[theRobotInfo.number] = theRobotPose;
+  ownTeam[theRobotInfo.number] = &theRobotPose;
   for(auto const& teammate : theTeamData.teammates)
   {
     if(teammate.status == Teammate::PLAYING)
     {
       if(teammate.theRobotPose.getTranslationalStandardDeviation() < teammatePoseDeviation)
       {
-        ownTeam[teammate.number] = teammate.theRobotPose; //position of teammates
+        ownTeam[teammate.number] = &teammate.theRobotPose; //position of teammates
       }
     }
   }
@@ -70,8 +69,8 @@ void TeamPlayersLocator::update(TeamPlayersModel& teamPlayersModel)
       Covariance::fixCovariance(covariance);
       if(isInsideOwnDetectionArea(p, theRobotInfo.number, obstacle.lastSeen))
         obstacles.emplace_back(covariance, p, obstacle.lastSeen, obstacle.type);
-      else
-        others.emplace_back(Obstacle(covariance, p, obstacle.lastSeen, obstacle.type), 0);
+      else if(!others.full())
+        others.push_back(std::make_pair(Obstacle(covariance, p, obstacle.lastSeen, obstacle.type), 0));
     }
   }
 
@@ -96,10 +95,10 @@ void TeamPlayersLocator::update(TeamPlayersModel& teamPlayersModel)
             Matrix2f covariance = Covariance::rotateCovarianceMatrix(obstacle.covariance, teammate.theRobotPose.rotation);
             Covariance::fixCovariance(covariance);
             if(isInsideOwnDetectionArea(p, teammate.number, obstacle.lastSeen)
-               && !collideOtherDetectionArea(p, teammate.number, ownTeam, obstacle.center.cast<float>().squaredNorm()))
+               && !collideOtherDetectionArea(p, teammate.number, obstacle.center.cast<float>().squaredNorm()))
               obstacles.emplace_back(covariance, p, obstacle.lastSeen, obstacle.type);
-            else
-              others.emplace_back(Obstacle(covariance, p, obstacle.lastSeen, obstacle.type), 0);
+            else if(!others.full())
+              others.push_back(std::make_pair(Obstacle(covariance, p, obstacle.lastSeen, obstacle.type), 0));
           }
         }
       }
@@ -165,11 +164,11 @@ void TeamPlayersLocator::update(TeamPlayersModel& teamPlayersModel)
     }
   }
 
-  for(const auto& tm : ownTeam)
+  for(int number = 0; number < static_cast<int>(ownTeam.size()); ++number)
   {
-    if(tm.first == theRobotInfo.number)
+    if(!ownTeam[number] || number == theRobotInfo.number)
       continue;
-    obstacles.emplace_back(tm.second.covariance.topLeftCorner(2, 2), tm.second.translation, theFrameInfo.time);
+    obstacles.emplace_back(ownTeam[number]->covariance.topLeftCorner(2, 2), ownTeam[number]->translation, theFrameInfo.time);
   }
 }
 
@@ -182,21 +181,21 @@ bool TeamPlayersLocator::isInsideOwnDetectionArea(const Vector2f& position, int
 bool TeamPlayersLocator::isInsideOwnDetectionArea(const Vector2f& position, int robotNumber, float& distance, int lastSeen) const
 {
   //obstacles behind the robot are okay
-  Vector2f point = ownTeam.at(robotNumber).inversePose * position;
+  ASSERT(ownTeam[robotNumber]);
+  Vector2f point = ownTeam[robotNumber]->inversePose * position;
   distance = point.squaredNorm();
   return (theFrameInfo.getTimeSince(lastSeen) < obstacleAgeThreshold || point.x() > -2.f * Obstacle::getRobotDepth())
          && distance <= sqr(selfDetectionOnlyRadius);
 }
 
-bool TeamPlayersLocator::collideOtherDetectionArea(const Vector2f& position, int robotNumber, std::map<int, RobotPose>& ownTeam,
-                                                   const float distance) const
+bool TeamPlayersLocator::collideOtherDetectionArea(const Vector2f& position, int robotNumber, const float distance) const
 {
   float tempDistance;
-  for(const auto& otherPlayer : ownTeam)
+  for(int number = 0; number < static_cast<int>(ownTeam.size()); ++number)
   {
-    if(otherPlayer.first == robotNumber)
+    if(!ownTeam[number] || number == robotNumber)
       continue;
-    if(isInsideOwnDetectionArea(position, otherPlayer.first, tempDistance, obstacleAgeThreshold) && tempDistance < distance)
+    if(isInsideOwnDetectionArea(position, number, tempDistance, obstacleAgeThreshold) && tempDistance < distance)
       return true;
   }
   return false;
@@ -214,11 +213,11 @@ bool TeamPlayersLocator::isGoalPost(const Vector2f& position) const
 
 bool TeamPlayersLocator::isTeammate(const Vector2f& position, const float radius, int ignoreRobotNumber) const
 {
-  for(const auto& tm : ownTeam)
+  for(int number = 0; number < static_cast<int>(ownTeam.size()); ++number)
   {
-    if(ignoreRobotNumber == tm.first)
+    if(!ownTeam[number] || ignoreRobotNumber == number)
       continue;
-    if((position - tm.second.translation).squaredNorm() < radius)
+    if((position - ownTeam[number]->translation).squaredNorm() < radius)
       return true;
   }
   return false;
@@ -226,9 +225,9 @@ bool TeamPlayersLocator::isTeammate(const Vector2f& position, const float radius
 
 bool TeamPlayersLocator::isTeammate(const Vector2f& position, const float radius) const
 {
-  for(const auto& tm : ownTeam)
+  for(const RobotPose* pose : ownTeam)
   {
-    if((position - tm.second.translation).squaredNorm() < radius)
+    if(pose && (position - pose->translation).squaredNorm() < radius)
       return true;
   }
   return false;
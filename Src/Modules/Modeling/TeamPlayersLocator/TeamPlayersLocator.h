@@ -18,7 +18,9 @@
 #include "Representations/Sensing/GroundContactState.h"
 #include "Tools/Modeling/Obstacle.h"
 #include "Tools/Module/Module.h"
-#include <map>
+#include "Tools/ObjectPool.h"
+#include "Tools/Settings.h"
+#include <array>
 #include <vector>
 
 MODULE(TeamPlayersLocator,
@@ -61,13 +63,13 @@ private:
 
   bool isInsideOwnDetectionArea(const Vector2f& position, int robotNumber, float& distance, int lastSeen) const;
   bool isInsideOwnDetectionArea(const Vector2f& position, int robotNumber, int lastSeen) const;
-  bool collideOtherDetectionArea(const Vector2f& position, int robotNumber, std::map<int, RobotPose>& ownTeam,
-                                 const float distance) const;
+  bool collideOtherDetectionArea(const Vector2f& position, int robotNumber, const float distance) const;
   bool isGoalPost(const Vector2f& position) const;
   bool isTeammate(const Vector2f& position, const float radius, int ignoreRobotNumber) const;
   bool isTeammate(const Vector2f& position, const float radius) const;
   void setType(Obstacle& one, const Obstacle& other) const;
 
-  std::map<int, RobotPose> ownTeam;
+  std::array<const RobotPose*, Settings::highestValidPlayerNumber + 1> ownTeam; /**< The poses of the own team by player number. nullptr if not used. */
+  ObjectPool<std::pair<Obstacle, unsigned char>, 128> others; /**< Obstacles not in the detection area of a player and how often they were merged. */
   std::vector<Obstacle, Eigen::aligned_allocator<Obstacle>> goalPosts;
 };
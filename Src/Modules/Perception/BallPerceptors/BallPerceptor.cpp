@@ -16,13 +16,11 @@
 #include "Tools/Global.h"
 #include "Tools/Math/Projection.h"
 #include "Tools/Math/Transformation.h"
+#include "Tools/NeuralNetwork/CompiledNNCache.h"
 
 MAKE_MODULE(BallPerceptor, perception);
 
-BallPerceptor::BallPerceptor() :
-  encoder(&Global::getAsmjitRuntime()),
-  classifier(&Global::getAsmjitRuntime()),
-  corrector(&Global::getAsmjitRuntime())
+BallPerceptor::BallPerceptor()
 {
   compile();
 }
@@ -36,7 +34,7 @@ void BallPerceptor::update(BallPercept& theBallPercept)
 
   theBallPercept.status = BallPercept::notSeen;
 
-  if(!encoder.valid() || !classifier.valid() || !corrector.valid())
+  if(!encoder->valid() || !classifier->valid() || !corrector->valid())
     return;
 
   const std::vector<Vector2i>& ballSpots = theBallSpots.ballSpots;
@@ -122,34 +120,34 @@ float BallPerceptor::apply(const Vector2i& ballSpot, Vector2f& ballPosition, flo
   STOPWATCH("module:BallPerceptor:getImageSection")
     if(useFloat)
     {
-      PatchUtilities::extractPatch(ballSpot, Vector2i(ballArea, ballArea), Vector2i(patchSize, patchSize), theECImage.grayscaled, encoder.input(0).data(), extractionMode);
+      PatchUtilities::extractPatch(ballSpot, Vector2i(ballArea, ballArea), Vector2i(patchSize, patchSize), theECImage.grayscaled, encoder->input(0).data(), extractionMode);
       if(useContrastNormalization)
-        PatchUtilities::normalizeContrast(encoder.input(0).data(), Vector2i(patchSize, patchSize), contrastNormalizationPercent);
+        PatchUtilities::normalizeContrast(encoder->input(0).data(), Vector2i(patchSize, patchSize), contrastNormalizationPercent);
     }
     else
     {
-      PatchUtilities::extractPatch(ballSpot, Vector2i(ballArea, ballArea), Vector2i(patchSize, patchSize), theECImage.grayscaled, reinterpret_cast<unsigned char*>(encoder.input(0).data()), extractionMode);
+      PatchUtilities::extractPatch(ballSpot, Vector2i(ballArea, ballArea), Vector2i(patchSize, patchSize), theECImage.grayscaled, reinterpret_cast<unsigned char*>(encoder->input(0).data()), extractionMode);
       if(useContrastNormalization)
-        PatchUtilities::normalizeContrast(reinterpret_cast<unsigned char*>(encoder.input(0).data()), Vector2i(patchSize, patchSize), contrastNormalizationPercent);
+        PatchUtilities::normalizeContrast(reinterpret_cast<unsigned char*>(encoder->input(0).data()), Vector2i(patchSize, patchSize), contrastNormalizationPercent);
     }
   const float stepSize = static_cast<float>(ballArea) / static_cast<float>(patchSize);
 
   // encode patch
-  encoder.apply();
+  encoder->apply();
 
   // classify
-  classifier.input(0) = encoder.output(0);
-  classifier.apply();
-  const float pred = classifier.output(0)[0];
+  classifier->input(0) = encoder->output(0);
+  classifier->apply();
+  const float pred = classifier->output(0)[0];
 
   // predict ball position if poss for ball is high enough
   if(pred > guessedThreshold)
   {
-    corrector.input(0) = encoder.output(0);
-    corrector.apply();
-    ballPosition.x() = (corrector.output(0)[0] - patchSize / 2) * stepSize + ballSpot.x();
-    ballPosition.y() = (corrector.output(0)[1] - patchSize / 2) * stepSize + ballSpot.y();
-    predRadius = corrector.output(0)[2] * stepSize;
+    corrector->input(0) = encoder->output(0);
+    corrector->apply();
+    ballPosition.x() = (corrector->output(0)[0] - patchSize / 2) * stepSize + ballSpot.x();
+    ballPosition.y() = (corrector->output(0)[1] - patchSize / 2) * stepSize + ballSpot.y();
+    predRadius = corrector->output(0)[2] * stepSize;
   }
 
   return pred;
@@ -158,30 +156,23 @@ float BallPerceptor::apply(const Vector2i& ballSpot, Vector2f& ballPosition, flo
 void BallPerceptor::compile()
 {
   const std::string baseDir = std::string(File::getBHDir()) + "/Config/NeuralNets/BallPerceptor/";
-  encModel = std::make_unique<NeuralNetwork::Model>(baseDir + encoderName);
-  clModel = std::make_unique<NeuralNetwork::Model>(baseDir + classifierName);
-  corModel = std::make_unique<NeuralNetwork::Model>(baseDir + correctorName);
+  encoder = &Global::getCompiledNNCache().get(baseDir + encoderName, !useFloat);
+  classifier = &Global::getCompiledNNCache().get(baseDir + classifierName);
+  corrector = &Global::getCompiledNNCache().get(baseDir + correctorName);
 
-  if(!useFloat)
-    encModel->setInputUInt8(0);
+  ASSERT(encoder->numOfInputs() == 1);
+  ASSERT(classifier->numOfInputs() == 1);
+  ASSERT(corrector->numOfInputs() == 1);
 
-  encoder.compile(*encModel);
-  classifier.compile(*clModel);
-  corrector.compile(*corModel);
+  ASSERT(classifier->numOfOutputs() == 1);
+  ASSERT(corrector->numOfOutputs() == 1);
+  ASSERT(encoder->numOfOutputs() == 1);
 
-  ASSERT(encoder.numOfInputs() == 1);
-  ASSERT(classifier.numOfInputs() == 1);
-  ASSERT(corrector.numOfInputs() == 1);
+  ASSERT(encoder->input(0).rank() == 3);
+  ASSERT(encoder->input(0).dims(0) == encoder->input(0).dims(1));
+  ASSERT(encoder->input(0).dims(2) == 1);
 
-  ASSERT(classifier.numOfOutputs() == 1);
-  ASSERT(corrector.numOfOutputs() == 1);
-  ASSERT(encoder.numOfOutputs() == 1);
-
-  ASSERT(encoder.input(0).rank() == 3);
-  ASSERT(encoder.input(0).dims(0) == encoder.input(0).dims(1));
-  ASSERT(encoder.input(0).dims(2) == 1);
-
-  ASSERT(classifier.output(0).rank() == 1);
-  ASSERT(classifier.output(0).dims(0) == 1 && corrector.output(0).dims(0) == 3);
-  patchSize = encoder.input(0).dims(0);
+  ASSERT(classifier->output(0).rank() == 1);
+  ASSERT(classifier->output(0).dims(0) == 1 && corrector->output(0).dims(0) == 3);
+  patchSize = encoder->input(0).dims(0);
 }
@@ -27,7 +27,6 @@
 #include "Tools/Math/Eigen.h"
 #include "Tools/Module/Module.h"
 #include <CompiledNN/CompiledNN.h>
-#include <CompiledNN/Model.h>
 
 MODULE(BallPerceptor,
 {,
@@ -66,13 +65,9 @@ public:
   BallPerceptor();
 
 private:
-  NeuralNetwork::CompiledNN encoder;
-  NeuralNetwork::CompiledNN classifier;
-  NeuralNetwork::CompiledNN corrector;
-
-  std::unique_ptr<NeuralNetwork::Model> encModel;
-  std::unique_ptr<NeuralNetwork::Model> clModel;
-  std::unique_ptr<NeuralNetwork::Model> corModel;
+  NeuralNetwork::CompiledNN* encoder = nullptr; /**< The encoder, owned by the cache of this thread. */
+  NeuralNetwork::CompiledNN* classifier = nullptr; /**< The classifier, owned by the cache of this thread. */
+  NeuralNetwork::CompiledNN* corrector = nullptr; /**< The corrector, owned by the cache of this thread. */
 
   std::size_t patchSize = 0;
 
@@ -15,32 +15,28 @@
 #include "Platform/File.h"
 #include "Tools/Debugging/DebugDrawings.h"
 #include "Tools/Global.h"
+#include "Tools/NeuralNetwork/CompiledNNCache.h"
 #include "Tools/ImageProcessing/PatchUtilities.h"
 #include "Tools/Math/Transformation.h"
 
 MAKE_MODULE(FieldBoundaryProvider, perception);
 
 FieldBoundaryProvider::FieldBoundaryProvider() :
-  network(&Global::getAsmjitRuntime())
+  network(&Global::getCompiledNNCache().get(std::string(File::getBHDir()) + ((theCameraInfo.camera == CameraInfo::upper) ? "/Config/NeuralNets/FieldBoundary/net.h5" : "/Config/NeuralNets/FieldBoundary/net-uncertainty.h5"), true))
 {
-  model = std::make_unique<NeuralNetwork::Model>(std::string(File::getBHDir()) + ((theCameraInfo.camera == CameraInfo::upper) ? "/Config/NeuralNets/FieldBoundary/net.h5" : "/Config/NeuralNets/FieldBoundary/net-uncertainty.h5"));
-  model->setInputUInt8(0);
+  ASSERT(network->valid());
 
-  network.compile(*model);
+  ASSERT(network->numOfInputs() == 1);
+  ASSERT(network->numOfOutputs() == 1);
 
-  ASSERT(network.valid());
+  ASSERT(network->input(0).rank() == 3);
+  ASSERT(network->input(0).dims(2) == 1 || network->input(0).dims(2) == 3);
 
-  ASSERT(network.numOfInputs() == 1);
-  ASSERT(network.numOfOutputs() == 1);
+  patchSize = Vector2i(network->input(0).dims(1), network->input(0).dims(0));
 
-  ASSERT(network.input(0).rank() == 3);
-  ASSERT(network.input(0).dims(2) == 1 || network.input(0).dims(2) == 3);
-
-  patchSize = Vector2i(network.input(0).dims(1), network.input(0).dims(0));
-
-  ASSERT(network.output(0).rank() == 1 || network.output(0).rank() == 2);
-  ASSERT(network.output(0).dims(0) == static_cast<unsigned>(patchSize.x()));
-  ASSERT(network.output(0).rank() == 1 || network.output(0).dims(1) == 2);
+  ASSERT(network->output(0).rank() == 1 || network->output(0).rank() == 2);
+  ASSERT(network->output(0).dims(0) == static_cast<unsigned>(patchSize.x()));
+  ASSERT(network->output(0).rank() == 1 || network->output(0).dims(1) == 2);
 }
 
 void FieldBoundaryProvider::update(FieldBoundary& fieldBoundary)
@@ -50,7 +46,7 @@ void FieldBoundaryProvider::update(FieldBoundary& fieldBoundary)
 
   fieldBoundary.boundaryInImage.clear();
   fieldBoundary.boundaryOnField.clear();
-  if((fieldBoundary.isValid = network.valid() && theCameraMatrix.isValid))
+  if((fieldBoundary.isValid = network->valid() && theCameraMatrix.isValid))
   {
     if(!fieldBoundary.isValid)
     {
@@ -144,25 +140,25 @@ void FieldBoundaryProvider::projectPrevious(FieldBoundary& fieldBoundary)
 
 void FieldBoundaryProvider::predictSpots(std::vector<Spot>& spots)
 {
-  unsigned char* input = reinterpret_cast<std::uint8_t*>(network.input(0).data());
+  unsigned char* input = reinterpret_cast<std::uint8_t*>(network->input(0).data());
 
-  if(network.input(0).dims(2) == 1)
+  if(network->input(0).dims(2) == 1)
     PatchUtilities::extractInput<std::uint8_t, true>(theCameraImage, patchSize, input);
   else
     PatchUtilities::extractInput<std::uint8_t, false>(theCameraImage, patchSize, input);
 
-  network.apply();
-  const float* output = network.output(0).data();
+  network->apply();
+  const float* output = network->output(0).data();
 
   const unsigned int xScale = theCameraInfo.width / patchSize(0);
-  const unsigned int stepSize = network.output(0).rank() == 2 ? 2 : 1;
+  const unsigned int stepSize = network->output(0).rank() == 2 ? 2 : 1;
   for(int x = 0, idx = 0; x < patchSize(0); ++x, idx += stepSize)
   {
     const Vector2f spotInImage(x * xScale + xScale / 2, std::max(0.f, std::min(output[idx], 1.f)) * static_cast<float>(theCameraInfo.height - 1));
     DOT("module:FieldBoundaryProvider:prediction", spotInImage.x(), spotInImage.y(), ColorRGBA::orange, ColorRGBA::orange);
     float uncertainty = 0;
 
-    if(network.output(0).rank() == 2)
+    if(network->output(0).rank() == 2)
     {
       uncertainty = 1.f / (output[idx + 1] * output[idx + 1]) * static_cast<float>(theCameraInfo.height - 1);
       DOT("module:FieldBoundaryProvider:prediction", spotInImage.x(), spotInImage.y() + uncertainty, ColorRGBA::blue, ColorRGBA::blue);
@@ -8,6 +8,7 @@
 
 #include "PlayersDeeptector.h"
 #include "Platform/File.h"
+#include "Platform/Time.h"
 #include "Tools/Debugging/DebugDrawings.h"
 #include "Tools/Debugging/Stopwatch.h"
 #include "Tools/Global.h"
@@ -16,12 +17,11 @@
 #include "Tools/Math/Eigen.h"
 #include "Tools/Math/Projection.h"
 #include "Tools/Math/Transformation.h"
-#include <CompiledNN/Model.h>
+#include "Tools/NeuralNetwork/CompiledNNCache.h"
 
 MAKE_MODULE(PlayersDeeptector, perception);
 
-PlayersDeeptector::PlayersDeeptector() :
-  convModel(&Global::getAsmjitRuntime())
+PlayersDeeptector::PlayersDeeptector()
 {
   NeuralNetwork::CompilationSettings settings;
   settings.useExpApproxInSigmoid = false;
@@ -29,17 +29,15 @@ PlayersDeeptector::PlayersDeeptector() :
 
   if(theCameraInfo.camera == CameraInfo::upper)
   {
-    model = std::make_unique<NeuralNetwork::Model>(std::string(File::getBHDir()) + "/Config/NeuralNets/PlayersDeeptector/players_deeptector.h5");
-    model->setInputUInt8(0);
-    convModel.compile(*model, settings);
-    ASSERT(convModel.numOfInputs() == 1);
-    ASSERT(convModel.input(0).rank() == 3);
-    patchSize(0) = convModel.input(0).dims(1); // width
-    patchSize(1) = convModel.input(0).dims(0); // height
-    ASSERT(convModel.input(0).dims(2) == 1);
-    ASSERT(convModel.numOfOutputs() == 1);
-    ASSERT(convModel.output(0).rank() == 3);
-    ASSERT(convModel.output(0).dims(2) == 4 * 6);
+    convModel = &Global::getCompiledNNCache().get(std::string(File::getBHDir()) + "/Config/NeuralNets/PlayersDeeptector/players_deeptector.h5", true, settings);
+    ASSERT(convModel->numOfInputs() == 1);
+    ASSERT(convModel->input(0).rank() == 3);
+    patchSize(0) = convModel->input(0).dims(1); // width
+    patchSize(1) = convModel->input(0).dims(0); // height
+    ASSERT(convModel->input(0).dims(2) == 1);
+    ASSERT(convModel->numOfOutputs() == 1);
+    ASSERT(convModel->output(0).rank() == 3);
+    ASSERT(convModel->output(0).dims(2) == 4 * 6);
 
     anchors.row(0) = Vector2f(0.5f, 1.f);
     anchors.row(1) = Vector2f(1.f, 2.f);
@@ -65,22 +63,10 @@ void PlayersDeeptector::update(ObstaclesFieldPercept& theObstaclesFieldPercept)
   if(theCameraInfo.camera == CameraInfo::upper)
   {
     LabelImage labelImage;
-    if(!convModel.valid() || !theFieldBoundary.isValid || !theECImage.grayscaled.width || !theECImage.grayscaled.height)
+    if(!convModel || !convModel->valid() || !theFieldBoundary.isValid || !theECImage.grayscaled.width || !theECImage.grayscaled.height)
       return;
 
-    const unsigned int scale = static_cast<unsigned int>(std::log2(theECImage.grayscaled.width / patchSize(0)) + 0.5);
-    ASSERT(theECImage.grayscaled.width == static_cast<unsigned>(patchSize(0)) << scale);
-    ASSERT(theECImage.grayscaled.height == static_cast<unsigned>(patchSize(1)) << scale);
-
-    // Can't shrink directly to NN input because it needs a larger buffer :-(
-    STOPWATCH("module:PlayersDeeptector:shrinkY") Resize::shrinkY(scale, theECImage.grayscaled, thumbnail);
-    ASSERT(patchSize(0) == static_cast<int>(thumbnail.width));
-    ASSERT(patchSize(1) == static_cast<int>(thumbnail.height));
-    std::memcpy(reinterpret_cast<unsigned char*>(convModel.input(0).data()), thumbnail[0], thumbnail.width * thumbnail.height * sizeof(unsigned char));
-    STOPWATCH("module:PlayersDeeptector:normalizeContrast")
-      PatchUtilities::normalizeContrast<unsigned char>(reinterpret_cast<unsigned char*>(convModel.input(0).data()), patchSize, 0.02f);
-    STOPWATCH("module:PlayersDeeptector:apply") convModel.apply();
-    STOPWATCH("module:PlayersDeeptector:boundingBoxes") boundingBoxes(labelImage);
+    detectUpper(labelImage);
 
     STOPWATCH("module:PlayersDeeptector:nonMaximumSuppression") labelImage.nonMaximumSuppression(0.3f);
     STOPWATCH("module:PlayersDeeptector:bigBoxSuppression") labelImage.bigBoxSuppression();
@@ -240,24 +226,183 @@ void PlayersDeeptector::update(ObstaclesPerceptorData& theObstaclesPerceptorData
   theObstaclesPerceptorData.imageCoordinateSystem = theImageCoordinateSystem;
 }
 
-void PlayersDeeptector::boundingBoxes(LabelImage& labelImage)
+void PlayersDeeptector::detectUpper(LabelImage& labelImage)
+{
+  DECLARE_DEBUG_DRAWING("module:PlayersDeeptector:rois", "drawingOnImage");
+  DECLARE_PLOT("module:PlayersDeeptector:roiCost");
+  DECLARE_PLOT("module:PlayersDeeptector:fullImageCost");
+  DECLARE_PLOT("module:PlayersDeeptector:recall");
+  DEBUG_RESPONSE_ONCE("module:PlayersDeeptector:roiReport")
+  {
+    if(roiEvaluation.frames)
+      OUTPUT_TEXT("PlayersDeeptector: " << roiEvaluation.frames << " images, tiles "
+                  << static_cast<float>(roiEvaluation.roiTime) / roiEvaluation.frames << " µs, full image "
+                  << static_cast<float>(roiEvaluation.fullImageTime) / roiEvaluation.frames << " µs, recall "
+                  << (roiEvaluation.total ? static_cast<float>(roiEvaluation.found) / roiEvaluation.total : 1.f));
+    roiEvaluation = ROIEvaluation();
+  }
+
+  const unsigned int scale = static_cast<unsigned int>(std::log2(theECImage.grayscaled.width / patchSize(0)) + 0.5);
+  ASSERT(theECImage.grayscaled.width == static_cast<unsigned>(patchSize(0)) << scale);
+  ASSERT(theECImage.grayscaled.height == static_cast<unsigned>(patchSize(1)) << scale);
+
+  // Tiles are searched at a higher resolution than the full image, because the network input has a fixed size.
+  const unsigned int downScales = scale - std::min(roiZoom, scale);
+  rois.clear();
+  if(useROIs)
+    odometryHistory.push_front({theFrameInfo.time, theOdometryData});
+  if(!useROIs || downScales == scale || frameCounter++ % std::max(1u, fullImageInterval) == 0 || !selectROIs(downScales))
+  {
+    detect(Vector2i::Zero(), scale, labelImage);
+    return;
+  }
+
+  const unsigned long long start = Time::getCurrentThreadTime();
+  for(const Vector2i& roi : rois)
+    detect(roi, downScales, labelImage);
+  const unsigned long long roiTime = Time::getCurrentThreadTime() - start;
+
+  DEBUG_RESPONSE("module:PlayersDeeptector:evaluateROIs")
+    evaluateROIs(labelImage, roiTime);
+
+  COMPLEX_DRAWING("module:PlayersDeeptector:rois")
+    for(const Vector2i& roi : rois)
+      RECTANGLE("module:PlayersDeeptector:rois", roi.x(), roi.y(), roi.x() + (patchSize(0) << downScales) - 1,
+                roi.y() + (patchSize(1) << downScales) - 1, 2, Drawings::solidPen, ColorRGBA::yellow);
+}
+
+void PlayersDeeptector::detect(const Vector2i& origin, unsigned downScales, LabelImage& labelImage)
+{
+  const Vector2i size(patchSize(0) << downScales, patchSize(1) << downScales);
+  if(size.x() == static_cast<int>(theECImage.grayscaled.width))
+  {
+    // Can't shrink directly to NN input because it needs a larger buffer :-(
+    STOPWATCH("module:PlayersDeeptector:shrinkY") Resize::shrinkY(downScales, theECImage.grayscaled, thumbnail);
+    ASSERT(patchSize(0) == static_cast<int>(thumbnail.width));
+    ASSERT(patchSize(1) == static_cast<int>(thumbnail.height));
+    std::memcpy(reinterpret_cast<unsigned char*>(convModel->input(0).data()), thumbnail[0], thumbnail.width * thumbnail.height * sizeof(unsigned char));
+  }
+  else
+    STOPWATCH("module:PlayersDeeptector:extractTile") extractTile(origin, downScales);
+  STOPWATCH("module:PlayersDeeptector:normalizeContrast")
+    PatchUtilities::normalizeContrast<unsigned char>(reinterpret_cast<unsigned char*>(convModel->input(0).data()), patchSize, 0.02f);
+  STOPWATCH("module:PlayersDeeptector:apply") convModel->apply();
+  STOPWATCH("module:PlayersDeeptector:boundingBoxes")
+    boundingBoxes(labelImage, origin, size, static_cast<float>(theECImage.grayscaled.width) / size.x());
+}
+
+void PlayersDeeptector::extractTile(const Vector2i& origin, unsigned downScales)
+{
+  const int factor = 1 << downScales;
+  const unsigned shift = 2 * downScales;
+  unsigned char* dest = reinterpret_cast<unsigned char*>(convModel->input(0).data());
+  for(int y = 0; y < patchSize(1); ++y)
+    for(int x = 0; x < patchSize(0); ++x, ++dest)
+    {
+      unsigned sum = 0;
+      for(int yy = 0; yy < factor; ++yy)
+      {
+        const PixelTypes::GrayscaledPixel* src = theECImage.grayscaled[origin.y() + y * factor + yy] + origin.x() + x * factor;
+        for(int xx = 0; xx < factor; ++xx)
+          sum += src[xx];
+      }
+      *dest = static_cast<unsigned char>(sum >> shift);
+    }
+}
+
+bool PlayersDeeptector::selectROIs(unsigned downScales)
+{
+  const Vector2i size(patchSize(0) << downScales, patchSize(1) << downScales);
+  const int width = static_cast<int>(theECImage.grayscaled.width);
+  const int height = static_cast<int>(theECImage.grayscaled.height);
+  if(!theExpectedObstacleModel.timestamp || theFrameInfo.getTimeSince(theExpectedObstacleModel.timestamp) > maxExpectedObstaclesAge)
+    return false;
+
+  // The expected obstacles are relative to the pose at the time of an earlier image (of either camera).
+  const auto sample = std::min_element(odometryHistory.begin(), odometryHistory.end(), [&](const OdometrySample& a, const OdometrySample& b)
+  {
+    return std::abs(static_cast<int>(a.time - theExpectedObstacleModel.timestamp)) < std::abs(static_cast<int>(b.time - theExpectedObstacleModel.timestamp));
+  });
+  const Pose2f odometryOffset = theOdometryData.inverse() * sample->odometry;
+
+  for(const Obstacle& obstacle : theExpectedObstacleModel.obstacles)
+  {
+    Vector2f pointInImage;
+    if(!Transformation::robotToImage(odometryOffset * obstacle.center, theCameraMatrix, theCameraInfo, pointInImage))
+      continue;
+    const Vector2i point = theImageCoordinateSystem.fromCorrected(pointInImage).cast<int>();
+    if(point.x() < 0 || point.x() >= width || point.y() < 0 || point.y() >= height
+       || theFieldBoundary.getBoundaryY(point.x()) > point.y())
+      continue;
+
+    // The foot point only counts as covered if the upper body also fits into the tile.
+    if(std::any_of(rois.begin(), rois.end(), [&](const Vector2i& roi)
+    {
+      return point.x() >= roi.x() && point.x() < roi.x() + size.x()
+             && point.y() >= roi.y() + size.y() / 2 && point.y() < roi.y() + size.y();
+    }))
+      continue;
+
+    if(rois.size() >= maxROIs)
+      return false;
+    rois.emplace_back(std::max(0, std::min(point.x() - size.x() / 2, width - size.x())),
+                      std::max(0, std::min(point.y() - size.y() * 3 / 4, height - size.y())));
+  }
+  return true;
+}
+
+void PlayersDeeptector::evaluateROIs(const LabelImage& roiLabelImage, unsigned long long roiTime)
+{
+  const unsigned int scale = static_cast<unsigned int>(std::log2(theECImage.grayscaled.width / patchSize(0)) + 0.5);
+  LabelImage fullImage;
+  const unsigned long long start = Time::getCurrentThreadTime();
+  detect(Vector2i::Zero(), scale, fullImage);
+  const unsigned long long fullImageTime = Time::getCurrentThreadTime() - start;
+
+  LabelImage tiles = roiLabelImage;
+  for(LabelImage* labelImage : {&fullImage, &tiles})
+  {
+    labelImage->nonMaximumSuppression(0.3f);
+    labelImage->bigBoxSuppression();
+  }
+
+  unsigned found = 0;
+  for(const LabelImage::Annotation& box : fullImage.annotations)
+    if(std::any_of(tiles.annotations.begin(), tiles.annotations.end(), [&box](const LabelImage::Annotation& roiBox)
+    {
+      return box.getIou(roiBox) >= 0.5f;
+    }))
+      ++found;
+
+  ++roiEvaluation.frames;
+  roiEvaluation.roiTime += roiTime;
+  roiEvaluation.fullImageTime += fullImageTime;
+  roiEvaluation.found += found;
+  roiEvaluation.total += static_cast<unsigned>(fullImage.annotations.size());
+
+  PLOT("module:PlayersDeeptector:roiCost", roiTime);
+  PLOT("module:PlayersDeeptector:fullImageCost", fullImageTime);
+  PLOT("module:PlayersDeeptector:recall", fullImage.annotations.empty() ? 1.f : static_cast<float>(found) / fullImage.annotations.size());
+}
+
+void PlayersDeeptector::boundingBoxes(LabelImage& labelImage, const Vector2i& origin, const Vector2i& size, float distanceFactor)
 {
   const float threshold = -std::log(1.f / objectThres - 1);
-  for(unsigned y = 0; y < convModel.output(0).dims(0); ++y)
-    for(unsigned x = 0; x < convModel.output(0).dims(1); ++x)
+  for(unsigned y = 0; y < convModel->output(0).dims(0); ++y)
+    for(unsigned x = 0; x < convModel->output(0).dims(1); ++x)
       for(unsigned b = 0; b < 4; ++b)
       {
-        const size_t offset = (y * convModel.output(0).dims(1) + x) * 4 * 6;
-        if(convModel.output(0)[offset + b * 6 + 4] > threshold)
+        const size_t offset = (y * convModel->output(0).dims(1) + x) * 4 * 6;
+        if(convModel->output(0)[offset + b * 6 + 4] > threshold)
         {
-          Eigen::Map<Eigen::Matrix<float, 4, 6, Eigen::RowMajor>> pred(convModel.output(0).data() + offset);
+          Eigen::Map<Eigen::Matrix<float, 4, 6, Eigen::RowMajor>> pred(convModel->output(0).data() + offset);
           pred.array() = 1.f / (1.f + (pred * -1).array().exp());
 
-          pred.col(0) = (x + pred.col(0).array()).matrix() / convModel.output(0).dims(1) * theCameraInfo.width;
-          pred.col(1) = (y + pred.col(1).array()).matrix() / convModel.output(0).dims(0) * theCameraInfo.height;
-          pred.col(2).array() *= 10 * anchors.col(0).array() / convModel.output(0).dims(1) * theCameraInfo.width;
-          pred.col(3).array() *= 10 * anchors.col(1).array() / convModel.output(0).dims(0) * theCameraInfo.height;
-          pred.col(5).array() *= 10;
+          pred.col(0) = ((x + pred.col(0).array()) / convModel->output(0).dims(1) * size.x() + origin.x()).matrix();
+          pred.col(1) = ((y + pred.col(1).array()) / convModel->output(0).dims(0) * size.y() + origin.y()).matrix();
+          pred.col(2).array() *= 10 * anchors.col(0).array() / convModel->output(0).dims(1) * size.x();
+          pred.col(3).array() *= 10 * anchors.col(1).array() / convModel->output(0).dims(0) * size.y();
+          pred.col(5).array() *= 10 * distanceFactor;
 
           LabelImage::Annotation box;
           box.upperLeft = Vector2f(pred(b, 0) - pred(b, 2) / 2, pred(b, 1) - pred(b, 3) / 2);
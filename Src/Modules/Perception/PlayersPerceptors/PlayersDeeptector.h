@@ -12,7 +12,9 @@
 #include "Representations/Infrastructure/CameraInfo.h"
 #include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Modeling/LabelImage.h"
+#include "Representations/Modeling/ObstacleModel.h"
 #include "Representations/Modeling/Odometer.h"
+#include "Representations/MotionControl/OdometryData.h"
 #include "Representations/Perception/ImagePreprocessing/BodyContour.h"
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Perception/ImagePreprocessing/ECImage.h"
@@ -25,6 +27,7 @@
 #include "Tools/Math/Eigen.h"
 #include "Tools/ImageProcessing/InImageSizeCalculations.h"
 #include "Tools/Module/Module.h"
+#include "Tools/RingBuffer.h"
 #include <CompiledNN/CompiledNN.h>
 
 MODULE(PlayersDeeptector,
@@ -40,9 +43,11 @@ MODULE(PlayersDeeptector,
   REQUIRES(JerseyClassifier),
   REQUIRES(ObstaclesFieldPercept),
   REQUIRES(Odometer),
+  REQUIRES(OdometryData),
   REQUIRES(OtherObstaclesPerceptorData),
   PROVIDES(ObstaclesFieldPercept),
   PROVIDES(ObstaclesImagePercept),
+  USES(ExpectedObstacleModel),
   USES(ObstaclesPerceptorData),
   PROVIDES(ObstaclesPerceptorData),
   DEFINES_PARAMETERS(
@@ -61,6 +66,11 @@ MODULE(PlayersDeeptector,
     (bool)(true) trimObstacles, /** Whether the width of obstacles should be corrected. */
     (float)(0.32f) minBeforeAfterTrimRatio,
     (bool)(true) mergeLowerObstacles, /** Whether overlapping obstacles should be merged (only for the lower camera). */
+    (bool)(false) useROIs, /** Whether the upper image is only searched in tiles around the obstacles expected between full image passes. */
+    (unsigned int)(5) fullImageInterval, /** Every n-th upper image is searched completely if ROIs are used. */
+    (unsigned int)(1) roiZoom, /** How many times the resolution of a tile is doubled compared to a full image pass. */
+    (unsigned int)(1) maxROIs, /** If more tiles would be required, the full image is searched instead. A tile costs as much as the full image. */
+    (int)(200) maxExpectedObstaclesAge, /** If the expected obstacles are older (in ms), the full image is searched instead. */
   }),
 });
 
@@ -71,11 +81,30 @@ public:
 
 private:
   Vector2i patchSize;
-  std::unique_ptr<NeuralNetwork::Model> model;
-  NeuralNetwork::CompiledNN convModel;
+  NeuralNetwork::CompiledNN* convModel = nullptr; /**< The network for the upper camera, owned by the cache of this thread. */
   Image<PixelTypes::GrayscaledPixel> thumbnail;
   Matrix4x2f anchors;
   std::vector<ObstaclesImagePercept::Obstacle> obstaclesUpper, obstaclesLower;
+  std::vector<Vector2i> rois; /**< The upper left corners of the tiles searched in the current image. */
+  unsigned frameCounter = 0; /**< Counts the upper images to determine when a full image pass is due. */
+
+  /** The odometry at the time of an upper image. */
+  struct OdometrySample
+  {
+    unsigned time; /**< The time of the image. */
+    Pose2f odometry; /**< The odometry at that time. */
+  };
+  RingBuffer<OdometrySample, 8> odometryHistory; /**< The odometry of the most recent upper images. */
+
+  /** Accumulated statistics comparing searching tiles with searching the full image. */
+  struct ROIEvaluation
+  {
+    unsigned frames = 0; /**< The number of images evaluated. */
+    unsigned long long roiTime = 0; /**< The accumulated time of searching the tiles in µs. */
+    unsigned long long fullImageTime = 0; /**< The accumulated time of searching the full images in µs. */
+    unsigned found = 0; /**< The number of full image detections that were also found in the tiles. */
+    unsigned total = 0; /**< The number of full image detections. */
+  } roiEvaluation;
 
   /** This enumeration lists the possible classes of a image region. */
   ENUM(Classification,
@@ -118,11 +147,56 @@ private:
    */
   void update(ObstaclesPerceptorData& theObstaclesPerceptorData) override;
 
+  /**
+   * Searches the upper image for players, either completely or only in the
+   * tiles around obstacles expected.
+   * @param labelImage The bounding boxes found are added to this image.
+   */
+  void detectUpper(LabelImage& labelImage);
+
+  /**
+   * Applies the network to a region of the upper image.
+   * @param origin The upper left corner of the region in the image.
+   * @param downScales How often the region is halved in size to fit into the network input.
+   *                   If it is the number required for the whole image, the whole image is searched.
+   * @param labelImage The bounding boxes found are added to this image.
+   */
+  void detect(const Vector2i& origin, unsigned downScales, LabelImage& labelImage);
+
+  /**
+   * Copies a tile from the grayscale image into the network input while shrinking it.
+   * @param origin The upper left corner of the tile in the image.
+   * @param downScales How often the tile is halved in size.
+   */
+  void extractTile(const Vector2i& origin, unsigned downScales);
+
+  /**
+   * Determines the tiles that contain the foot points of the obstacles expected
+   * below the field boundary. The obstacles are moved by the odometry since the
+   * image they are relative to.
+   * @param downScales How often a tile is halved in size to fit into the network input.
+   * @return Are the tiles determined sufficient? Otherwise, e.g. if the expected
+   *         obstacles are missing or too old, the full image must be searched.
+   */
+  bool selectROIs(unsigned downScales);
+
   /**
    * This method gets the bounding boxes from the network output.
-   * @param the bounding boxes
+   * @param labelImage The bounding boxes found are added to this image.
+   * @param origin The upper left corner of the image region the network was applied to.
+   * @param size The size of the image region the network was applied to.
+   * @param distanceFactor The factor the region was enlarged compared to the full image pass.
+   */
+  void boundingBoxes(LabelImage& labelImage, const Vector2i& origin, const Vector2i& size, float distanceFactor);
+
+  /**
+   * Searches the full image in addition to the tiles and compares the results.
+   * The accumulated cost and recall can be printed with the debug request
+   * module:PlayersDeeptector:roiReport.
+   * @param roiLabelImage The bounding boxes found in the tiles.
+   * @param roiTime The time it took to search the tiles in µs.
    */
-  void boundingBoxes(LabelImage& labelImage);
+  void evaluateROIs(const LabelImage& roiLabelImage, unsigned long long roiTime);
 
   /**
    * Corrects the left and right and optionally the bottom boundary of an obstacle in the image.
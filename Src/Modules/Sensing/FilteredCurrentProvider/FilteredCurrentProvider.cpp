@@ -6,13 +6,13 @@
 
 #include "FilteredCurrentProvider.h"
 #include "Tools/Settings.h"
+#include <algorithm>
 #include <cmath>
 
 MAKE_MODULE(FilteredCurrentProvider, sensing);
 
 FilteredCurrentProvider::FilteredCurrentProvider()
 {
-  currents.resize(Joints::numOfJoints);
   flags.resize(Joints::numOfJoints);
   fill(flags.begin(), flags.end(), 0);
   checkTimestamp = 0;
@@ -31,12 +31,15 @@ void FilteredCurrentProvider::update(FilteredCurrent& theFilteredCurrent)
   DECLARE_PLOT("module:FilteredCurrentProvider:rAP");
 
   // Filter the currents
+  decltype(currents)::Frame frame;
   for(int i = 0; i < Joints::numOfJoints; i++)
   {
     short value = theJointSensorData.currents[i];
-    currents[i].push_front(static_cast<int>(value == SensorData::off ? 1.f : value));
-    theFilteredCurrent.currents[i] = currents[i].average();
+    frame[i] = static_cast<int>(value == SensorData::off ? 1.f : value);
   }
+  currents.push_front(frame);
+  const decltype(currents)::Frame averages = currents.averages();
+  std::copy(averages.begin(), averages.end(), theFilteredCurrent.currents.begin());
   theFilteredCurrent.isValid = true;
   PLOT("module:FilteredCurrentProvider:lHYP", theFilteredCurrent.currents[Joints::lHipYawPitch]);
   PLOT("module:FilteredCurrentProvider:lHP", theFilteredCurrent.currents[Joints::lHipPitch]);
@@ -63,7 +66,7 @@ void FilteredCurrentProvider::checkMotorMalfunction(FilteredCurrent& theFiltered
     //But also for a faster detection -> TODO for future
     //Right now it takes like 5 secs before a motormalfunction is detected. Also based on the logs it has no false-positives (yet), but some false-negatives.
     checkTimestamp = theFrameInfo.time;
-    for(size_t i = 0; i < currents.size(); i++)
+    for(size_t i = 0; i < flags.size(); i++)
     {
       // Decide which threshold to use
       Angle jointDif = theGroundContactState.contact ? minJointDifNormalJoints : minJointDifNormalJointsNoGroundConntact;
@@ -76,7 +79,7 @@ void FilteredCurrentProvider::checkMotorMalfunction(FilteredCurrent& theFiltered
         jointDif = minJointDifArms;
       }
       // If current is 0, the stiffness high enough and the jointRequest and jointAngle difference is high enough, increase the counter
-      if(currents[i].average() == 0 && theJointRequest.stiffnessData.stiffnesses[i] >= stiffness && std::abs(theJointRequest.angles[i] - theJointSensorData.angles[i]) >= jointDif)
+      if(currents.average(i) == 0 && theJointRequest.stiffnessData.stiffnesses[i] >= stiffness && std::abs(theJointRequest.angles[i] - theJointSensorData.angles[i]) >= jointDif)
         flags[i] += 1;
       else
         flags[i] = std::max(flags[i] - 1, 0); // subtract by 1 is better than setting to 0, in case we did a check at a bad time, where the deactivated joint had a correct position
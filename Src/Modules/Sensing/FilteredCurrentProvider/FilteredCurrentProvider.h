@@ -17,7 +17,7 @@
 #include "Representations/Sensing/GroundContactState.h"
 #include "Tools/Debugging/Annotation.h"
 #include "Tools/Module/Module.h"
-#include "Tools/RingBufferWithSum.h"
+#include "Tools/RingBufferBank.h"
 #include "Tools/Debugging/DebugDrawings.h"
 #include "Tools/Streams/EnumIndexedArray.h"
 
@@ -52,7 +52,7 @@ public:
   FilteredCurrentProvider();
 private:
 
-  std::vector<RingBufferWithSum<int, 20>> currents; /**< Ring buffer for the currents for every joint. */
+  RingBufferBank<int, Joints::numOfJoints, 20> currents; /**< Ring buffers for the currents of all joints. */
   unsigned int checkTimestamp; /**< Last time a motor malfunction was checked. */
   unsigned int soundTimestamp; /**< Last time a sound was played for a motor malfunction. */
   unsigned int annotationTimestamp; /**< Last time a annotation was made for a motor malfunction. */
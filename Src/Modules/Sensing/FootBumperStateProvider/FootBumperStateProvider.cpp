@@ -26,49 +26,36 @@ void FootBumperStateProvider::update(FootBumperState& footBumperState)
   const bool contactLeftFoot = leftFootLeft || leftFootRight;
   const bool contactRightFoot = rightFootLeft || rightFootRight;
   // Update statistics
+  decltype(contactBuffers)::Frame contacts = {}; // No contacts unless detected below.
   if(!ignoreByState)
   {
     if(contactLeftFoot)
     {
-      contactBufferLeftLeft.push_front(leftFootLeft ? 1 : 0);
-      contactBufferLeftRight.push_front(leftFootRight ? 1 : 0);
-      contactBufferLeft.push_front(1);
+      contacts[bufferLeftLeft] = leftFootLeft ? 1 : 0;
+      contacts[bufferLeftRight] = leftFootRight ? 1 : 0;
+      contacts[bufferLeft] = 1;
       contactDurationLeft++;
     }
     else
-    {
-      contactBufferLeftLeft.push_front(0);
-      contactBufferLeftRight.push_front(0);
-      contactBufferLeft.push_front(0);
       contactDurationLeft = 0;
-    }
     if(contactRightFoot)
     {
-      contactBufferRightLeft.push_front(rightFootLeft ? 1 : 0);
-      contactBufferRightRight.push_front(rightFootRight ? 1 : 0);
-      contactBufferRight.push_front(1);
+      contacts[bufferRightLeft] = rightFootLeft ? 1 : 0;
+      contacts[bufferRightRight] = rightFootRight ? 1 : 0;
+      contacts[bufferRight] = 1;
       contactDurationRight++;
     }
     else
-    {
-      contactBufferRightLeft.push_front(0);
-      contactBufferRightRight.push_front(0);
-      contactBufferRight.push_front(0);
       contactDurationRight = 0;
-    }
   }
   else
   {
     //In the current robot state, we ignore all bumper signals
-    contactBufferLeftLeft.push_front(0);
-    contactBufferLeftRight.push_front(0);
-    contactBufferLeft.push_front(0);
-    contactBufferRightLeft.push_front(0);
-    contactBufferRightRight.push_front(0);
-    contactBufferRight.push_front(0);
     contactDurationLeft = 0;
     contactDurationRight = 0;
   }
+  contactBuffers.push_front(contacts);
+
   // Generate model
   int thresholdContacts = static_cast<int>(1.f / Constants::motionCycleTime / contactThreshold);
   if((theMotionInfo.executedPhase == MotionPhase::stand || theMotionInfo.executedPhase == MotionPhase::walk) &&
@@ -76,7 +63,7 @@ void FootBumperStateProvider::update(FootBumperState& footBumperState)
      (theFallDownState.state == FallDownState::upright))
   {
     // One contact buffer must exceed the threshold and both bumper sensors of one foot must detected at least 1 contact. Otherwise no contact is detected
-    if(contactBufferLeft.sum() > thresholdContacts && contactBufferLeftLeft.sum() > 0 && contactBufferLeftRight.sum() > 0)
+    if(contactBuffers.sum(bufferLeft) > thresholdContacts && contactBuffers.sum(bufferLeftLeft) > 0 && contactBuffers.sum(bufferLeftRight) > 0)
     {
       footBumperState.status[Legs::left].contact = true;
       footBumperState.status[Legs::left].contactDuration = contactDurationLeft;
@@ -88,7 +75,7 @@ void FootBumperStateProvider::update(FootBumperState& footBumperState)
       footBumperState.status[Legs::left].contact = false;
       footBumperState.status[Legs::left].contactDuration = 0;
     }
-    if(contactBufferRight.sum() > thresholdContacts && contactBufferRightLeft.sum() > 0 && contactBufferRightRight.sum() > 0)
+    if(contactBuffers.sum(bufferRight) > thresholdContacts && contactBuffers.sum(bufferRightLeft) > 0 && contactBuffers.sum(bufferRightRight) > 0)
     {
       footBumperState.status[Legs::right].contact = true;
       footBumperState.status[Legs::right].contactDuration = contactDurationRight;
@@ -110,9 +97,9 @@ void FootBumperStateProvider::update(FootBumperState& footBumperState)
   }
 
   // Debugging stuff:
-  PLOT("module:FootBumperStateProvider:sumLeft", contactBufferLeft.sum());
+  PLOT("module:FootBumperStateProvider:sumLeft", contactBuffers.sum(bufferLeft));
   PLOT("module:FootBumperStateProvider:durationLeft", contactDurationLeft);
-  PLOT("module:FootBumperStateProvider:sumRight", contactBufferRight.sum());
+  PLOT("module:FootBumperStateProvider:sumRight", contactBuffers.sum(bufferRight));
   PLOT("module:FootBumperStateProvider:durationRight", contactDurationRight);
   PLOT("module:FootBumperStateProvider:contactLeft", footBumperState.status[Legs::left].contact ? 10 : 0);
   PLOT("module:FootBumperStateProvider:contactRight", footBumperState.status[Legs::right].contact ? 10 : 0);
@@ -20,7 +20,7 @@
 #include "Representations/Sensing/TorsoMatrix.h"
 #include "Tools/Math/Constants.h"
 #include "Tools/Module/Module.h"
-#include "Tools/RingBufferWithSum.h"
+#include "Tools/RingBufferBank.h"
 
 /** Number of contacts to buffer. 83 complies to 1 second */
 #define BUFFER_SIZE static_cast<int>(1.f / Constants::motionCycleTime)
@@ -53,18 +53,23 @@ MODULE(FootBumperStateProvider,
  */
 class FootBumperStateProvider : public FootBumperStateProviderBase
 {
+  /** The contacts that are buffered. */
+  ENUM(ContactBuffer,
+  {,
+    bufferLeft, /**< Any contact of the left foot. */
+    bufferRight, /**< Any contact of the right foot. */
+    bufferLeftLeft, /**< Contact of the left bumper of the left foot. */
+    bufferLeftRight, /**< Contact of the right bumper of the left foot. */
+    bufferRightLeft, /**< Contact of the left bumper of the right foot. */
+    bufferRightRight, /**< Contact of the right bumper of the right foot. */
+  });
+
   /**
    * Buffers the contacts over the last frames.
-   * Each frame one value is added to this buffer.
+   * Each frame one value is added to each buffer.
    * A 1 if there was a foot contact in the frame, 0 otherwise.
    */
-  RingBufferWithSum<int, BUFFER_SIZE> contactBufferLeft;
-  RingBufferWithSum<int, BUFFER_SIZE> contactBufferRight;
-
-  RingBufferWithSum<int, BUFFER_SIZE> contactBufferLeftLeft;
-  RingBufferWithSum<int, BUFFER_SIZE> contactBufferLeftRight;
-  RingBufferWithSum<int, BUFFER_SIZE> contactBufferRightLeft;
-  RingBufferWithSum<int, BUFFER_SIZE> contactBufferRightRight;
+  RingBufferBank<int, numOfContactBuffers, BUFFER_SIZE> contactBuffers;
 
   int contactDurationLeft = 0; /**< the duration of the last contact. Will be reset to 0 if contact is lost */
   int contactDurationRight = 0; /**< the duration of the last contact. Will be reset to 0 if contact is lost */
@@ -10,32 +10,25 @@ MAKE_MODULE(GyroStateProvider, infrastructure);
 
 GyroStateProvider::GyroStateProvider()
 {
-  gyroValuesX.clear();
-  gyroValuesY.clear();
-  gyroValuesZ.clear();
   samplingCounter = 0;
 }
 
 void GyroStateProvider::update(GyroState& gyroState)
 {
   //Sampling
-  gyroValuesX.push_front(theInertialData.gyro.x());
-  gyroValuesY.push_front(theInertialData.gyro.y());
-  gyroValuesZ.push_front(theInertialData.gyro.z());
+  gyroValues.push_front({theInertialData.gyro.x(), theInertialData.gyro.y(), theInertialData.gyro.z()});
   samplingCounter += 1;
   //We did enough sampling
-  if(samplingCounter >= static_cast<int>(gyroValuesX.capacity()))
+  if(samplingCounter >= static_cast<int>(gyroValues.capacity()))
   {
     samplingCounter = 0;
-    //calc for x gyro
-    gyroState.mean.x() = gyroValuesX.average();
-    gyroState.deviation.x() = std::abs(gyroValuesX.maximum() - gyroValuesX.minimum());
-    //calc for y gyro
-    gyroState.mean.y() = gyroValuesY.average();
-    gyroState.deviation.y() = std::abs(gyroValuesY.maximum() - gyroValuesY.minimum());
-    //calc for z gyro
-    gyroState.mean.z() = gyroValuesZ.average();
-    gyroState.deviation.z() = std::abs(gyroValuesZ.maximum() - gyroValuesZ.minimum());
+    const decltype(gyroValues)::Frame minima = gyroValues.minima();
+    const decltype(gyroValues)::Frame maxima = gyroValues.maxima();
+    for(int i = 0; i < 3; ++i)
+    {
+      gyroState.mean(i) = gyroValues.average(i);
+      gyroState.deviation(i) = std::abs(maxima[i] - minima[i]);
+    }
     gyroState.timestamp = theFrameInfo.time;
   }
 }
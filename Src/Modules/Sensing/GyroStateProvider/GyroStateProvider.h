@@ -10,7 +10,7 @@
 #include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Sensing/InertialData.h"
 #include "Tools/Module/Module.h"
-#include "Tools/RingBufferWithSum.h"
+#include "Tools/RingBufferBank.h"
 
 MODULE(GyroStateProvider,
 {,
@@ -24,10 +24,8 @@ class GyroStateProvider : public GyroStateProviderBase
 public:
   GyroStateProvider();
 private:
-  //RingBuffer for the last 27 gyro values. So many values can be sampled in 333ms with the current motion time of 0.012ms.
-  RingBufferWithSum<Angle, 27> gyroValuesX;
-  RingBufferWithSum<Angle, 27> gyroValuesY;
-  RingBufferWithSum<Angle, 27> gyroValuesZ;
+  //RingBuffers for the last 27 gyro values around the x, y, and z axes. So many values can be sampled in 333ms with the current motion time of 0.012ms.
+  RingBufferBank<float, 3, 27> gyroValues;
   int samplingCounter;
 
   void update(GyroState& gyroOffset) override;
@@ -1,17 +1,134 @@
 #include "Platform/Memory.h"
 
+#include <cstdio>
 #include <cstdlib>
+#include <new>
 
-void* Memory::alignedMalloc(size_t size, size_t alignment)
+// Both are constant-initialized, so that they can be accessed during any allocation.
+static thread_local Memory::AllocationCounter* allocationCounter = nullptr; /**< The counter of the current thread or nullptr. */
+static thread_local const char* allocationsForbiddenIn = nullptr; /**< What forbids allocations in the current thread or nullptr. */
+
+/**
+ * Counts a heap allocation of the calling thread and aborts if allocations are forbidden.
+ * @param size The number of bytes allocated.
+ */
+static void track(size_t size)
+{
+  if(allocationCounter)
+  {
+    ++allocationCounter->count;
+    allocationCounter->bytes += size;
+  }
+  if(allocationsForbiddenIn)
+  {
+    // Reporting must not allocate itself.
+    std::fprintf(stderr, "Heap allocation of %zu bytes in %s\n", size, allocationsForbiddenIn);
+    std::abort();
+  }
+}
+
+/**
+ * Allocates memory with a certain alignment.
+ * @param size The number of bytes to allocate.
+ * @param alignment The alignment. Must be a power of 2.
+ * @return The memory or nullptr if the allocation failed.
+ */
+static void* allocate(size_t size, size_t alignment)
 {
   void* ptr;
-  if(!posix_memalign(&ptr, alignment, size))
+  if(!posix_memalign(&ptr, alignment < sizeof(void*) ? sizeof(void*) : alignment, size ? size : 1))
     return ptr;
   else
     return nullptr;
 }
 
+void* Memory::alignedMalloc(size_t size, size_t alignment)
+{
+  track(size);
+  return allocate(size, alignment);
+}
+
 void Memory::alignedFree(void* ptr)
 {
   free(ptr);
 }
+
+Memory::AllocationCounter* Memory::setAllocationCounter(AllocationCounter* counter)
+{
+  AllocationCounter* previous = allocationCounter;
+  allocationCounter = counter;
+  return previous;
+}
+
+const char* Memory::forbidAllocations(const char* context)
+{
+  const char* previous = allocationsForbiddenIn;
+  allocationsForbiddenIn = context;
+  return previous;
+}
+
+// The replaced global allocation functions track all allocations through new and delete,
+// which includes those of the containers of the standard library.
+
+void* operator new(std::size_t size)
+{
+  track(size);
+  void* ptr = std::malloc(size ? size : 1);
+  if(!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  track(size);
+  return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return operator new(size, std::nothrow);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  track(size);
+  void* ptr = allocate(size, static_cast<size_t>(alignment));
+  if(!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  track(size);
+  return allocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return operator new(size, alignment, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept {std::free(ptr);}
+void operator delete[](void* ptr) noexcept {std::free(ptr);}
+void operator delete(void* ptr, std::size_t) noexcept {std::free(ptr);}
+void operator delete[](void* ptr, std::size_t) noexcept {std::free(ptr);}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {std::free(ptr);}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {std::free(ptr);}
+void operator delete(void* ptr, std::align_val_t) noexcept {std::free(ptr);}
+void operator delete[](void* ptr, std::align_val_t) noexcept {std::free(ptr);}
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {std::free(ptr);}
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {std::free(ptr);}
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {std::free(ptr);}
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {std::free(ptr);}
@@ -9,4 +9,32 @@ namespace Memory
 
   /** Free aligned memory. */
   void alignedFree(void* ptr);
+
+  /** The number and the overall size of heap allocations. */
+  struct AllocationCounter
+  {
+    unsigned count = 0; /**< The number of allocations. */
+    size_t bytes = 0; /**< The number of bytes allocated. */
+  };
+
+  /**
+   * Sets the counter all heap allocations of the calling thread are added to.
+   * Allocations are only tracked on platforms that replace the global
+   * operator new (Linux, macOS, and the NAO). In a dynamically loaded library,
+   * only allocations of its own code are tracked and only if it binds calls of
+   * operator new to its own definitions (see Make/CMake/SimulatedNao.cmake).
+   * Allocations inside precompiled libraries, e.g. the C++ runtime, are never
+   * tracked.
+   * @param counter The counter. nullptr stops counting.
+   * @return The counter that was set before.
+   */
+  AllocationCounter* setAllocationCounter(AllocationCounter* counter);
+
+  /**
+   * Lets each heap allocation of the calling thread abort the program.
+   * @param context The name of what is executed, which is reported if an
+   *                allocation happens. nullptr allows allocations again.
+   * @return The context that was set before.
+   */
+  const char* forbidAllocations(const char* context);
 }
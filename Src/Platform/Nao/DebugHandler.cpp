@@ -8,18 +8,24 @@
 
 #include "DebugHandler.h"
 #include "Platform/BHAssert.h"
+#include "Platform/Time.h"
+#include "Tools/Debugging/DebugImages.h"
 #include "Tools/Streams/OutStreams.h"
 #include "Tools/Streams/InStreams.h"
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
 DebugHandler::DebugHandler(MessageQueue& in, MessageQueue& out, int maxPacketSendSize, int maxPacketReceiveSize) :
   TcpConnection(0, 9999, TcpConnection::receiver, maxPacketSendSize, maxPacketReceiveSize),
   in(in),
-  out(out)
+  out(out),
+  throughput(std::numeric_limits<float>::infinity())
 {}
 
 void DebugHandler::communicate(bool send)
 {
+  const bool waited = sendData != nullptr;
   if(send && !sendData && !out.isEmpty())
   {
     sendSize = out.getStreamedSize();
@@ -35,6 +41,7 @@ void DebugHandler::communicate(bool send)
   ASSERT(sendSize <= std::numeric_limits<int>::max());
   if(sendAndReceive(sendData, static_cast<int>(sendSize), receivedData, receivedSize) && sendSize)
   {
+    updateThroughput(waited);
     delete [] sendData;
     sendData = nullptr;
     sendSize = 0;
@@ -47,3 +54,23 @@ void DebugHandler::communicate(bool send)
     delete [] receivedData;
   }
 }
+
+void DebugHandler::updateThroughput(bool waited)
+{
+  const unsigned now = Time::getCurrentSystemTime();
+  if(waited && lastSendTime)
+  {
+    // The packet had to wait until the previous one was acknowledged, i.e. the connection is the bottleneck.
+    const float measured = static_cast<float>(lastSendSize) * 1000.f / static_cast<float>(std::max(1u, now - lastSendTime));
+    throughput = std::isinf(throughput) ? measured : (throughput + measured) / 2.f;
+  }
+  else if(!std::isinf(throughput))
+  {
+    // The connection keeps up. Slowly raise the estimate to eventually try sending uncompressed images again.
+    throughput *= 1.1f;
+    if(throughput > 2.f * DebugImage::compressionThreshold)
+      throughput = std::numeric_limits<float>::infinity();
+  }
+  lastSendTime = now;
+  lastSendSize = sendSize;
+}
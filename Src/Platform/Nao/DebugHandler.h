@@ -19,6 +19,9 @@ private:
 
   unsigned char* sendData = nullptr; /**< The data to send next. */
   size_t sendSize = 0; /**< The size of the data to send next. */
+  unsigned lastSendTime = 0; /**< When the previous packet was sent. */
+  size_t lastSendSize = 0; /**< The size of the previous packet. */
+  float throughput; /**< The estimated throughput of the connection in bytes per second. */
 
 public:
   /**
@@ -42,4 +45,17 @@ public:
    * @param send Send outgoing queue?
    */
   void communicate(bool send);
+
+  /**
+   * Returns the estimated throughput of the connection in bytes per second.
+   * It is infinite if the connection is not the bottleneck or not known.
+   */
+  float getThroughput() const {return throughput;}
+
+private:
+  /**
+   * Updates the estimated throughput of the connection after a packet was sent.
+   * @param waited Did the packet have to wait for the previous one to be acknowledged?
+   */
+  void updateThroughput(bool waited);
 };
@@ -11,3 +11,22 @@ void Memory::alignedFree(void* ptr)
 {
   _aligned_free(ptr);
 }
+
+// Allocations are not tracked on Windows, because replacing the global operator new
+// would only affect the DLL or executable it is linked into.
+static thread_local Memory::AllocationCounter* allocationCounter = nullptr;
+static thread_local const char* allocationsForbiddenIn = nullptr;
+
+Memory::AllocationCounter* Memory::setAllocationCounter(AllocationCounter* counter)
+{
+  AllocationCounter* previous = allocationCounter;
+  allocationCounter = counter;
+  return previous;
+}
+
+const char* Memory::forbidAllocations(const char* context)
+{
+  const char* previous = allocationsForbiddenIn;
+  allocationsForbiddenIn = context;
+  return previous;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file ActivationGraph.cpp
+ *
+ * Implementation of the methods that rebuild the activation graph in each
+ * frame while reusing its memory.
+ */
+
+#include "ActivationGraph.h"
+
+void ActivationGraph::clear()
+{
+  for(auto node = graph.rbegin(); node != graph.rend(); ++node)
+  {
+    for(std::string& parameter : node->parameters)
+      recycled.strings.emplace_back(std::move(parameter));
+    node->parameters.clear();
+    recycled.nodes.emplace_back(std::move(*node));
+  }
+  graph.clear();
+  currentDepth = 0;
+}
+
+ActivationGraph::Node& ActivationGraph::addNode(const char* option, int depth, const char* state, int optionTime, int stateTime)
+{
+  if(recycled.nodes.empty())
+    graph.emplace_back();
+  else
+  {
+    graph.emplace_back(std::move(recycled.nodes.back()));
+    recycled.nodes.pop_back();
+  }
+
+  // Assigning C strings reuses the capacity of the strings.
+  Node& node = graph.back();
+  node.option = option;
+  node.depth = depth;
+  node.state = state ? state : "";
+  node.optionTime = optionTime;
+  node.stateTime = stateTime;
+  return node;
+}
+
+void ActivationGraph::addParameter(Node& node, const Streamable& value)
+{
+  recycled.stream.clear();
+  recycled.stream << value;
+  addParameter(node, recycled.stream.data(), recycled.stream.size());
+}
+
+void ActivationGraph::addParameter(Node& node, const char* text, size_t length)
+{
+  if(recycled.strings.empty())
+    node.parameters.emplace_back(text, length);
+  else
+  {
+    node.parameters.emplace_back(std::move(recycled.strings.back()));
+    recycled.strings.pop_back();
+    node.parameters.back().assign(text, length);
+  }
+}
@@ -10,6 +10,7 @@
 
 #include "Platform/BHAssert.h"
 #include "Tools/Streams/AutoStreamable.h"
+#include "Tools/Streams/OutStreams.h"
 
 STREAMABLE(ActivationGraph,
 {
@@ -35,7 +36,58 @@ STREAMABLE(ActivationGraph,
   ActivationGraph()
   {
     graph.reserve(100);
-  },
+  }
+
+  /**
+   * Removes all nodes. Their memory is kept and reused when nodes are added
+   * in the next frame. Since nodes are reused in the same order, the same
+   * options usually receive the same nodes again and no memory has to be
+   * allocated.
+   */
+  void clear();
+
+  /**
+   * Adds a node to the graph, reusing a removed one if possible.
+   * @param option The name of the option.
+   * @param depth The depth of the option in the graph.
+   * @param state The name of the current state or nullptr.
+   * @param optionTime How long has the option been active?
+   * @param stateTime How long has the state been active?
+   * @return The node added. Only valid until the next node is added.
+   */
+  Node& addNode(const char* option, int depth, const char* state, int optionTime, int stateTime);
+
+  /**
+   * Adds the description of a parameter to a node.
+   * @param node The node.
+   * @param value The current value of the parameter.
+   */
+  void addParameter(Node& node, const Streamable& value);
+
+  /**
+   * Adds a text as parameter to a node.
+   * @param node The node.
+   * @param text The text. It is shown as is.
+   * @param length The length of the text.
+   */
+  void addParameter(Node& node, const char* text, size_t length);
+
+private:
+  /** Memory of removed nodes and parameters. It is not copied with the graph. */
+  struct Recycled
+  {
+    std::vector<Node> nodes; /**< Removed nodes in reverse order. */
+    std::vector<std::string> strings; /**< Removed parameter descriptions. */
+    OutMapMemory stream{true}; /**< The stream parameters are formatted with (in a single line). */
+
+    Recycled() = default;
+    Recycled(const Recycled&) {}
+    Recycled& operator=(const Recycled&) { return *this; }
+  };
+
+  Recycled recycled;
+
+public:,
 
   (std::vector<Node>) graph,
 });
@@ -8,7 +8,10 @@
 #include "Tools/ImageProcessing/SIMD.h"
 #include "Platform/BHAssert.h"
 #include "Platform/Memory.h"
+#include "Tools/WorkerPool.h"
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <jpeglib.h>
 
 static boolean onDestEmpty(j_compress_ptr)
@@ -34,13 +37,73 @@ JPEGImage::JPEGImage(const CameraImage& src)
   *this = src;
 }
 
+JPEGImage::JPEGImage(const JPEGImage& other)
+{
+  *this = other;
+}
+
+JPEGImage::~JPEGImage()
+{
+  waitUntilCompressed();
+}
+
+JPEGImage& JPEGImage::operator=(const JPEGImage& other)
+{
+  if(this != &other)
+  {
+    waitUntilCompressed();
+    other.waitUntilCompressed();
+    size = other.size;
+    width = other.width;
+    height = other.height;
+    allocator.assign(other.allocator.begin(), other.allocator.begin() + other.size);
+    timestamp = other.timestamp;
+  }
+  return *this;
+}
+
 JPEGImage& JPEGImage::operator=(const CameraImage& src)
 {
-  allocator.resize(src.width * src.height * sizeof(CameraImage::PixelType));
+  compressAsync(src);
+  waitUntilCompressed();
+  return *this;
+}
+
+void JPEGImage::compressAsync(const CameraImage& src, unsigned numOfStripes)
+{
+  waitUntilCompressed();
+
   width = src.width;
   height = src.height / 2;
   timestamp = src.timestamp;
+  source.setResolution(src.width, src.height);
+  std::memcpy(source[0], src[0], src.width * src.height * sizeof(CameraImage::PixelType));
+
+  // Stripes consist of multiples of 16 rows to avoid partial MCUs at their borders.
+  if(!numOfStripes)
+    numOfStripes = static_cast<unsigned>(WorkerPool::getShared().getNumOfWorkers());
+  const unsigned rowsPerStripe = std::max((src.height / numOfStripes + 15) & ~15u, 16u);
+  numOfStripes = (src.height + rowsPerStripe - 1) / rowsPerStripe;
+
+  // Each stripe gets a region of the size of the uncompressed rows plus space for the JPEG headers.
+  const size_t bytesPerRow = src.width * sizeof(CameraImage::PixelType);
+  allocator.resize(src.height * bytesPerRow + numOfStripes * 1024);
+  stripes.resize(numOfStripes);
+  size_t offset = 0;
+  for(unsigned i = 0; i < numOfStripes; ++i)
+  {
+    const unsigned firstRow = i * rowsPerStripe;
+    const unsigned numOfRows = std::min(rowsPerStripe, src.height - firstRow);
+    Stripe& stripe = stripes[i];
+    stripe.offset = offset;
+    stripe.capacity = numOfRows * bytesPerRow + 1024;
+    offset += stripe.capacity;
+    stripe.done = WorkerPool::getShared().run([this, &stripe, firstRow, numOfRows] { compress(stripe, firstRow, numOfRows); });
+  }
+}
 
+void JPEGImage::compress(Stripe& stripe, unsigned firstRow, unsigned numOfRows)
+{
   jpeg_compress_struct cInfo;
   jpeg_error_mgr jem;
   cInfo.err = jpeg_std_error(&jem);
@@ -52,11 +115,11 @@ JPEGImage& JPEGImage::operator=(const CameraImage& src)
   cInfo.dest->init_destination = onDestIgnore;
   cInfo.dest->empty_output_buffer = onDestEmpty;
   cInfo.dest->term_destination = onDestIgnore;
-  cInfo.dest->next_output_byte = static_cast<JOCTET*>(allocator.data());
-  cInfo.dest->free_in_buffer = allocator.size();
+  cInfo.dest->next_output_byte = static_cast<JOCTET*>(allocator.data() + stripe.offset);
+  cInfo.dest->free_in_buffer = stripe.capacity;
 
   cInfo.image_width = width;
-  cInfo.image_height = height * 2;
+  cInfo.image_height = numOfRows;
   cInfo.input_components = 4;
   cInfo.in_color_space = JCS_CMYK;
   cInfo.jpeg_color_space = JCS_CMYK;
@@ -68,62 +131,94 @@ JPEGImage& JPEGImage::operator=(const CameraImage& src)
 
   while(cInfo.next_scanline < cInfo.image_height)
   {
-    JSAMPROW rowPointer = const_cast<JSAMPROW>(reinterpret_cast<const unsigned char*>(src[0] + width * cInfo.next_scanline));
+    JSAMPROW rowPointer = reinterpret_cast<unsigned char*>(source[firstRow + cInfo.next_scanline]);
     jpeg_write_scanlines(&cInfo, &rowPointer, 1);
   }
 
   jpeg_finish_compress(&cInfo);
-  size = unsigned((char unsigned*)cInfo.dest->next_output_byte - allocator.data());
+  stripe.size = cInfo.dest->next_output_byte - (allocator.data() + stripe.offset);
   jpeg_destroy_compress(&cInfo);
+}
 
-  return *this;
+void JPEGImage::waitUntilCompressed() const
+{
+  if(stripes.empty())
+    return;
+
+  // Move the stripes together.
+  size = 0;
+  for(Stripe& stripe : stripes)
+  {
+    stripe.done.wait();
+    std::memmove(allocator.data() + size, allocator.data() + stripe.offset, stripe.size);
+    size += static_cast<unsigned>(stripe.size);
+  }
+  stripes.clear();
 }
 
 void JPEGImage::toCameraImage(CameraImage& dest) const
 {
+  waitUntilCompressed();
   dest.setResolution(width, height * 2);
   dest.timestamp = timestamp;
 
-  jpeg_decompress_struct cInfo;
-  jpeg_error_mgr jem;
-  cInfo.err = jpeg_std_error(&jem);
-
-  jpeg_create_decompress(&cInfo);
-
-  if(!cInfo.src)
-    cInfo.src = static_cast<jpeg_source_mgr*>(
-                (*cInfo.mem->alloc_small)(reinterpret_cast<j_common_ptr>(&cInfo), JPOOL_PERMANENT, sizeof(jpeg_source_mgr)));
-  cInfo.src->init_source       = onSrcIgnore;
-  cInfo.src->fill_input_buffer = onSrcEmpty;
-  cInfo.src->skip_input_data   = onSrcSkip;
-  cInfo.src->resync_to_restart = jpeg_resync_to_restart;
-  cInfo.src->term_source       = onSrcIgnore;
-  cInfo.src->bytes_in_buffer   = allocator.size();
-  cInfo.src->next_input_byte   = static_cast<const JOCTET*>(allocator.data());
-
-  jpeg_read_header(&cInfo, true);
-  jpeg_start_decompress(&cInfo);
-  if(cInfo.num_components == 4) // full size images
+  // The image consists of one or more JPEG images of consecutive rows.
+  const unsigned char* next = allocator.data();
+  size_t remaining = size;
+  unsigned row = 0;
+  while(row < dest.height && remaining > 0)
   {
-    // setup rows
-    while(cInfo.output_scanline < cInfo.output_height)
+    jpeg_decompress_struct cInfo;
+    jpeg_error_mgr jem;
+    cInfo.err = jpeg_std_error(&jem);
+
+    jpeg_create_decompress(&cInfo);
+
+    if(!cInfo.src)
+      cInfo.src = static_cast<jpeg_source_mgr*>(
+                  (*cInfo.mem->alloc_small)(reinterpret_cast<j_common_ptr>(&cInfo), JPOOL_PERMANENT, sizeof(jpeg_source_mgr)));
+    cInfo.src->init_source       = onSrcIgnore;
+    cInfo.src->fill_input_buffer = onSrcEmpty;
+    cInfo.src->skip_input_data   = onSrcSkip;
+    cInfo.src->resync_to_restart = jpeg_resync_to_restart;
+    cInfo.src->term_source       = onSrcIgnore;
+    cInfo.src->bytes_in_buffer   = remaining;
+    cInfo.src->next_input_byte   = static_cast<const JOCTET*>(next);
+
+    jpeg_read_header(&cInfo, true);
+    jpeg_start_decompress(&cInfo);
+    if(cInfo.num_components == 4) // full size images
     {
-      JSAMPROW rowPointer = reinterpret_cast<unsigned char*>((dest[0] + width * cInfo.output_scanline));
-      static_cast<void>(jpeg_read_scanlines(&cInfo, &rowPointer, 1));
+      // setup rows
+      while(cInfo.output_scanline < cInfo.output_height && row + cInfo.output_scanline < dest.height)
+      {
+        JSAMPROW rowPointer = reinterpret_cast<unsigned char*>(dest[row + cInfo.output_scanline]);
+        static_cast<void>(jpeg_read_scanlines(&cInfo, &rowPointer, 1));
+      }
     }
+    else
+    {
+      FAIL("Unsupported number of colors: " << cInfo.num_components << ".");
+    }
+    if(!cInfo.output_scanline)
+    {
+      jpeg_destroy_decompress(&cInfo);
+      break;
+    }
+    row += cInfo.output_scanline;
+
+    // finish decompress
+    if(cInfo.output_scanline == cInfo.output_height)
+      jpeg_finish_decompress(&cInfo);
+    next = cInfo.src->next_input_byte;
+    remaining = cInfo.src->bytes_in_buffer;
+    jpeg_destroy_decompress(&cInfo);
   }
-  else
-  {
-    FAIL("Unsupported number of colors: " << cInfo.num_components << ".");
-  }
-
-  // finish decompress
-  jpeg_finish_decompress(&cInfo);
-  jpeg_destroy_decompress(&cInfo);
 }
 
 void JPEGImage::read(In& stream)
 {
+  waitUntilCompressed();
   STREAM(width);
   STREAM(height);
   STREAM(timestamp);
@@ -136,6 +231,7 @@ void JPEGImage::read(In& stream)
 
 void JPEGImage::write(Out& stream) const
 {
+  waitUntilCompressed();
   unsigned timestamp = this->timestamp | 1 << 31;
   STREAM(width);
   STREAM(height);
@@ -8,21 +8,63 @@
 
 #include "Representations/Infrastructure/CameraImage.h"
 #include "Tools/Streams/Streamable.h"
+#include <future>
 
 /**
  * Definition of a struct for JPEG-compressed images.
+ * The image is split into horizontal stripes that are compressed in parallel
+ * by the shared WorkerPool. Each stripe is a complete JPEG image. The stripes
+ * are stored one after another in the same buffer.
+ * The compression can also run asynchronously. In that case, all methods
+ * that access the compressed data wait until it is complete.
  */
 struct JPEGImage : public Streamable
 {
 private:
-  unsigned size; /**< The size of the compressed image. */
-  int width; /**< The width of the image in pixel */
-  int height; /**< The height of the image in pixel */
-  std::vector<unsigned char> allocator; /**< The data storage */
+  /** A stripe that is compressed in parallel with the others. */
+  struct Stripe
+  {
+    size_t offset; /**< The offset of the stripe's buffer region in the allocator. */
+    size_t capacity; /**< The number of bytes reserved for this stripe. */
+    size_t size = 0; /**< The size of the compressed stripe. */
+    std::future<void> done; /**< Becomes ready when the stripe is compressed. */
+  };
+
+  // The compressed data is completed lazily, even by const methods.
+  mutable unsigned size = 0; /**< The size of the compressed image. */
+  int width = 0; /**< The width of the image in pixel */
+  int height = 0; /**< The height of the image in pixel */
+  mutable std::vector<unsigned char> allocator; /**< The data storage */
+  mutable std::vector<Stripe> stripes; /**< The stripes still being compressed. */
+  CameraImage source; /**< A copy of the image currently compressed. */
+
+  /**
+   * Compresses a range of rows of the source image into a JPEG stripe.
+   * @param stripe The stripe that receives the compressed data.
+   * @param firstRow The first row of the source image compressed.
+   * @param numOfRows The number of rows compressed.
+   */
+  void compress(Stripe& stripe, unsigned firstRow, unsigned numOfRows);
 
 public:
   JPEGImage() = default;
 
+  /**
+   * Copy constructor. Waits until the other image is compressed.
+   * @param other The image that is copied.
+   */
+  JPEGImage(const JPEGImage& other);
+
+  /** The destructor waits until a pending compression has finished. */
+  ~JPEGImage();
+
+  /**
+   * Assignment operator. Waits until both images are compressed.
+   * @param other The image that is copied.
+   * @return This image.
+   */
+  JPEGImage& operator=(const JPEGImage& other);
+
   /**
    * Constructs a JPEG image from an image.
    * @param src The image used as template.
@@ -37,7 +79,30 @@ public:
   JPEGImage& operator=(const CameraImage& src);
 
   /**
-   * Uncompress image.
+   * Starts compressing an image and returns immediately. The image is
+   * copied, i.e. the source can be changed afterwards.
+   * @param src The image that is compressed.
+   * @param numOfStripes The number of stripes that are compressed in parallel.
+   *                     0 uses one per worker of the shared WorkerPool.
+   */
+  void compressAsync(const CameraImage& src, unsigned numOfStripes = 0);
+
+  /** Waits until a compression started by compressAsync has finished. */
+  void waitUntilCompressed() const;
+
+  /**
+   * Returns the size of the compressed image. Waits for the compression.
+   * @return The size in bytes.
+   */
+  unsigned getSize() const
+  {
+    waitUntilCompressed();
+    return size;
+  }
+
+  /**
+   * Uncompress image. Images consisting of multiple stripes are supported as
+   * well as images that were compressed as a whole.
    * @param dest Will receive the uncompressed image.
    */
   void toCameraImage(CameraImage& dest) const;
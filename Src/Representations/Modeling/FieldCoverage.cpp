@@ -70,6 +70,7 @@ bool FieldCoverage::handleArbitraryMessage(InMessage& m, const std::function<uns
   while(m.getBytesLeft())
   {
     lines[y].y = y;
+    lines[y].version = toLocalTimestamp(time);
 
     for(int x = 0; x < 18; x++)
     {
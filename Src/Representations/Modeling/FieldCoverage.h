@@ -23,7 +23,9 @@ STREAMABLE(FieldCoverage, COMMA public BHumanMessageParticle<idFieldCoverage>
   bool handleArbitraryMessage(InMessage& m, const std::function<unsigned(unsigned)>& toLocalTimestamp) override;
 
   STREAMABLE(GridLine,
-  {,
+  {
+    unsigned version = 0; /**< Time when the timestamps were changed the last time. Not streamed. */
+    ,
     (int) y,
     (std::vector<unsigned>)() timestamps,
   }),
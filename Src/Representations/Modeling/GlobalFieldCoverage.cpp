@@ -25,6 +25,11 @@ GlobalFieldCoverage::Cell::Cell(const int coverage, unsigned timestamp,
 }
 
 unsigned GlobalFieldCoverage::timeWhenLastSeen(const Vector2f& positionOnField, const FieldDimensions& theFieldDimensions) const
+{
+  return grid[cellIndex(positionOnField, theFieldDimensions)].timestamp;
+}
+
+size_t GlobalFieldCoverage::cellIndex(const Vector2f& positionOnField, const FieldDimensions& theFieldDimensions) const
 {
   float clippedPositionX = clip(positionOnField.x(), theFieldDimensions.xPosOwnGroundLine, theFieldDimensions.xPosOpponentGroundLine);
   float clippedPositionY = clip(positionOnField.y(), theFieldDimensions.yPosRightSideline, theFieldDimensions.yPosLeftSideline);
@@ -32,7 +37,7 @@ unsigned GlobalFieldCoverage::timeWhenLastSeen(const Vector2f& positionOnField,
   const int x = std::min(static_cast<int>((clippedPositionX - theFieldDimensions.xPosOwnGroundLine) / cellLengthX), numOfCellsX - 1);
   const int y = std::min(static_cast<int>((clippedPositionY - theFieldDimensions.yPosRightSideline) / cellLengthY), numOfCellsY - 1);
 
-  return grid[y * 18 + x].timestamp;
+  return y * numOfCellsX + x;
 }
 
 void GlobalFieldCoverage::draw() const
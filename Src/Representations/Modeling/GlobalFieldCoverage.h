@@ -21,6 +21,14 @@ STREAMABLE(GlobalFieldCoverage,
    */
   unsigned timeWhenLastSeen(const Vector2f& positionOnField, const FieldDimensions& theFieldDimensions) const;
 
+  /**
+   * Return the index of the cell that contains a position. Positions outside
+   * the field are clipped to the field.
+   *
+   * @return The index of the cell in the grid
+   */
+  size_t cellIndex(const Vector2f& positionOnField, const FieldDimensions& theFieldDimensions) const;
+
   STREAMABLE(Cell,
   {
     Cell() = default;
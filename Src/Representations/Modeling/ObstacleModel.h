@@ -34,3 +34,9 @@ STREAMABLE(ObstacleModel, COMMA public BHumanMessageParticle<idObstacleModel>
 
   (std::vector<Obstacle>) obstacles, /**< List of obstacles (position relative to own pose) */
 });
+
+/** The obstacles of the ObstacleModel of the previous frame of the Cognition thread, i.e. those expected in the current image. */
+STREAMABLE_WITH_BASE(ExpectedObstacleModel, ObstacleModel,
+{,
+  (unsigned)(0) timestamp, /**< The time of the image the obstacles are relative to. 0 if the model was never provided. */
+});
@@ -24,6 +24,7 @@ Debug::Debug(const Settings& settings, const std::string& robotName, const Confi
 #ifdef TARGET_ROBOT
   debugSender->setSize(MAX_PACKAGE_SEND_SIZE - 2000);
   debugReceiver->setSize(MAX_PACKAGE_RECEIVE_SIZE - 2000);
+  uncompressed.setSize(MAX_PACKAGE_SEND_SIZE - 2000);
 #endif
 }
 
@@ -161,6 +162,8 @@ bool Debug::main()
 #else
   for(DebugSender<MessageQueue>& sender : senders)
     sender.send(false);
+  if(debugHandler.getThroughput() < DebugImage::compressionThreshold)
+    compressDebugImages();
   debugHandler.communicate(true);
 #ifdef NDEBUG
   // Stop debug in release after sending the module configuration
@@ -227,3 +230,39 @@ bool Debug::handleMessage(InMessage& message)
       return true;
   }
 }
+
+#ifdef TARGET_ROBOT
+
+void Debug::compressDebugImages()
+{
+  class Compressor : public MessageHandler
+  {
+    MessageQueue& out;
+    DebugImage& image;
+
+  public:
+    Compressor(MessageQueue& out, DebugImage& image) : out(out), image(image) {}
+
+    bool handleMessage(InMessage& message) override
+    {
+      if(message.getMessageID() == idDebugImage)
+      {
+        std::string id;
+        message.bin >> id >> image;
+        out.out.bin << id;
+        image.writeCompressed(out.out.bin);
+        out.out.finishMessage(idCompressedDebugImage);
+      }
+      else
+        message >> out;
+      return true;
+    }
+  } compressor(*debugSender, debugImage);
+
+  uncompressed.clear();
+  debugSender->moveAllMessages(uncompressed);
+  uncompressed.handleAllMessages(compressor);
+  uncompressed.clear();
+}
+
+#endif
@@ -14,6 +14,7 @@
 
 #ifdef TARGET_ROBOT
 #include "Platform/DebugHandler.h"
+#include "Tools/Debugging/DebugImages.h"
 #endif
 #include "Tools/Framework/Configuration.h"
 #include "Tools/Framework/ThreadFrame.h"
@@ -34,6 +35,8 @@ class Debug : public ThreadFrame
 private:
 #ifdef TARGET_ROBOT
   DebugHandler debugHandler;
+  MessageQueue uncompressed; /**< The outgoing messages before debug images were compressed. */
+  DebugImage debugImage; /**< Buffer for decoding a debug image before it is compressed. */
 #endif
 
   std::string threadIdentifier; /**< The thread the messages from the GUI are meant to be sent to. */
@@ -87,6 +90,15 @@ protected:
    */
   bool handleMessage(InMessage& message) override;
 
+#ifdef TARGET_ROBOT
+  /**
+   * Replaces all debug images in the outgoing queue by compressed ones.
+   * This is done here rather than in the threads that created the images
+   * to keep the encoding time away from them.
+   */
+  void compressDebugImages();
+#endif
+
   friend class ModuleContainer; // To add receivers and senders
   friend class LocalRobot; // To add receiver and sender in simulation
 };
@@ -9,6 +9,9 @@
 #include "Perception.h"
 #include "Modules/Infrastructure/CameraProvider/CameraProvider.h"
 #include "Modules/Infrastructure/LogDataProvider/LogDataProvider.h"
+#include "Platform/Time.h"
+#include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/Infrastructure/FrameInfo.h"
 
 REGISTER_EXECUTION_UNIT(Perception)
 
@@ -24,6 +27,31 @@ void Perception::beforeModules()
   {
     ORIGIN("perception:Reset", 0, 0, 0);
   }
+
+  DECLARE_PLOT("perception:upperLatency");
+  DECLARE_PLOT("perception:upperFrameRate");
+  DECLARE_PLOT("perception:lowerLatency");
+  DECLARE_PLOT("perception:lowerFrameRate");
+}
+
+void Perception::afterModules()
+{
+  bool upper;
+  float latency;
+  float frameRate;
+  if(measure(upper, latency, frameRate))
+  {
+    if(upper)
+    {
+      PLOT("perception:upperLatency", latency);
+      PLOT("perception:upperFrameRate", frameRate);
+    }
+    else
+    {
+      PLOT("perception:lowerLatency", latency);
+      PLOT("perception:lowerFrameRate", frameRate);
+    }
+  }
 }
 
 bool Perception::afterFrame()
@@ -43,3 +71,17 @@ bool Perception::afterFrame()
 
   return FrameExecutionUnit::afterFrame();
 }
+
+bool Perception::measure(bool& upper, float& latency, float& frameRate)
+{
+  if(!Blackboard::getInstance().exists("FrameInfo") || !Blackboard::getInstance().exists("CameraInfo"))
+    return false;
+
+  const unsigned now = Time::getCurrentSystemTime();
+  const FrameInfo& frameInfo = static_cast<const FrameInfo&>(Blackboard::getInstance()["FrameInfo"]);
+  upper = static_cast<const CameraInfo&>(Blackboard::getInstance()["CameraInfo"]).camera == CameraInfo::upper;
+  latency = static_cast<float>(static_cast<int>(now - frameInfo.time));
+  frameRate = lastFrameEnd && now != lastFrameEnd ? 1000.f / static_cast<float>(now - lastFrameEnd) : 0.f;
+  lastFrameEnd = now;
+  return true;
+}
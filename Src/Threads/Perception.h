@@ -17,8 +17,23 @@
  */
 class Perception : public FrameExecutionUnit
 {
+private:
+  unsigned lastFrameEnd = 0; /**< The time when the previous frame was finished. */
+
 public:
   bool beforeFrame() override;
   void beforeModules() override;
+  void afterModules() override;
   bool afterFrame() override;
+
+protected:
+  /**
+   * Measures the time that passed since the image processed in this frame was
+   * taken and the number of images processed per second.
+   * @param upper Is set to whether the image was taken by the upper camera.
+   * @param latency Is set to the time since the image was taken in ms.
+   * @param frameRate Is set to the number of frames per second.
+   * @return Could the measurement be done, i.e. were FrameInfo and CameraInfo available?
+   */
+  bool measure(bool& upper, float& latency, float& frameRate);
 };
@@ -0,0 +1,83 @@
+/**
+ * @file Threads/PipelinedPerception.cpp
+ *
+ * This file implements the execution unit for perception threads that do not
+ * process the camera images themselves, but the results of a preprocessing
+ * thread.
+ */
+
+#include "PipelinedPerception.h"
+#include "Modules/Infrastructure/LogDataProvider/LogDataProvider.h"
+#include "Platform/Time.h"
+#include "Representations/Infrastructure/FrameInfo.h"
+
+REGISTER_EXECUTION_UNIT(PipelinedPerception)
+
+bool PipelinedPerception::beforeFrame()
+{
+  if(!frameInfoName)
+  {
+    if(Blackboard::getInstance().exists("UpperPreprocessingFrameInfo"))
+      frameInfoName = "UpperPreprocessingFrameInfo";
+    else if(Blackboard::getInstance().exists("LowerPreprocessingFrameInfo"))
+      frameInfoName = "LowerPreprocessingFrameInfo";
+    else
+      return LogDataProvider::isFrameDataComplete();
+  }
+
+  // Only run if the preprocessing thread has delivered a new image.
+  const unsigned frameTime = static_cast<const FrameInfo&>(Blackboard::getInstance()[frameInfoName]).time;
+  if(frameTime == lastFrameTime)
+    return false;
+  lastFrameTime = frameTime;
+  return true;
+}
+
+void PipelinedPerception::beforeModules()
+{
+  Perception::beforeModules();
+
+  DECLARE_PLOT("perception:upperPipelineImageAge");
+  DECLARE_PLOT("perception:upperPipelineLatency");
+  DECLARE_PLOT("perception:upperPipelineFrameRate");
+  DECLARE_PLOT("perception:lowerPipelineImageAge");
+  DECLARE_PLOT("perception:lowerPipelineLatency");
+  DECLARE_PLOT("perception:lowerPipelineFrameRate");
+
+  // How old is the image when this stage starts? This includes the time the
+  // preprocessing thread needed and the time its result waited for this thread.
+  if(frameInfoName)
+  {
+    const float age = static_cast<float>(Time::getTimeSince(lastFrameTime));
+    if(frameInfoName[0] == 'U')
+      PLOT("perception:upperPipelineImageAge", age);
+    else
+      PLOT("perception:lowerPipelineImageAge", age);
+  }
+}
+
+void PipelinedPerception::afterModules()
+{
+  bool upper;
+  float latency;
+  float frameRate;
+  if(measure(upper, latency, frameRate))
+  {
+    if(upper)
+    {
+      PLOT("perception:upperPipelineLatency", latency);
+      PLOT("perception:upperPipelineFrameRate", frameRate);
+    }
+    else
+    {
+      PLOT("perception:lowerPipelineLatency", latency);
+      PLOT("perception:lowerPipelineFrameRate", frameRate);
+    }
+  }
+}
+
+bool PipelinedPerception::afterFrame()
+{
+  // Always wait for the next packet from the preprocessing thread. Its arrival wakes up this thread.
+  return true;
+}
@@ -0,0 +1,32 @@
+/**
+ * @file Threads/PipelinedPerception.h
+ *
+ * This file declares the execution unit for perception threads that do not
+ * process the camera images themselves, but the results of a preprocessing
+ * thread. This allows to run the preprocessing of the next image in parallel
+ * to the high-level perception of the current one.
+ */
+
+#pragma once
+
+#include "Perception.h"
+
+/**
+ * @class PipelinedPerception
+ *
+ * The execution unit for the second stage of a pipelined perception thread.
+ * A frame is executed whenever the preprocessing thread (UpperPreprocessing or
+ * LowerPreprocessing) delivered the data of a new image.
+ */
+class PipelinedPerception : public Perception
+{
+private:
+  const char* frameInfoName = nullptr; /**< The name of the FrameInfo alias received from the preprocessing thread. */
+  unsigned lastFrameTime = 0; /**< The timestamp of the last image processed. */
+
+public:
+  bool beforeFrame() override;
+  void beforeModules() override;
+  void afterModules() override;
+  bool afterFrame() override;
+};
@@ -38,8 +38,9 @@ void Card::call()
   }
   ActivationGraph& theActivationGraph = CardRegistry::theInstance->theActivationGraph;
   const size_t activationGraphIndex = theActivationGraph.graph.size();
-  theActivationGraph.graph.emplace_back(_name, ++theActivationGraph.currentDepth, "", CardRegistry::theInstance->currentFrameTime - _context.behaviorStart, 0, std::vector<std::string>());
+  theActivationGraph.addNode(_name, ++theActivationGraph.currentDepth, "", CardRegistry::theInstance->currentFrameTime - _context.behaviorStart, 0);
   execute();
+  clearAllConditions();
   if(_context.stateName) \
   {
     theActivationGraph.graph[activationGraphIndex].state = _context.stateName;
@@ -26,7 +26,17 @@ public:
   /** Indicates whether this card may be entered. */
   virtual bool preconditions() const { return false; }
   /** Indicates whether this card may/must be left. */
-  virtual bool postconditions() const { return !preconditions(); }
+  virtual bool postconditions() const { return !checkPreconditions(); }
+  /**
+   * Returns the result of \c preconditions. It is only evaluated once per
+   * frame and again after any card was executed.
+   */
+  bool checkPreconditions() const { return checkCondition(&CardBase::preconditions, preconditionsChecked, preconditionsTrue); }
+  /**
+   * Returns the result of \c postconditions. It is only evaluated once per
+   * frame and again after any card was executed.
+   */
+  bool checkPostconditions() const { return checkCondition(&CardBase::postconditions, postconditionsChecked, postconditionsTrue); }
   /** Calls the card (i.e. adds it to the activation graph, calls \c reset if needed, calls \c execute). */
   virtual void call() = 0;
 
@@ -35,9 +45,47 @@ protected:
   virtual void execute() = 0;
   /** Resets the card. Is called if before \c execute if this card was not called in the last frame. */
   virtual void reset() {}
+  /** Forgets the cached results of the conditions of this card, e.g. at the beginning of a frame. */
+  void clearConditions() { _conditions = 0; }
+  /**
+   * Forgets the cached results of the conditions of all cards of this thread,
+   * because executing a card might have changed what they depend on.
+   */
+  static void clearAllConditions() { ++_executions; }
   mutable BehaviorContext _context; /**< The behavior context of this card. */
   const char* _name; /**< The name of the derived card (for the ActivationGraph). */
 private:
+  /** Flags stored in \c _conditions. */
+  enum : unsigned char
+  {
+    preconditionsChecked = 1,
+    preconditionsTrue = 2,
+    postconditionsChecked = 4,
+    postconditionsTrue = 8
+  };
+  mutable unsigned char _conditions = 0; /**< The cached results of the conditions in the current frame. */
+  mutable unsigned _conditionsExecutions = 0; /**< The value of \c _executions when the conditions were cached. */
+  static inline thread_local unsigned _executions = 0; /**< The number of times any card of this thread was executed. */
+
+  /**
+   * Evaluates a condition if its result is not cached yet.
+   * @param condition The condition.
+   * @param checked The flag that states that the condition was evaluated.
+   * @param isTrue The flag that states that the condition was true.
+   * @return The result of the condition.
+   */
+  bool checkCondition(bool (CardBase::*condition)() const, unsigned char checked, unsigned char isTrue) const
+  {
+    if(_conditionsExecutions != _executions)
+    {
+      _conditions = 0;
+      _conditionsExecutions = _executions;
+    }
+    if(!(_conditions & checked))
+      _conditions |= checked | ((this->*condition)() ? isTrue : 0);
+    return (_conditions & isTrue) != 0;
+  }
+
   /** Is called each frame before the behavior has been run. */
   virtual void preProcess() {}
   /** Is called each frame after the behavior has been run. */
@@ -45,4 +93,5 @@ private:
   /** Calls \c MODIFY on the parameters of the card. */
   virtual void modifyParameters() = 0;
   friend class CardRegistryBase;
+  friend class PriorityListDealer;
 };
@@ -207,7 +207,7 @@ private:
     { \
       if(sizeof(NoParameters) < sizeof(theName##Card::Parameters)) \
       { \
-        Global::getDebugDataTable().updateObject("parameters:" #theName, *this, false); \
+        Global::getDebugDataTable().updateObject(DEBUG_REQUEST_SLOT("debug data:parameters:" #theName), *this, false); \
         DEBUG_RESPONSE_ONCE("debug data:parameters:" #theName) \
           OUTPUT(idDebugDataResponse, bin, "parameters:" #theName << TypeRegistry::demangle(typeid(theName##Card::Parameters).name()) << *this); \
       } \
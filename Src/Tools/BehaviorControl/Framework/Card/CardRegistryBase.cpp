@@ -44,7 +44,10 @@ void CardRegistryBase::preProcess(unsigned frameTime)
 {
   currentFrameTime = frameTime;
   for(auto& card : cards)
+  {
+    card.second->clearConditions();
     card.second->preProcess();
+  }
 }
 
 void CardRegistryBase::postProcess()
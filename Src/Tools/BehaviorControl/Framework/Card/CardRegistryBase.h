@@ -40,7 +40,8 @@ public:
   void modifyAllParameters();
 
   /**
-   * Calls \c preProcess on all cards and updates the current frame time.
+   * Calls \c preProcess on all cards, forgets the results of their conditions,
+   * and updates the current frame time.
    * @param frameTime The current time from the FrameInfo.
    */
   void preProcess(unsigned frameTime);
@@ -12,7 +12,12 @@
 
 #include "CardBase.h"
 #include "Platform/BHAssert.h"
+#include "Platform/Time.h"
+#include "Representations/BehaviorControl/ActivationGraph.h"
+#include "Tools/Debugging/Debugging.h"
 #include "Tools/Streams/AutoStreamable.h"
+#include <algorithm>
+#include <cstdio>
 #include <limits>
 #include <string>
 #include <vector>
@@ -59,6 +64,9 @@ public:
   /**
    * Deals a card from the deck. The first card with true preconditions is selected, unless
    * it comes after the previously dealt card and its postconditions are not yet true.
+   * The conditions of each card are evaluated at most once per frame. If the debug
+   * request "cards:conditionCosts" is active, the thread time spent in the conditions
+   * of each card checked is added as a parameter to the card that deals.
    * @tparam Registry The registry from which to obtain cards.
    * @param deck The deck from which to select a card.
    * @return The selected card.
@@ -66,13 +74,26 @@ public:
   template<typename Registry>
   CardBase* deal(const DeckOfCards<Registry>& deck)
   {
+    bool measure = false;
+    DEBUG_RESPONSE("cards:conditionCosts")
+      measure = true;
+    const auto check = [&](const CardBase* card, const auto& condition)
+    {
+      if(!measure)
+        return condition();
+      const unsigned long long start = Time::getCurrentThreadTime();
+      const bool result = condition();
+      reportCosts(Registry::theInstance->theActivationGraph, card->_name, Time::getCurrentThreadTime() - start);
+      return result;
+    };
+
     CardBase* nextCard = nullptr;
-    if(deck.sticky && lastCard && deck.contains(lastCard) && !lastCard->postconditions())
+    if(deck.sticky && lastCard && deck.contains(lastCard) && check(lastCard, [&] { return !lastCard->checkPostconditions(); }))
       return lastCard;
     for(size_t i = 0; i < deck.cards.size(); ++i)
     {
       CardBase* card = deck[i];
-      if((card == lastCard) ? (!card->postconditions() || card->preconditions()) : card->preconditions())
+      if(check(card, [&] { return (card == lastCard) ? (!card->checkPostconditions() || card->checkPreconditions()) : card->checkPreconditions(); }))
       {
         nextCard = card;
         break;
@@ -89,5 +110,24 @@ public:
     lastCard = nullptr;
   }
 private:
+  /**
+   * Adds the time spent in the conditions of a card to the node of the card that deals.
+   * @param activationGraph The activation graph. The node of the dealing card is the
+   *                        last one at its current depth.
+   * @param name The name of the card whose conditions were checked.
+   * @param time The thread time spent in µs.
+   */
+  static void reportCosts(ActivationGraph& activationGraph, const char* name, unsigned long long time)
+  {
+    for(auto node = activationGraph.graph.rbegin(); node != activationGraph.graph.rend(); ++node)
+      if(node->depth == activationGraph.currentDepth)
+      {
+        char text[128];
+        const int length = std::snprintf(text, sizeof(text), "%s conditions = %llu µs", name, time);
+        activationGraph.addParameter(*node, text, std::min(static_cast<size_t>(length), sizeof(text) - 1));
+        break;
+      }
+  }
+
   CardBase* lastCard = nullptr; /**< The previously dealt card. */
 };
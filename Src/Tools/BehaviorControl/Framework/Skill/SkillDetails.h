@@ -129,9 +129,7 @@ private:
       } \
       _S(_SKILL_INTERFACE_PARAM2(seq)) : _STREAM_VAR(seq)(_STREAM_VAR(seq)) {} \
     } _s(_STREAM_VAR(seq)); \
-    OutMapMemory stream(true, 1024); \
-    stream << _s; \
-    _parameters.emplace_back(stream.data()); \
+    theActivationGraph.addParameter(theActivationGraph.graph[activationGraphIndex], _s); \
   }
 
 /** If a default value exists, only stream parameters that are different from it. */
@@ -181,11 +179,10 @@ private:
         _context.stateName = nullptr; \
         theImplementation->reset(*this); \
       } \
-      std::vector<std::string> _parameters; \
-      _STREAM_ATTR_##n params4 \
       ActivationGraph& theActivationGraph = registry::theInstance->theActivationGraph; \
       const size_t activationGraphIndex = theActivationGraph.graph.size(); \
-      theActivationGraph.graph.emplace_back(#name, ++theActivationGraph.currentDepth, "", registry::theInstance->currentFrameTime - _context.behaviorStart, 0, _parameters); \
+      theActivationGraph.addNode(#name, ++theActivationGraph.currentDepth, "", registry::theInstance->currentFrameTime - _context.behaviorStart, 0); \
+      _STREAM_ATTR_##n params4 \
       theImplementation->execute(*this); \
       if(_context.stateName) \
       { \
@@ -416,7 +413,7 @@ private:
     { \
       if(sizeof(NoParameters) < sizeof(theName##Skill::Parameters)) \
       { \
-        Global::getDebugDataTable().updateObject("parameters:" #theName, *this, false); \
+        Global::getDebugDataTable().updateObject(DEBUG_REQUEST_SLOT("debug data:parameters:" #theName), *this, false); \
         DEBUG_RESPONSE_ONCE("debug data:parameters:" #theName) \
           OUTPUT(idDebugDataResponse, bin, "parameters:" #theName << TypeRegistry::demangle(typeid(theName##Skill::Parameters).name()) << *this); \
       } \
@@ -16,12 +16,19 @@ void SectorWheel::begin(const Vector2f& positionOnField)
 {
   this->positionOnField = positionOnField;
 
+  partition.reset({std::numeric_limits<float>::max(), Sector::free});
+}
+
+void SectorWheel::createSectors()
+{
   wheel.clear();
-  wheel.emplace_back(Rangea(-pi, pi), std::numeric_limits<float>::max(), Sector::free);
+  for(const auto& segment : partition)
+    wheel.emplace_back(Rangea(segment.min, segment.max), segment.value.distance, segment.value.type);
 }
 
-const std::list<SectorWheel::Sector>& SectorWheel::finish()
+const std::vector<SectorWheel::Sector>& SectorWheel::finish()
 {
+  createSectors();
   ASSERT(!wheel.empty());
   ASSERT(wheel.front().angleRange.min == -pi);
   ASSERT(wheel.back().angleRange.max == pi);
@@ -30,7 +37,7 @@ const std::list<SectorWheel::Sector>& SectorWheel::finish()
     if(wheel.front().distance == wheel.back().distance && wheel.front().type == wheel.back().type)
     {
       wheel.back().angleRange.max = wheel.front().angleRange.max;
-      wheel.pop_front();
+      wheel.erase(wheel.begin());
     }
   }
 
@@ -42,8 +49,9 @@ const std::list<SectorWheel::Sector>& SectorWheel::finish()
   return wheel;
 }
 
-const std::list<SectorWheel::Sector>& SectorWheel::finishWithoutCircleClosure()
+const std::vector<SectorWheel::Sector>& SectorWheel::finishWithoutCircleClosure()
 {
+  createSectors();
   ASSERT(!wheel.empty());
   ASSERT(wheel.front().angleRange.min == -pi);
   ASSERT(wheel.back().angleRange.max == pi);
@@ -108,49 +116,17 @@ void SectorWheel::addSectorNormalized(const Rangea& angleRange, float distance,
   if(angleRange.max == angleRange.min)
     return;
 
-  // There should always be the [-pi, pi[ sector.
-  ASSERT(!wheel.empty());
   ASSERT(angleRange.max > angleRange.min);
   ASSERT(angleRange.min >= -pi);
   ASSERT(angleRange.max <= pi);
 
-  // These variables are used to extend a new sector if it crosses multiple old sectors.
-  bool contiguous = false;
-  auto currentContiguousPart = wheel.end();
-  for(auto it = wheel.begin(); it != wheel.end(); ++it)
+  // The new sector replaces all parts of the wheel that are not closer than it.
+  // Consecutive replaced parts are merged into a single sector.
+  partition.update(angleRange.min, angleRange.max, [distance, type](Occupancy& occupancy)
   {
-    if(it->angleRange.max <= angleRange.min) // The current sector ends before the new one starts -> try next.
-      continue;
-
-    if(it->angleRange.min >= angleRange.max) // The current sector begins after the new one ends -> done.
-      break;
-
-    if(distance > it->distance) // The current sector is closer than the new one -> look at next.
-    {
-      contiguous = false;
-      continue;
-    }
-
-    // <---> below the new sector is closer than the current iterated one
-    const Sector currentSector = *it;
-    auto nextIt = std::next(it);
-
-    // if the current sector begins before the new one, shrink the current to fit before it otherwise remove the current
-    if(it->angleRange.min < angleRange.min)
-      it->angleRange.max = (ASSERT(!contiguous), angleRange.min);
-    else
-      nextIt = wheel.erase(it);
-
-    // add the new sector
-    if(contiguous)
-      currentContiguousPart->angleRange.max = std::min(currentSector.angleRange.max, angleRange.max), it = currentContiguousPart;
-    else
-      it = wheel.emplace(nextIt, Rangea(std::max(angleRange.min, currentSector.angleRange.min), std::min(currentSector.angleRange.max, angleRange.max)), distance, type);
-
-    //if the current sector end after the new one: add some parts again or else set continues
-    if((contiguous = currentSector.angleRange.max <= it->angleRange.max))
-      currentContiguousPart = it;
-    else
-      it = wheel.emplace(nextIt, Rangea(it->angleRange.max, currentSector.angleRange.max), currentSector.distance, currentSector.type);
-  }
+    if(distance > occupancy.distance)
+      return false;
+    occupancy = {distance, type};
+    return true;
+  });
 }
@@ -10,11 +10,12 @@
 
 #include "Tools/Debugging/DebugDrawings.h"
 #include "Tools/Math/Angle.h"
+#include "Tools/Math/AngularPartition.h"
 #include "Tools/Math/Eigen.h"
 #include "Tools/Range.h"
 #include "Tools/Streams/Enum.h"
 
-#include <list>
+#include <vector>
 
 class SectorWheel
 {
@@ -49,14 +50,14 @@ public:
    * Post-processes and returns the calculated wheel.
    * @return The resulting wheel.
    */
-  const std::list<Sector>& finish();
+  const std::vector<Sector>& finish();
 
   /**
    * Post-processes and returns the calculated wheel.
    * Does not reunite Sectors that go over -pi/pi border.
    * @return The resulting wheel.
    */
-  const std::list<Sector>& finishWithoutCircleClosure();
+  const std::vector<Sector>& finishWithoutCircleClosure();
 
   /**
    * Adds a sector to the wheel.
@@ -100,8 +101,19 @@ private:
    */
   void addSectorNormalized(const Rangea& angleRange, float distance, Sector::Type type);
 
+  /** What ends a sector of the wheel. */
+  struct Occupancy
+  {
+    float distance; /**< The distance from the wheel center at which the sector ends. */
+    Sector::Type type; /**< The type of the sector. */
+  };
+
+  /** Copies the partition of the circle into the list of sectors returned. */
+  void createSectors();
+
   Vector2f positionOnField; /**< The current center of the wheel. */
-  std::list<Sector> wheel; /**< The actual wheel of sectors (must form a sorted partition of [-pi,pi[). */
+  AngularPartition<Occupancy> partition; /**< The actual wheel of sectors. */
+  std::vector<Sector> wheel; /**< The wheel of sectors returned. */
 };
 
 inline SectorWheel::Sector::Sector(const Rangea& angleRange, float distance, Type type) :
@@ -21,7 +21,7 @@ namespace SectorWheelUtil
    * @param sectorList A list of sectors derived from a SectorWheel
    * @return The Sector containing the angle
    */
-  inline Sector getSector(const Angle& angle, const std::list<Sector>& sectorList)
+  inline Sector getSector(const Angle& angle, const std::vector<Sector>& sectorList)
   {
     for(const Sector& sec : sectorList)
     {
@@ -37,9 +37,9 @@ namespace SectorWheelUtil
    * @param sectorList A list of sectors derived from a SectorWheel
    * @return An unordered list containing the sectors next to the aim sector
    */
-  inline std::list<Sector> getNextSectors(const Angle& angle, const std::list<Sector>& sectorList)
+  inline std::vector<Sector> getNextSectors(const Angle& angle, const std::vector<Sector>& sectorList)
   {
-    std::list<Sector> nextSectors = std::list<Sector>();
+    std::vector<Sector> nextSectors;
     for(auto it = sectorList.cbegin(); it != sectorList.cend(); ++it)
     {
       if(it->angleRange.isInside(angle))
@@ -52,7 +52,7 @@ namespace SectorWheelUtil
         }
         else
           nextSectors.push_back(*sectorList.crbegin());
-        if(it != --sectorList.cend())
+        if(it != std::prev(sectorList.cend()))
           nextSectors.push_back(*(++it));
         else
           nextSectors.push_back(*sectorList.cbegin());
@@ -93,6 +93,8 @@ protected:
     bool addedToGraph; /**< Was this option already added to the activation graph in this frame? */
     bool transitionExecuted; /**< Has a transition already been executed? True after a state change. */
     bool hasCommonTransition; /**< Does this option have a common transition? Is reset when entering the first state. */
+    std::vector<std::string> parameters; /**< Parameter names and their values. Kept between frames to reuse their memory. */
+    size_t numOfParameters; /**< The number of entries of parameters that were set in the current execution. */
   };
 
   /**
@@ -104,7 +106,6 @@ protected:
     const char* optionName; /**< The name of the option (for activation graph). */
     OptionContext& context; /**< The context of the state. */
     Cabsl* instance; /**< The object that encapsulates the behavior. */
-    mutable std::vector<std::string> parameters; /**< Parameter names and their values. */
 
     /**
      * The constructor checks, whether the option was active in the previous frame and
@@ -127,6 +128,7 @@ protected:
       context.addedToGraph = false; // not added to graph yet
       context.transitionExecuted = false; // no transition executed yet
       context.hasCommonTransition = false; // until one is found, it is assumed that there is no common transition
+      context.numOfParameters = 0; // parameters are added later
       if(instance->activationGraph)
         ++instance->activationGraph->currentDepth; // increase depth counter for activation graph
     }
@@ -167,9 +169,12 @@ protected:
      */
     void addParameter(const Streamable& value) const
     {
-      OutMapMemory stream(true, 1024);
+      OutMapMemory& stream = instance->parameterStream;
+      stream.clear();
       stream << value;
-      parameters.emplace_back(stream.data());
+      if(context.numOfParameters == context.parameters.size())
+        context.parameters.emplace_back();
+      context.parameters[context.numOfParameters++].assign(stream.data(), stream.size());
     }
 
     /**
@@ -180,11 +185,12 @@ protected:
     {
       if(!context.addedToGraph && instance->activationGraph)
       {
-        instance->activationGraph->graph.emplace_back(optionName, instance->activationGraph->currentDepth,
-                                                      context.stateName,
-                                                      instance->_currentFrameTime - context.optionStart,
-                                                      instance->_currentFrameTime - context.stateStart,
-                                                      parameters);
+        ActivationGraph::Node& node = instance->activationGraph->addNode(optionName, instance->activationGraph->currentDepth,
+                                                                         context.stateName,
+                                                                         instance->_currentFrameTime - context.optionStart,
+                                                                         instance->_currentFrameTime - context.stateStart);
+        for(size_t i = 0; i < context.numOfParameters; ++i)
+          instance->activationGraph->addParameter(node, context.parameters[i].data(), context.parameters[i].size());
         context.addedToGraph = true;
       }
     }
@@ -316,6 +322,7 @@ private:
   typename OptionContext::StateType stateType; /**< The state type of the last option called. */
   unsigned lastFrameTime; /**< The timestamp of the last time the behavior was executed. */
   ActivationGraph* activationGraph; /**< The activation graph for debug output. Can be zero if not set. */
+  OutMapMemory parameterStream{true}; /**< The stream parameters are formatted with (in a single line). */
 
 protected:
   static thread_local Cabsl* _theInstance; /**< The instance of this behavior used. */
@@ -345,10 +352,7 @@ public:
   {
     _currentFrameTime = std::max(frameTime, lastFrameTime + 1);
     if(activationGraph && clearActivationGraph)
-    {
-      activationGraph->currentDepth = 0;
-      activationGraph->graph.clear();
-    }
+      activationGraph->clear();
     _theInstance = this;
   }
 
@@ -1,7 +1,7 @@
 /**
  * @file MsgPack.cpp
  *
- * This file implements a method that parses a packet according to the MsgPack format.
+ * This file implements methods that parse a packet according to the MsgPack format.
  * Only the subset of the format is supported that is required for the communication
  * with the NAO.
  *
@@ -15,13 +15,81 @@
 
 namespace MsgPack
 {
-  static bool parseMap(const unsigned char*& p, const unsigned char* pEnd,
-                       const std::function<void(const std::string&, const unsigned char*)>& handleFloat,
-                       const std::function<void(const std::string&, const unsigned char*)>& handleUChar,
-                       const std::function<void(const std::string&, const unsigned char*, size_t size)>& handleString)
+  /** The size of the table used by the version of parse() with callbacks. */
+  static constexpr size_t maxNumOfEntriesPerPacket = 512;
+
+  /**
+   * Adds a value to the table of entries.
+   * @return Was there still space in the table?
+   */
+  static bool add(const char* name, size_t nameLength, int index, Type type, const unsigned char* value, size_t size,
+                  Entry* entries, size_t& numOfEntries, size_t maxNumOfEntries)
+  {
+    if(numOfEntries == maxNumOfEntries)
+    {
+      OUTPUT_WARNING("More than " << static_cast<unsigned>(maxNumOfEntries) << " values");
+      return false;
+    }
+    entries[numOfEntries++] = {name, nameLength, index, type, value, size};
+    return true;
+  }
+
+  /**
+   * Parses a single value that is either a positive fixint, a fixstr, or a float 32.
+   * @param p The address of the value. It is advanced behind the value.
+   * @param truncated Is set if the value does not end before pEnd.
+   * @return Was the value parsed and added?
+   */
+  static bool parseValue(const unsigned char*& p, const unsigned char* pEnd, const char* name, size_t nameLength, int index,
+                         Entry* entries, size_t& numOfEntries, size_t maxNumOfEntries, bool& truncated)
+  {
+    if(p >= pEnd)
+    {
+      truncated = true;
+      return false;
+    }
+    else if(!(*p & 0x80)) // msgpack positive fixint
+      return add(name, nameLength, index, positiveFixint, p++, 0, entries, numOfEntries, maxNumOfEntries);
+    else if((*p & 0xe0) == 0xa0) // msgpack fixstr
+    {
+      const size_t charsToRead = *p & 0x1f;
+      if(p + charsToRead >= pEnd)
+      {
+        truncated = true;
+        return false;
+      }
+      p += charsToRead + 1;
+      return add(name, nameLength, index, fixstr, p - charsToRead, charsToRead, entries, numOfEntries, maxNumOfEntries);
+    }
+    else if(*p == 0xca) // msgpack float 32
+    {
+      if(p + 4 >= pEnd)
+      {
+        truncated = true;
+        return false;
+      }
+      p += 5;
+      return add(name, nameLength, index, float32, p - 4, 0, entries, numOfEntries, maxNumOfEntries);
+    }
+    else
+      return false;
+  }
+
+  /**
+   * Parses a map of name and value pairs.
+   * @param p The address of the map. It is advanced behind the map or to where parsing failed.
+   * @param truncated Is set if the map does not end before pEnd.
+   * @return Was the map parsed completely?
+   */
+  static bool parseMap(const unsigned char*& p, const unsigned char* pEnd, Entry* entries, size_t& numOfEntries, size_t maxNumOfEntries,
+                       bool& truncated)
   {
-    if((p < pEnd && (*p & 0xf0) == 0x80)
-       || (p + 2 < pEnd && *p == 0xde))
+    if(p >= pEnd || (*p == 0xde && p + 2 >= pEnd))
+    {
+      truncated = true;
+      return false;
+    }
+    else if((*p & 0xf0) == 0x80 || *p == 0xde) // msgpack fixmap or map 16
     {
       int valuesToRead;
       if(*p == 0xde)
@@ -32,40 +100,38 @@ namespace MsgPack
       else
         valuesToRead = *p++ & 0x0f;
 
-      std::string name;
-      for(; valuesToRead > 0 && p < pEnd; --valuesToRead)
+      for(; valuesToRead > 0; --valuesToRead)
       {
         // read value name
         size_t charsToRead;
-        if((*p & 0xe0) == 0xa0) // msgpack fixstr
+        if(p >= pEnd || (*p == 0xd9 && p + 1 >= pEnd))
+        {
+          truncated = true;
+          return false;
+        }
+        else if((*p & 0xe0) == 0xa0) // msgpack fixstr
           charsToRead = *p & 0x1f;
-        else if(*p == 0xd9 && p + 1 < pEnd) // msgpack str 8
+        else if(*p == 0xd9) // msgpack str 8
           charsToRead = *++p;
         else
-          return false;;
+          return false;
 
-        if(++p + charsToRead > pEnd)
+        if(++p + charsToRead >= pEnd)
+        {
+          truncated = true;
           return false;
+        }
 
-        name.resize(charsToRead);
-        std::strncpy(&name[0], reinterpret_cast<const char*>(p), charsToRead);
+        const char* name = reinterpret_cast<const char*>(p);
         p += charsToRead;
 
         // read value
-        if(!(*p & 0x80)) // msgpack positive fixint
-          handleUChar(name, p++);
-        else if((*p & 0xe0) == 0xa0 && p + (charsToRead = (*p & 0x1f)) < pEnd) // msgpack fixstr
-        {
-          handleString(name, ++p, charsToRead);
-          p += charsToRead;
-        }
-        else if(*p == 0xca && p + 4 < pEnd) // msgpack float 32
+        if(*p == 0xdc && p + 2 >= pEnd)
         {
-          handleFloat(name, ++p);
-          p += 4;
+          truncated = true;
+          return false;
         }
-        else if((p < pEnd && (*p & 0xf0) == 0x90)
-                || (p + 2 < pEnd && *p == 0xdc)) // msgpack fixarray or array 16
+        else if((*p & 0xf0) == 0x90 || *p == 0xdc) // msgpack fixarray or array 16
         {
           int valuesToRead;
           if(*p == 0xdc)
@@ -75,49 +141,61 @@ namespace MsgPack
           }
           else
             valuesToRead = *p++ & 0x0f;
-          int i = 0;
-          for(; i < valuesToRead && p < pEnd; ++i)
-            // read values
-            if(!(*p & 0x80)) // msgpack positive fixint
-              handleUChar(name + ":" + std::to_string(i), p++);
-            else if((*p & 0xe0) == 0xa0 && p + (charsToRead = (*p & 0x1f)) < pEnd) // msgpack fixstr
-            {
-              handleString(name + ":" + std::to_string(i), ++p, charsToRead);
-              p += charsToRead;
-            }
-            else if(*p == 0xca && p + 4 < pEnd) // msgpack float 32
-            {
-              handleFloat(name + ":" + std::to_string(i), ++p);
-              p += 4;
-            }
-            else
+          for(int i = 0; i < valuesToRead; ++i)
+            if(!parseValue(p, pEnd, name, charsToRead, i, entries, numOfEntries, maxNumOfEntries, truncated))
               return false;
         }
-        else if(((*p & 0xf0) != 0x80 && *p != 0xde) // msgpack fixmap or map 16
-                || !parseMap(p, pEnd, handleFloat, handleUChar, handleString))
+        else if((*p & 0xf0) == 0x80 || *p == 0xde) // msgpack fixmap or map 16
+        {
+          if(!parseMap(p, pEnd, entries, numOfEntries, maxNumOfEntries, truncated))
+            return false;
+        }
+        else if(!parseValue(p, pEnd, name, charsToRead, -1, entries, numOfEntries, maxNumOfEntries, truncated))
           return false;
       }
-      if(valuesToRead > 0)
-      {
-        OUTPUT_WARNING(valuesToRead << " values were skipped");
-        return false;
-      }
-      else
-        return true;
+      return true;
     }
     else
       return false;
   }
 
+  size_t parse(const unsigned char* packet, size_t size, Entry* entries, size_t maxNumOfEntries, size_t& numOfEntries)
+  {
+    const unsigned char* p = packet;
+    const unsigned char* pEnd = packet + size;
+    bool truncated = false;
+    numOfEntries = 0;
+    if(parseMap(p, pEnd, entries, numOfEntries, maxNumOfEntries, truncated))
+      return static_cast<size_t>(p - packet);
+    else
+    {
+      if(!truncated)
+        OUTPUT_WARNING("Could not interpret byte at offset " << static_cast<int>(p - packet));
+      return 0;
+    }
+  }
+
   void parse(const unsigned char* packet, size_t size,
              const std::function<void(const std::string&, const unsigned char*)>& handleFloat,
              const std::function<void(const std::string&, const unsigned char*)>& handleUChar,
              const std::function<void(const std::string&, const unsigned char*, size_t size)>& handleString)
   {
-    const unsigned char* p = packet;
-    const unsigned char* pEnd = packet + size;
-    if(!parseMap(p, pEnd, handleFloat, handleUChar, handleString))
-      OUTPUT_WARNING("Could not interpret byte at offset " << static_cast<int>(p - packet));
+    Entry entries[maxNumOfEntriesPerPacket];
+    size_t numOfEntries;
+    parse(packet, size, entries, maxNumOfEntriesPerPacket, numOfEntries);
+    for(size_t i = 0; i < numOfEntries; ++i)
+    {
+      const Entry& entry = entries[i];
+      std::string name(entry.name, entry.nameLength);
+      if(entry.index >= 0)
+        name += ":" + std::to_string(entry.index);
+      if(entry.type == positiveFixint)
+        handleUChar(name, entry.value);
+      else if(entry.type == fixstr)
+        handleString(name, entry.value, entry.size);
+      else
+        handleFloat(name, entry.value);
+    }
   }
 
   void writeMapHeader(size_t numOfPairs, unsigned char*& p)
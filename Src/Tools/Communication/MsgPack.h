@@ -1,7 +1,7 @@
 /**
  * @file MsgPack.h
  *
- * This file declares a method that parses a packet according to the MsgPack format
+ * This file declares methods that parse a packet according to the MsgPack format
  * (https://msgpack.org). Only the subset of the format is supported that is required
  *  for the communication with the NAO.
  *
@@ -11,11 +11,68 @@
 #pragma once
 
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <string>
 
 namespace MsgPack
 {
+  /** The formats of values supported by the parser. */
+  enum Type : unsigned char
+  {
+    positiveFixint,
+    fixstr,
+    float32
+  };
+
+  /**
+   * A value found in a packet. All pointers point into the packet parsed, i.e.
+   * they are only valid as long as the packet exists. Since LoLA always sends
+   * packets with the same layout, the addresses determined for the first packet
+   * can also be used to read the values from all further packets.
+   */
+  struct Entry
+  {
+    const char* name; /**< The name of the map entry. It is not null-terminated. */
+    size_t nameLength; /**< The number of characters of the name. */
+    int index; /**< The index of the value in its array or -1 if the value is not part of an array. */
+    Type type; /**< The format of the value. */
+    const unsigned char* value; /**< The address of the value. Floats are still big endian. */
+    size_t size; /**< The number of characters of a fixstr value. */
+
+    /**
+     * Checks whether this entry has a certain name.
+     * @param name A null-terminated name.
+     * @return Are the names the same?
+     */
+    bool is(const char* name) const
+    {
+      return std::strlen(name) == nameLength && !std::memcmp(this->name, name, nameLength);
+    }
+  };
+
+  /**
+   * Parse a packet according the MsgPack format without allocating any memory.
+   * The same subset of the format is supported as by the other version of this
+   * method. The values found are stored in a table in the order in which they
+   * appear in the packet.
+   * @param packet The packet to parse.
+   * @param size The length of the packet in bytes.
+   * @param entries The table that is filled with the values found.
+   * @param maxNumOfEntries The number of entries the table can store. If the packet
+   *                        contains more values, parsing fails.
+   * @param numOfEntries The number of entries filled is returned here. If parsing
+   *                     failed, these are only the entries found before the error
+   *                     occurred.
+   * @return The number of bytes of the map parsed, i.e. the size of the packet
+   *         at the beginning of the data. It can be smaller than the size
+   *         passed. 0 if parsing failed, which is also the case if the data
+   *         ends before the map does. Only in the latter case, no warning is
+   *         issued, because the rest of the packet may not have been received
+   *         yet.
+   */
+  size_t parse(const unsigned char* packet, size_t size, Entry* entries, size_t maxNumOfEntries, size_t& numOfEntries);
+
   /**
    * Parse a packet according the MsgPack format. The packet is expected to contain
    * a map (format "map 16") of name and value pairs. For names, only the formats
@@ -0,0 +1,54 @@
+/**
+ * @file DebugBenchmark.cpp
+ *
+ * This file implements a function that measures how much time the debugging
+ * macros cost per check if the corresponding debug requests are disabled.
+ */
+
+#include "DebugBenchmark.h"
+#include "Tools/Debugging/DebugDrawings.h"
+#include "Tools/Debugging/Modify.h"
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+#define _DEBUG_BENCHMARK_10(site) site(0) site(1) site(2) site(3) site(4) site(5) site(6) site(7) site(8) site(9)
+
+#define _DEBUG_BENCHMARK_RESPONSE(n) DEBUG_RESPONSE("benchmark:debugRequest" #n) ++counter;
+#define _DEBUG_BENCHMARK_DRAWING(n) COMPLEX_DRAWING("benchmark:drawing" #n) ++counter;
+#define _DEBUG_BENCHMARK_MODIFY(n) MODIFY("benchmark:modify" #n, counter);
+#define _DEBUG_BENCHMARK_BY_NAME(n) if(Global::getDebugRequestTable().isActive("benchmark:debugRequest" #n)) ++counter;
+#define _DEBUG_BENCHMARK_BY_STRING(n) if(table.find("benchmark:modify" #n) != table.end()) ++counter;
+
+void DebugBenchmark::run()
+{
+  using Clock = std::chrono::steady_clock;
+  constexpr int iterations = 10000;
+  constexpr double checks = iterations * 10.0;
+  int counter = 0;
+
+  // Each iteration executes every call site once to warm up the caches.
+  const auto measure = [&](const auto& iteration)
+  {
+    iteration();
+    const Clock::time_point start = Clock::now();
+    for(int i = 0; i < iterations; ++i)
+      iteration();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / checks;
+  };
+
+  const double response = measure([&] { _DEBUG_BENCHMARK_10(_DEBUG_BENCHMARK_RESPONSE) });
+  const double drawing = measure([&] { _DEBUG_BENCHMARK_10(_DEBUG_BENCHMARK_DRAWING) });
+  const double modify = measure([&] { _DEBUG_BENCHMARK_10(_DEBUG_BENCHMARK_MODIFY) });
+
+  // The previous implementations: a hash map lookup by character pointer and one by std::string.
+  std::unordered_map<std::string, char*> table;
+  table["other"] = nullptr;
+  const double byName = measure([&] { _DEBUG_BENCHMARK_10(_DEBUG_BENCHMARK_BY_NAME) });
+  const double byString = measure([&] { _DEBUG_BENCHMARK_10(_DEBUG_BENCHMARK_BY_STRING) });
+
+  OUTPUT_TEXT("Debug overhead per check (all disabled, " << counter << " active):");
+  OUTPUT_TEXT("  DEBUG_RESPONSE: " << response << " ns (lookup by name: " << byName << " ns)");
+  OUTPUT_TEXT("  COMPLEX_DRAWING: " << drawing << " ns");
+  OUTPUT_TEXT("  MODIFY: " << modify << " ns (lookup by std::string: " << byString << " ns)");
+}
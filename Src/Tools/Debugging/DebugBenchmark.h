@@ -0,0 +1,18 @@
+/**
+ * @file DebugBenchmark.h
+ *
+ * This file declares a function that measures how much time the debugging
+ * macros cost per check if the corresponding debug requests are disabled.
+ */
+
+#pragma once
+
+namespace DebugBenchmark
+{
+  /**
+   * Executes the macros DEBUG_RESPONSE, COMPLEX_DRAWING and MODIFY many times
+   * in the current thread and compares their duration with the lookups by
+   * name that they replace. The results are printed as text messages.
+   */
+  void run();
+}
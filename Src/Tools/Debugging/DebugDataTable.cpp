@@ -14,8 +14,8 @@
 
 DebugDataTable::~DebugDataTable()
 {
-  for(std::unordered_map<std::string, char*>::iterator iter = table.begin(); iter != table.end(); ++iter)
-    delete[] iter->second;
+  for(char* entry : table)
+    delete[] entry;
 }
 
 void DebugDataTable::processChangeRequest(InMessage& in)
@@ -23,23 +23,15 @@ void DebugDataTable::processChangeRequest(InMessage& in)
   std::string name;
   char change;
   in.bin >> name >> change;
-  std::unordered_map<std::string, char*>::iterator iter = table.find(name);
+  const size_t slot = DebugRequestTable::getSlot("debug data:" + name);
+  if(slot >= table.size())
+    table.resize(slot + 1, nullptr);
+  delete[] table[slot];
+  table[slot] = nullptr;
   if(change)
   {
     int size = in.getBytesLeft();
-    char* buffer = new char[size];
-    in.bin.read(buffer, size);
-    if(iter == table.end())
-      table[name] = buffer;
-    else
-    {
-      delete[] iter->second;
-      iter->second = buffer;
-    }
-  }
-  else if(iter != table.end())
-  {
-    delete[] iter->second;
-    table.erase(iter);
+    table[slot] = new char[size];
+    in.bin.read(table[slot], size);
   }
 }
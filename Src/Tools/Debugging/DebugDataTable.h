@@ -11,8 +11,10 @@
 
 #pragma once
 
+#include "Tools/Debugging/DebugRequest.h"
 #include "Tools/Streams/InStreams.h"
 #include <string>
+#include <vector>
 
 class InMessage;
 
@@ -20,11 +22,15 @@ class InMessage;
  * @class DebugDataTable
  *
  * A class that maintains the debug data table.
+ * The entries are indexed by the slots of the debug requests
+ * "debug data:<name>" (cf. DebugRequestTable::getSlot). Therefore, checking
+ * whether an object was modified only requires an array access if the slot
+ * was cached by the caller.
  */
 class DebugDataTable final
 {
 private:
-  std::unordered_map<std::string, char*> table;
+  std::vector<char*> table; /**< The streamed data of the modified objects, indexed by slot. */
 
 public:
   /**
@@ -37,25 +43,27 @@ public:
   ~DebugDataTable();
 
   /**
-   * Registers the object with the debug data table and updates the object if the
-   * respective entry in the table has been modified through RobotControl.
+   * Updates the object if the respective entry in the table has been modified
+   * through RobotControl.
+   * @param slot The slot of the debug request "debug data:<name>".
+   * @param t The object.
+   * @param once Remove the entry after it was used?
    */
-  template<typename T> void updateObject(const char* name, T& t, bool once);
+  template<typename T> void updateObject(size_t slot, T& t, bool once);
   void processChangeRequest(InMessage& in);
 };
 
-template<typename T> void DebugDataTable::updateObject(const char* name, T& t, bool once)
+template<typename T> void DebugDataTable::updateObject(size_t slot, T& t, bool once)
 {
   // Find entry in debug data table
-  std::unordered_map<std::string, char*>::iterator iter = table.find(name);
-  if(iter != table.end())
+  if(slot < table.size() && table[slot])
   {
-    InBinaryMemory stream(iter->second);
+    InBinaryMemory stream(table[slot]);
     stream >> t;
     if(once)
     {
-      delete[] iter->second;
-      table.erase(iter);
+      delete[] table[slot];
+      table[slot] = nullptr;
     }
   }
 }
@@ -31,8 +31,17 @@ void DrawingManager::addDrawingId(const char* name, const char* typeName)
   }
 }
 
+void DrawingManager::addDrawingIdSlow(size_t slot, const char* name, const char* typeName)
+{
+  addDrawingId(name, typeName);
+  if(slot >= added.size())
+    added.resize(slot + 1, 0);
+  added[slot] = 1;
+}
+
 void DrawingManager::clear()
 {
+  added.clear();
   types.clear();
   drawings.clear();
   strings.clear();
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 
 #include "Tools/Debugging/ColorRGBA.h"
 #include "Tools/Debugging/Debugging.h"
@@ -52,6 +53,20 @@ public:
   DrawingManager(const DrawingManager&) = delete;
   void clear();
   void addDrawingId(const char* name, const char* typeName);
+
+  /**
+   * Adds a drawing if it was not added before. The check only requires an
+   * array access.
+   * @param slot The slot of the debug request of the drawing.
+   * @param name The name of the drawing.
+   * @param typeName The name of the type of the drawing.
+   */
+  void addDrawingId(size_t slot, const char* name, const char* typeName)
+  {
+    if(slot >= added.size() || !added[slot])
+      addDrawingIdSlow(slot, name, typeName);
+  }
+
   char getDrawingId(const char* name) const;
   const char* getDrawingType(const char* name) const;
   const char* getDrawingName(char id) const;
@@ -61,6 +76,9 @@ public:
 
 private:
   const char* getTypeName(char id) const;
+  void addDrawingIdSlow(size_t slot, const char* name, const char* typeName);
+
+  std::vector<char> added; /**< Which drawings were already added? Indexed by the slots of their debug requests. */
 
   std::unordered_map<std::string, const char*> strings;
   std::unordered_map<const char*, char> types;
@@ -121,7 +139,8 @@ inline const char* DrawingManager::getTypeName(char id) const
  * and executes the following block if the drawing is requested.
  */
 #define DEBUG_DRAWING(id, type) \
-  if(Global::getDrawingManager().addDrawingId(id, type), _debugRequestActive("debug drawing:" id))
+  if(const size_t _slot = DEBUG_REQUEST_SLOT("debug drawing:" id); \
+     Global::getDrawingManager().addDrawingId(_slot, id, type), _debugRequestActive("debug drawing:" id, _slot))
 
 /**
  * A macro that declares
@@ -131,7 +150,7 @@ inline const char* DrawingManager::getTypeName(char id) const
 #define DECLARE_DEBUG_DRAWING(id, type) \
   do \
   { \
-    Global::getDrawingManager().addDrawingId(id, type); \
+    Global::getDrawingManager().addDrawingId(DEBUG_REQUEST_SLOT("debug drawing:" id), id, type); \
     DECLARE_DEBUG_RESPONSE("debug drawing:" id); \
   } \
   while(false)
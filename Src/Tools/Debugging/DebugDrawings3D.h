@@ -47,7 +47,8 @@ class DrawingManager3D : public DrawingManager {};
  * and executes the following block if the drawing is requested.
  */
 #define DEBUG_DRAWING3D(id, type) \
-  if(Global::getDrawingManager3D().addDrawingId(id, type), _debugRequestActive("debug drawing 3d:" id))
+  if(const size_t _slot = DEBUG_REQUEST_SLOT("debug drawing 3d:" id); \
+     Global::getDrawingManager3D().addDrawingId(_slot, id, type), _debugRequestActive("debug drawing 3d:" id, _slot))
 
 /**
  * A macro that declares.
@@ -58,7 +59,7 @@ class DrawingManager3D : public DrawingManager {};
 #define DECLARE_DEBUG_DRAWING3D(id, type) \
   do \
   { \
-    Global::getDrawingManager3D().addDrawingId(id, type); \
+    Global::getDrawingManager3D().addDrawingId(DEBUG_REQUEST_SLOT("debug drawing 3d:" id), id, type); \
     DECLARE_DEBUG_RESPONSE("debug drawing 3d:" id); \
   } \
   while(false)
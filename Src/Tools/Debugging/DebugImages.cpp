@@ -6,10 +6,14 @@
  */
 
 #include "DebugImages.h"
+#include "Representations/Infrastructure/JPEGImage.h"
 #include "Tools/ImageProcessing/AVX.h"
 #include "Tools/ImageProcessing/ColorModelConversions.h"
 #include "Tools/Global.h"
 #include <asmjit/asmjit.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
 
 using namespace asmjit;
 
@@ -842,3 +846,148 @@ void DebugImageConverter::convertToBGRA(const DebugImage& src, void* dest)
 }
 
 #endif
+
+/**
+ * Encodes the byte-wise differences of each row to the previous row with
+ * PackBits-style run-length encoding: a header byte h < 128 is followed by
+ * h + 1 literal bytes, a header byte h > 128 is followed by a single byte
+ * that is repeated 257 - h times.
+ * @param src The bytes of the image.
+ * @param rowSize The number of bytes per row.
+ * @param size The number of bytes of the whole image.
+ * @param dest The encoded bytes.
+ */
+static void encodeRowDelta(const unsigned char* src, size_t rowSize, size_t size, std::vector<unsigned char>& dest)
+{
+  const auto delta = [src, rowSize](size_t i) {return static_cast<unsigned char>(i < rowSize ? src[i] : src[i] - src[i - rowSize]);};
+  dest.clear();
+  dest.reserve(size + size / 128 + 1);
+  size_t i = 0;
+  while(i < size)
+  {
+    const unsigned char value = delta(i);
+    size_t run = 1;
+    while(i + run < size && run < 128 && delta(i + run) == value)
+      ++run;
+    if(run >= 3)
+    {
+      dest.push_back(static_cast<unsigned char>(257 - run));
+      dest.push_back(value);
+      i += run;
+    }
+    else
+    {
+      // Collect literals until the next run of at least three equal bytes starts.
+      const size_t start = i;
+      do
+        ++i;
+      while(i < size && i - start < 128 && !(i + 2 < size && delta(i) == delta(i + 1) && delta(i) == delta(i + 2)));
+      dest.push_back(static_cast<unsigned char>(i - start - 1));
+      for(size_t j = start; j < i; ++j)
+        dest.push_back(delta(j));
+    }
+  }
+}
+
+/**
+ * Decodes an image encoded by encodeRowDelta.
+ * @param src The encoded bytes.
+ * @param srcSize The number of encoded bytes.
+ * @param rowSize The number of bytes per row.
+ * @param size The number of bytes of the whole image.
+ * @param dest The bytes of the image.
+ */
+static void decodeRowDelta(const unsigned char* src, size_t srcSize, size_t rowSize, size_t size, unsigned char* dest)
+{
+  const unsigned char* const srcEnd = src + srcSize;
+  size_t i = 0;
+  while(src < srcEnd && i < size)
+  {
+    const unsigned char header = *src++;
+    if(header < 128)
+    {
+      const size_t count = std::min({static_cast<size_t>(header) + 1, size - i, static_cast<size_t>(srcEnd - src)});
+      std::memcpy(dest + i, src, count);
+      src += count;
+      i += count;
+    }
+    else if(header > 128 && src < srcEnd)
+    {
+      const size_t count = std::min(static_cast<size_t>(257 - header), size - i);
+      std::memset(dest + i, *src++, count);
+      i += count;
+    }
+  }
+  std::memset(dest + i, 0, size - i);
+  for(i = rowSize; i < size; ++i)
+    dest[i] = static_cast<unsigned char>(dest[i] + dest[i - rowSize]);
+}
+
+void DebugImage::readCompressed(In& stream)
+{
+  STREAM(type);
+  STREAM(width);
+  STREAM(height);
+
+  unsigned char streamedEncoding;
+  stream >> streamedEncoding;
+  encoding = static_cast<Encoding>(streamedEncoding);
+  if(encoding == jpeg)
+  {
+    JPEGImage jpegImage;
+    CameraImage cameraImage;
+    stream >> jpegImage;
+    jpegImage.toCameraImage(cameraImage);
+    from(static_cast<const Image<PixelTypes::YUYVPixel>&>(cameraImage));
+    return;
+  }
+
+  const size_t size = width * height * PixelTypes::pixelSize(type);
+  if(isReference || !data || size > maxSize)
+  {
+    if(!isReference && data)
+      Memory::alignedFree(data);
+    isReference = false;
+    data = Memory::alignedMalloc(size, 32);
+    maxSize = size;
+  }
+
+  if(encoding == rowDelta)
+  {
+    unsigned encodedSize;
+    stream >> encodedSize;
+    std::vector<unsigned char> encoded(encodedSize);
+    stream.read(encoded.data(), encodedSize);
+    decodeRowDelta(encoded.data(), encodedSize, width * PixelTypes::pixelSize(type), size, static_cast<unsigned char*>(data));
+  }
+  else
+    stream.read(data, size);
+}
+
+void DebugImage::writeCompressed(Out& stream) const
+{
+  STREAM(type);
+  STREAM(width);
+  STREAM(height);
+
+  if(type == PixelTypes::YUYV)
+  {
+    CameraImage cameraImage;
+    cameraImage.setReference(width, height, data);
+    stream << static_cast<unsigned char>(jpeg) << JPEGImage(cameraImage);
+    return;
+  }
+
+  const size_t size = width * height * PixelTypes::pixelSize(type);
+  std::vector<unsigned char> encoded;
+  encodeRowDelta(static_cast<const unsigned char*>(data), width * PixelTypes::pixelSize(type), size, encoded);
+  if(encoded.size() < size)
+  {
+    stream << static_cast<unsigned char>(rowDelta) << static_cast<unsigned>(encoded.size());
+    stream.write(encoded.data(), encoded.size());
+    return;
+  }
+
+  stream << static_cast<unsigned char>(raw);
+  stream.write(data, size);
+}
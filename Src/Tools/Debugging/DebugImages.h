@@ -13,10 +13,22 @@
 #include "Tools/ImageProcessing/PixelTypes.h"
 #include "Tools/ImageProcessing/Image.h"
 #include "Platform/Memory.h"
+#include "Tools/Streams/Enum.h"
 #include <type_traits>
 
 struct DebugImage : public Streamable
 {
+  /** How the pixels are encoded in idCompressedDebugImage messages. */
+  ENUM(Encoding,
+  {,
+    raw, /**< The pixels are streamed unchanged. */
+    rowDelta, /**< The byte-wise differences to the previous row are run-length encoded. */
+    jpeg, /**< YUYV images are JPEG-compressed (lossy). */
+  });
+
+  /** Images are compressed if the throughput of the debug connection in bytes per second is below this value. */
+  static constexpr float compressionThreshold = 10e6f;
+
 private:
   size_t maxSize = 0;
 
@@ -27,6 +39,7 @@ public:
   unsigned short height;
   bool isReference;
   PixelTypes::PixelType type;
+  Encoding encoding = raw; /**< How the image was encoded when it was read. */
 
   DebugImage() : data(nullptr), isReference(false) {}
   DebugImage(const Image<PixelTypes::RGBPixel>& image)
@@ -141,6 +154,20 @@ public:
     return type == PixelTypes::YUYV ? width * 2 : width;
   }
 
+  /**
+   * Read this object from a stream in the format of idCompressedDebugImage.
+   * @param stream The stream from which the object is read.
+   */
+  void readCompressed(In& stream);
+
+  /**
+   * Write this object to a stream in the format of idCompressedDebugImage.
+   * YUYV images are JPEG-compressed, all others are row-delta-encoded if that
+   * is smaller.
+   * @param stream The stream to which the object is written.
+   */
+  void writeCompressed(Out& stream) const;
+
 protected:
   /**
    * Read this object from a stream.
@@ -162,6 +189,7 @@ protected:
       maxSize = size;
     }
     stream.read(data, size);
+    encoding = raw;
   }
 
   /**
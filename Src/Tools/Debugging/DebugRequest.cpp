@@ -11,7 +11,6 @@
 #include <cstdio>
 
 #include "DebugRequest.h"
-#include "Platform/BHAssert.h"
 
 DebugRequestTable::DebugRequestTable()
 {
@@ -26,50 +25,34 @@ void DebugRequestTable::addRequest(const DebugRequest& debugRequest)
   if(debugRequest.name == "poll")
   {
     pollCounter = 3;
-    polled.clear();
+    polled.assign(polled.size(), 0);
   }
   else if(debugRequest.name == "disableAll")
     clear();
   else
   {
     std::unordered_map<std::string, size_t>::const_iterator i = slowIndex.find(debugRequest.name);
-    if(i != slowIndex.end())
-      enabled[i->second] = debugRequest.enable ? 1 : 0;
-    else
-    {
-      slowIndex[debugRequest.name] = enabled.size();
-      enabled.push_back(debugRequest.enable ? 1 : 0);
-    }
+    const size_t slot = i != slowIndex.end() ? i->second : (slowIndex[debugRequest.name] = getSlot(debugRequest.name));
+    if(slot >= enabled.size())
+      enabled.resize(slot + 1, 0);
+    enabled[slot] = debugRequest.enable ? 1 : 0;
   }
 }
 
 bool DebugRequestTable::isActiveSlow(const char* name)
 {
-  std::unordered_map<std::string, size_t>::const_iterator j = slowIndex.find(name);
-  size_t k;
-  if(j != slowIndex.end())
-    k = j->second;
-  else
-  {
-    k = enabled.size();
-    slowIndex[name] = k;
-    enabled.push_back(0);
-  }
-  fastIndex[name] = k;
-  return enabled[k] != 0;
-}
-
-void DebugRequestTable::disable(const char* name)
-{
-  ASSERT(fastIndex.find(name) != fastIndex.end());
-  enabled[fastIndex[name]] = 0;
+  const size_t slot = getSlot(name);
+  fastIndex[name] = slot;
+  return isActive(slot);
 }
 
-bool DebugRequestTable::notYetPolled(const char* name)
+bool DebugRequestTable::notYetPolled(size_t slot)
 {
-  if(polled.find(name) == polled.end())
+  if(slot >= polled.size())
+    polled.resize(slot + 1, 0);
+  if(!polled[slot])
   {
-    polled.insert(name);
+    polled[slot] = 1;
     return true;
   }
   else
@@ -78,9 +61,8 @@ bool DebugRequestTable::notYetPolled(const char* name)
 
 void DebugRequestTable::clear()
 {
-  fastIndex.clear();
   slowIndex.clear();
-  enabled.clear();
+  enabled.assign(enabled.size(), 0);
 }
 
 void DebugRequestTable::print(const char* message)
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "Tools/Streams/AutoStreamable.h"
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -36,19 +37,22 @@ inline DebugRequest::DebugRequest(const std::string& name, bool enable)
  * @class DebugRequestTable
  *
  * A class that maintains the table of currently active debug requests.
- * It provides a fast access based on character pointers and a slower one based
- * on strings.
+ * The names of all debug requests are mapped to slots that are unique in the
+ * whole process. The macros determine the slot of their request once per call
+ * site and then access the flags of the table of the current thread directly.
+ * In addition, there is a fast access based on character pointers and a slower
+ * one based on strings.
  */
 class DebugRequestTable final
 {
 private:
-  std::vector<char> enabled; /**< Are requests enabled or disabled? */
-  std::unordered_map<const char*, size_t> fastIndex; /**< Maps char pointers to entries of vector "enabled". */
-  std::unordered_map<std::string, size_t> slowIndex; /**< Maps strings to entries of vector "enabled". */
-  std::unordered_set<const char*> polled; /**< Which requests were already published during this polling phase? */
+  std::vector<char> enabled; /**< Are requests enabled or disabled? Indexed by slot. */
+  std::unordered_map<const char*, size_t> fastIndex; /**< Maps char pointers to slots. */
+  std::unordered_map<std::string, size_t> slowIndex; /**< Maps the names of the requests known to this table to slots. */
+  std::vector<char> polled; /**< Which requests were already published during this polling phase? Indexed by slot. */
 
   /**
-   * Uses the slow index to find request and updates the fast index.
+   * Determines the slot of a request and updates the fast index.
    * @param name The name of the debug request.
    * @return Is it active?
    */
@@ -63,12 +67,28 @@ public:
   /** No copy constructor. */
   DebugRequestTable(const DebugRequestTable&) = delete;
 
+  /**
+   * Returns the process-wide slot of a debug request. Slots are never
+   * released, i.e. the result can be cached. This method is thread-safe,
+   * but slow.
+   * @param name The name of the request.
+   * @return The slot.
+   */
+  static size_t getSlot(const std::string& name);
+
   /**
    * Adds or updates a certain debug request.
    * @param debugRequest The debug request that is updated in the table.
    */
   void addRequest(const DebugRequest& debugRequest);
 
+  /**
+   * Is a debug request active?
+   * @param slot The slot of the request.
+   * @return Is it active?
+   */
+  bool isActive(size_t slot) const { return slot < enabled.size() && enabled[slot] != 0; }
+
   /**
    * Is a debug request active?
    * @param name The name of the request.
@@ -78,18 +98,21 @@ public:
 
   /**
    * Disable a debug request.
-   * Note: isActive must have been called before for this request.
-   * @param name The name of the request to disable.
+   * @param slot The slot of the request to disable.
    */
-  void disable(const char* name);
+  void disable(size_t slot)
+  {
+    if(slot < enabled.size())
+      enabled[slot] = 0;
+  }
 
   /**
    * Has this request still to be published during this polling phase?
    * This also marks the request as polled.
-   * @param name The name of the request.
+   * @param slot The slot of the request.
    * @return Was the request not yet polled?
    */
-  bool notYetPolled(const char* name);
+  bool notYetPolled(size_t slot);
 
   /** Clear the table. */
   void clear();
@@ -104,8 +127,31 @@ public:
   friend class RobotTextConsole;
 };
 
+inline size_t DebugRequestTable::getSlot(const std::string& name)
+{
+  static std::mutex mutex;
+  static std::unordered_map<std::string, size_t> slots;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  return slots.emplace(name, slots.size()).first->second;
+}
+
 inline bool DebugRequestTable::isActive(const char* name)
 {
   std::unordered_map<const char*, size_t>::const_iterator i = fastIndex.find(name);
-  return i != fastIndex.end() ? enabled[i->second] != 0 : isActiveSlow(name);
+  return i != fastIndex.end() ? isActive(i->second) : isActiveSlow(name);
 }
+
+/**
+ * Determines the slot of a debug request only once per call site. The
+ * lambda expression is unique for each place where the macro is used.
+ * Therefore, its static variable caches the slot of exactly one request.
+ * @param id The name of the debug request. Must be a string constant.
+ * @return The process-wide slot of the debug request.
+ */
+#define DEBUG_REQUEST_SLOT(id) \
+  ([]() -> size_t \
+  { \
+    static const size_t _slot = DebugRequestTable::getSlot(id); \
+    return _slot; \
+  }())
@@ -10,9 +10,7 @@
 #pragma once
 
 #include "Tools/MessageQueue/OutMessage.h"
-#ifndef TARGET_TOOL
 #include "Tools/Debugging/DebugRequest.h"
-#endif
 #include "Tools/Global.h"
 
 #if defined TARGET_TOOL || (defined TARGET_ROBOT && defined NDEBUG)
@@ -116,13 +114,15 @@
 /**
  * Register debug request if required and check whether it is active.
  * @param id The name of the debug request.
+ * @param slot The slot of the debug request.
  * @return Is it active?
  */
-inline bool _debugRequestActive(const char* id)
+inline bool _debugRequestActive(const char* id, size_t slot)
 {
-  if(Global::getDebugRequestTable().pollCounter && Global::getDebugRequestTable().notYetPolled(id))
-    OUTPUT(idDebugResponse, text, id << Global::getDebugRequestTable().isActive(id));
-  return Global::getDebugRequestTable().isActive(id);
+  DebugRequestTable& debugRequestTable = Global::getDebugRequestTable();
+  if(debugRequestTable.pollCounter && debugRequestTable.notYetPolled(slot))
+    OUTPUT(idDebugResponse, text, id << debugRequestTable.isActive(slot));
+  return debugRequestTable.isActive(slot);
 }
 
 /**
@@ -131,36 +131,33 @@ inline bool _debugRequestActive(const char* id)
  * @param id The id of the debugging switch
  */
 #define DECLARE_DEBUG_RESPONSE(id) \
-  do \
-    if(Global::getDebugRequestTable().pollCounter && Global::getDebugRequestTable().notYetPolled(id)) \
-      OUTPUT(idDebugResponse, text, id << Global::getDebugRequestTable().isActive(id)); \
-  while(false)
+  static_cast<void>(_debugRequestActive(id, DEBUG_REQUEST_SLOT(id)))
 
 /**
  * A debugging switch, allowing the enabling or disabling of the following block.
  * @param id The id of the debugging switch
  */
 #define DEBUG_RESPONSE(id) \
-  if(_debugRequestActive(id))
+  if(_debugRequestActive(id, DEBUG_REQUEST_SLOT(id)))
 
 /**
  * A debugging switch, allowing the non-recurring execution of the following block.
  * @param id The id of the debugging switch
  */
 #define DEBUG_RESPONSE_ONCE(id) \
-  if(_debugRequestActive(id) && (Global::getDebugRequestTable().disable(id), true))
+  if(const size_t _slot = DEBUG_REQUEST_SLOT(id); _debugRequestActive(id, _slot) && (Global::getDebugRequestTable().disable(_slot), true))
 
 /**
  * A debugging switch, allowing the enabling or disabling of the block that follows.
  * @param id The id of the debugging switch
  */
 #define DEBUG_RESPONSE_NOT(id) \
-  if(!_debugRequestActive(id))
+  if(!_debugRequestActive(id, DEBUG_REQUEST_SLOT(id)))
 
 /**
  * Execute following block if debug request is active.
  * The request is not pollable.
  */
 #define DECLARED_DEBUG_RESPONSE(id) \
-  if(Global::getDebugRequestTable().isActive(id))
+  if(Global::getDebugRequestTable().isActive(DEBUG_REQUEST_SLOT(id)))
 #endif // TARGET_TOOL
@@ -33,7 +33,7 @@
 #define _MODIFY(id, object, once) \
   do \
   { \
-    Global::getDebugDataTable().updateObject(id, object, once); \
+    Global::getDebugDataTable().updateObject(DEBUG_REQUEST_SLOT("debug data:" id), object, once); \
     DEBUG_RESPONSE_ONCE("debug data:" id) \
       OUTPUT(idDebugDataResponse, bin, id << TypeRegistry::demangle(typeid(object).name()) << object); \
   } \
@@ -15,14 +15,16 @@
 class Stopwatch
 {
   const char* const name; /**< The name of the plot. */
+  const size_t slot; /**< The slot of the debug request of the plot. */
   bool running = true; /**< Should the stopwatch still be running? */
 
 public:
   /**
    * Start the stopwatch.
    * @param name The name of the plot.
+   * @param slot The slot of the debug request of the plot.
    */
-  Stopwatch(const char* name) : name(name) {Global::getTimingManager().startTiming(name + 15);}
+  Stopwatch(const char* name, size_t slot) : name(name), slot(slot) {Global::getTimingManager().startTiming(name + 15);}
 
   /** Stop the stopwatch.*/
   ~Stopwatch()
@@ -32,8 +34,12 @@ public:
 #else
     static_cast<void>(name);
 #endif
-    DEBUG_RESPONSE(name)
+#if !defined TARGET_TOOL && (!defined TARGET_ROBOT || !defined NDEBUG)
+    if(_debugRequestActive(name, slot))
       OUTPUT(idPlot, bin, (name + 5) << static_cast<float>(time) * 0.001f);
+#else
+    static_cast<void>(slot);
+#endif
   }
 
   /**< Should the stopwatch still be running? */
@@ -45,4 +51,4 @@ public:
  * @param name The name of the stopwatch.
  */
 #define STOPWATCH(name) \
-  for(Stopwatch _stopwatch("plot:stopwatch:" name); _stopwatch.isRunning();)
+  for(Stopwatch _stopwatch("plot:stopwatch:" name, DEBUG_REQUEST_SLOT("plot:stopwatch:" name)); _stopwatch.isRunning();)
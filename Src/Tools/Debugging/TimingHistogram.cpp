@@ -0,0 +1,63 @@
+/**
+ * @file TimingHistogram.cpp
+ *
+ * This file implements a histogram of durations with log-linear buckets.
+ */
+
+#include "TimingHistogram.h"
+#include "Tools/Streams/InOut.h"
+#include <algorithm>
+#include <cmath>
+
+void TimingHistogram::clear()
+{
+  counts.fill(0);
+  total = 0;
+}
+
+unsigned TimingHistogram::getPercentile(float percentile) const
+{
+  if(!total)
+    return 0;
+
+  // The nearest-rank method.
+  const unsigned rank = std::max(1u, static_cast<unsigned>(std::ceil(percentile * static_cast<float>(total))));
+  unsigned count = 0;
+  for(unsigned i = 0; i < numOfBuckets - 1; ++i)
+  {
+    count += counts[i];
+    if(count >= rank)
+      return getUpperBound(i);
+  }
+  return getLowerBound(numOfBuckets - 1);
+}
+
+void TimingHistogram::write(Out& stream) const
+{
+  unsigned short numOfNonEmptyBuckets = 0;
+  for(unsigned count : counts)
+    if(count)
+      ++numOfNonEmptyBuckets;
+  stream << numOfNonEmptyBuckets;
+  for(unsigned i = 0; i < numOfBuckets; ++i)
+    if(counts[i])
+      stream << static_cast<unsigned short>(i) << counts[i];
+}
+
+void TimingHistogram::read(In& stream)
+{
+  clear();
+  unsigned short numOfNonEmptyBuckets;
+  stream >> numOfNonEmptyBuckets;
+  for(unsigned short i = 0; i < numOfNonEmptyBuckets; ++i)
+  {
+    unsigned short index;
+    unsigned count;
+    stream >> index >> count;
+    if(index < numOfBuckets)
+    {
+      counts[index] = count;
+      total += count;
+    }
+  }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file TimingHistogram.h
+ *
+ * This file declares a histogram of durations with log-linear buckets, similar
+ * to an HDR histogram: Each power of two is divided into the same number of
+ * linear buckets. Therefore, the relative error of all values is the same
+ * (at most 1 / 16) while only a few hundred buckets cover durations from 1 µs
+ * up to 16 s.
+ */
+
+#pragma once
+
+#include <array>
+#include <limits>
+
+class In;
+class Out;
+
+class TimingHistogram
+{
+public:
+  static constexpr unsigned subBucketBits = 4; /**< The binary logarithm of the number of buckets per power of two. */
+  static constexpr unsigned subBuckets = 1 << subBucketBits; /**< The number of buckets per power of two. */
+  static constexpr unsigned maxExponent = 24; /**< All values >= 2^maxExponent are counted in the last bucket. */
+  static constexpr unsigned numOfBuckets = (maxExponent - subBucketBits + 1) * subBuckets + 1; /**< The number of buckets including the one for all larger values. */
+
+  /**
+   * Adds a value.
+   * @param value The value, usually in µs.
+   */
+  void add(unsigned value)
+  {
+    ++counts[getIndex(value)];
+    ++total;
+  }
+
+  /** Removes all values. */
+  void clear();
+
+  /** Returns the number of values added. */
+  unsigned getTotal() const {return total;}
+
+  /**
+   * Returns a percentile of the values added.
+   * @param percentile The percentile in the range [0 .. 1].
+   * @return The largest value of the bucket that contains the percentile or 0
+   *         if the histogram is empty.
+   */
+  unsigned getPercentile(float percentile) const;
+
+  /**
+   * Returns the number of values in a bucket.
+   * @param index The index of the bucket.
+   * @return The number of values.
+   */
+  unsigned getCount(unsigned index) const {return counts[index];}
+
+  /**
+   * Returns the index of the bucket a value is counted in.
+   * @param value The value.
+   * @return The index of the bucket.
+   */
+  static unsigned getIndex(unsigned value)
+  {
+    if(value < subBuckets)
+      return value;
+    else if(value >> maxExponent)
+      return numOfBuckets - 1;
+    unsigned exponent = subBucketBits;
+    while(value >> (exponent + 1))
+      ++exponent;
+    return (exponent - subBucketBits + 1) * subBuckets + (value >> (exponent - subBucketBits)) - subBuckets;
+  }
+
+  /**
+   * Returns the smallest value that is counted in a bucket.
+   * @param index The index of the bucket.
+   * @return The value.
+   */
+  static unsigned getLowerBound(unsigned index)
+  {
+    if(index < subBuckets)
+      return index;
+    const unsigned exponent = index / subBuckets + subBucketBits - 1;
+    return (index % subBuckets + subBuckets) << (exponent - subBucketBits);
+  }
+
+  /**
+   * Returns the largest value that is counted in a bucket.
+   * @param index The index of the bucket.
+   * @return The value.
+   */
+  static unsigned getUpperBound(unsigned index)
+  {
+    return index < numOfBuckets - 1 ? getLowerBound(index + 1) - 1 : std::numeric_limits<unsigned>::max();
+  }
+
+  /**
+   * Writes the histogram. Only buckets that are not empty are written.
+   * @param stream The stream the histogram is written to.
+   */
+  void write(Out& stream) const;
+
+  /**
+   * Reads a histogram that was written by the method write.
+   * @param stream The stream the histogram is read from.
+   */
+  void read(In& stream);
+
+private:
+  std::array<unsigned, numOfBuckets> counts{}; /**< The number of values in each bucket. */
+  unsigned total = 0; /**< The number of values added. */
+};
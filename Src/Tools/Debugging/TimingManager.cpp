@@ -9,8 +9,10 @@
 #include <unordered_map>
 #include <vector>
 #include "Platform/BHAssert.h"
+#include "Platform/Memory.h"
 #include "Platform/Time.h"
 #include "Debugging.h"
+#include "TimingHistogram.h"
 #include "Tools/MessageQueue/MessageQueue.h"
 
 using namespace std;
@@ -23,12 +25,23 @@ struct TimingManager::Pimpl
    *       If this ever changes you have to replace the key with std::string
    */
 
+  /** The measurements of a stopwatch in the current frame. */
+  struct Watch
+  {
+    unsigned long long time = 0; /**< If the watch has been started but not stopped, yet: the start time. Else: the time between start and stop. */
+    Memory::AllocationCounter allocations; /**< The heap allocations while the watch was running. */
+    Memory::AllocationCounter allocationsAtStart; /**< The allocations when the watch was started. */
+    Memory::AllocationCounter* outerAllocations = nullptr; /**< The counter that was active when the watch was started. */
+    bool measured = false; /**< Was the watch stopped in the current frame? */
+    TimingHistogram histogram; /**< The times of all frames since the start of the thread or the last reset. */
+    unsigned misses = 0; /**< The number of frames in which the time exceeded the deadline since the same moment. */
+  };
+
   /**
    * Key: name of the timer
-   * value: If timer has been started but not stopped, yet: the start time.
-   *        Else: the time between start and stop.
+   * value: The measurements of the timer.
    */
-  unordered_map<const char*, unsigned long long> timing;
+  unordered_map<const char*, Watch> timing;
   unordered_map<const char*, unsigned short> idTable; /**< Key: name of the stopwatch. Value: the id that is used when sending timing data over the network */
   unsigned currentThreadStartTime = 0; /**< Timestamp of the current thread iteration */
   unsigned frameNo = 0; /**<  Number of the current frame*/
@@ -36,6 +49,27 @@ struct TimingManager::Pimpl
   MessageQueue data; /**< Contains the timing data in streamable format inbetween frames */
   bool dataPrepared = false; /**< True if data hs already been prepared this frame */
   int watchNameIndex = 0; /**< Every frame a few watch names are transmitted. This is the index of the watchname that is to be transmitted next */
+  int histogramIndex = 0; /**< Every frame a few histograms are transmitted. This is the index of the watch whose histogram is to be transmitted next */
+  unsigned deadline = 0; /**< The duration of a frame in us. 0 if misses are not counted. */
+
+  /**
+   * Returns the watch for an identifier. It is created if it does not exist.
+   * @param identifier The identifier of the watch.
+   * @return The watch.
+   */
+  Watch& getWatch(const char* identifier)
+  {
+    auto timing = this->timing.find(identifier);
+    if(timing == this->timing.end())
+    {
+      //create new entry
+      watchNames.push_back(identifier);
+      idTable[identifier] = static_cast<unsigned short>(idTable.size()); //NOTE: this assumes that an unsigned short will always be big big enough to count the timers...
+      timing = this->timing.insert(std::pair<const char*, Watch>(identifier, Watch())).first;
+    }
+    dataPrepared = false;
+    return timing->second;
+  }
 };
 
 TimingManager::TimingManager() : prvt(new TimingManager::Pimpl)
@@ -50,35 +84,72 @@ TimingManager::~TimingManager()
 
 void TimingManager::startTiming(const char* identifier)
 {
-  auto timing = prvt->timing.find(identifier);
-  if(timing == prvt->timing.end())
-  {
-    //create new entry
-    prvt->watchNames.push_back(identifier);
-    prvt->idTable[identifier] = static_cast<unsigned short>(prvt->idTable.size()); //NOTE: this assumes that an unsigned short will always be big big enough to count the timers...
-    timing = prvt->timing.insert(std::pair<const char*, unsigned long long>(identifier, 0)).first;
-  }
-  prvt->dataPrepared = false;
-  timing->second = Time::getCurrentThreadTime() - timing->second; // accumulate measurements
+  Pimpl::Watch& watch = prvt->getWatch(identifier);
+  watch.allocationsAtStart = watch.allocations;
+  watch.outerAllocations = Memory::setAllocationCounter(&watch.allocations);
+  watch.time = Time::getCurrentThreadTime() - watch.time; // accumulate measurements
 }
 
 unsigned TimingManager::stopTiming(const char* identifier)
 {
   const unsigned long long stopTime = Time::getCurrentThreadTime();
-  auto timing = prvt->timing.find(identifier);
-  const unsigned diff = unsigned(stopTime - timing->second);
-  timing->second = diff;
+  Pimpl::Watch& watch = prvt->timing.find(identifier)->second;
+  const unsigned diff = unsigned(stopTime - watch.time);
+  watch.time = diff;
+  watch.measured = true;
+
+  // The allocations of a watch are also counted for the watch it is nested in.
+  Memory::setAllocationCounter(watch.outerAllocations);
+  if(watch.outerAllocations)
+  {
+    watch.outerAllocations->count += watch.allocations.count - watch.allocationsAtStart.count;
+    watch.outerAllocations->bytes += watch.allocations.bytes - watch.allocationsAtStart.bytes;
+  }
   return diff;
 }
 
+void TimingManager::addTiming(const char* identifier, unsigned time)
+{
+  Pimpl::Watch& watch = prvt->getWatch(identifier);
+  watch.time += time;
+  watch.measured = true;
+}
+
 void TimingManager::signalThreadStart()
 {
   prvt->currentThreadStartTime = Time::getCurrentSystemTime();
   prvt->frameNo++;
   prvt->data.clear();
   prvt->dataPrepared = false;
-  for(const pair<const char* const, unsigned long long>& it : prvt->timing)
-    prvt->timing[it.first] = 0;
+  for(pair<const char* const, Pimpl::Watch>& it : prvt->timing)
+  {
+    // The histograms contain the accumulated times of the previous frames.
+    Pimpl::Watch& watch = it.second;
+    if(watch.measured)
+    {
+      watch.histogram.add(static_cast<unsigned>(watch.time));
+      if(prvt->deadline && watch.time > prvt->deadline)
+        ++watch.misses;
+    }
+    watch.time = 0;
+    watch.measured = false;
+    watch.allocations = Memory::AllocationCounter();
+  }
+}
+
+void TimingManager::setDeadline(unsigned deadline)
+{
+  prvt->deadline = deadline;
+}
+
+void TimingManager::resetHistograms()
+{
+  for(pair<const char* const, Pimpl::Watch>& it : prvt->timing)
+  {
+    it.second.histogram.clear();
+    it.second.misses = 0;
+  }
+  prvt->dataPrepared = false;
 }
 
 MessageQueue& TimingManager::getData()
@@ -106,6 +177,18 @@ void TimingManager::prepareData()
    *
    * unsigned : timestamp at which the last iteration started.
    * unsigned : frame number of the current frame
+   *
+   * unsigned short : Number of stopwatches that measured heap allocations
+   * for each of these stopwatches:
+   *  short : id of the stopwatch
+   *  unsigned : number of allocations
+   *  unsigned : number of bytes allocated
+   *
+   * unsigned short : number of histograms (usually 3)
+   * for each histogram:
+   *  short : id of the stopwatch
+   *  unsigned : number of deadline misses
+   *  TimingHistogram : the times of all frames since the start of the thread or the last reset
    */
   OutBinaryMessage& out = prvt->data.out.bin;
 
@@ -119,13 +202,36 @@ void TimingManager::prepareData()
 
   // now write the data of all watches
   out << static_cast<unsigned short>(prvt->timing.size());
-  for(const pair<const char* const, unsigned long long>& it : prvt->timing)
+  unsigned short allocationCount = 0;
+  for(const pair<const char* const, Pimpl::Watch>& it : prvt->timing)
   {
     out << prvt->idTable[it.first];
-    out << static_cast<unsigned>(it.second); // the cast is ok because the time between start and stop will never be bigger than an int...
+    out << static_cast<unsigned>(it.second.time); // the cast is ok because the time between start and stop will never be bigger than an int...
+    if(it.second.allocations.count)
+      ++allocationCount;
   }
   out << prvt->currentThreadStartTime;
   out << prvt->frameNo;
+
+  // The allocations are appended, so that readers that do not know them can ignore them.
+  out << allocationCount;
+  for(const pair<const char* const, Pimpl::Watch>& it : prvt->timing)
+    if(it.second.allocations.count)
+    {
+      out << prvt->idTable[it.first];
+      out << it.second.allocations.count;
+      out << static_cast<unsigned>(it.second.allocations.bytes);
+    }
+
+  // Like the names, every frame the histograms of 3 watches are sent.
+  out << static_cast<unsigned short>(3);
+  for(int i = 0; i < 3; ++i, prvt->histogramIndex = (prvt->histogramIndex + 1) % prvt->watchNames.size())
+  {
+    const char* watchName = prvt->watchNames[prvt->histogramIndex];
+    const Pimpl::Watch& watch = prvt->timing[watchName];
+    out << prvt->idTable[watchName] << watch.misses;
+    watch.histogram.write(out);
+  }
   if(!prvt->data.out.finishMessage(idStopwatch))
     OUTPUT_WARNING("TimingManager: queue is full!!!");
 }
@@ -27,6 +27,14 @@ public:
   /** Stops the stopwatch for the specified identifier and returns the time in us. */
   unsigned stopTiming(const char* identifier);
 
+  /**
+   * Adds a time that was measured otherwise as if a stopwatch had measured it.
+   * @param identifier The identifier of the stopwatch. As for the other
+   *                   stopwatches, the address must never change.
+   * @param time The time in us.
+   */
+  void addTiming(const char* identifier, unsigned time);
+
   /**
    * The TimingManager has a special stopwatch that is used to keep track
    * of the overall thread time.
@@ -35,6 +43,16 @@ public:
    */
   void signalThreadStart();
 
+  /**
+   * Sets the duration of a frame of this thread. Each frame in which a
+   * stopwatch measures a longer time is counted as a deadline miss.
+   * @param deadline The duration in us. 0 disables counting misses.
+   */
+  void setDeadline(unsigned deadline);
+
+  /** Removes all times from the histograms and resets the deadline misses. */
+  void resetHistograms();
+
   /**
    * Returns a message queue that contains all timing data from this frame.
    * Call this method in between signalThreadStop() and signalThreadStart.
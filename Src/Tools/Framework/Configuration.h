@@ -54,6 +54,8 @@ STREAMABLE(Configuration,
     (unsigned)(0) debugSenderSize, /**< The maximum size of the queue in Bytes. */
     (unsigned)(0) debugSenderInfrastructureSize,
     (std::string) executionUnit,
+    (bool)(false) failOnAllocation, /**< Abort if a module allocates heap memory in steady state? */
+    (unsigned)(0) deadline, /**< The duration of a frame in ms. Longer execution times are counted as misses. 0 disables counting. */
     (std::vector<RepresentationProvider>) representationProviders,
   });
 
@@ -65,5 +67,6 @@ STREAMABLE(Configuration,
   const std::vector<Thread>& operator()() const { return threads; },
 
   (std::vector<std::string>) defaultRepresentations,
+  (std::vector<std::string>) directRepresentations, /**< Representations passed between threads as soon as they are provided instead of in the packets sent at the end of each frame. */
   (std::vector<Thread>) threads, /**< Should be accessed via operator(). */
 });
@@ -10,9 +10,11 @@
 #include "Platform/SystemCall.h"
 #include "Platform/Time.h"
 #include "Threads/Debug.h"
+#include "Tools/Debugging/DebugBenchmark.h"
 #include "Tools/Framework/FrameExecutionUnit.h"
 #include "Tools/Logging/Logger.h"
 #include "Tools/Math/Constants.h"
+#include "Tools/NeuralNetwork/CompiledNNCache.h"
 
 #include "Representations/Infrastructure/CameraInfo.h"
 
@@ -22,7 +24,8 @@ ModuleContainer::ModuleContainer(const Settings& settings, const std::string& ro
   ThreadFrame(settings, robotName),
   name(config()[index].name),
   priority(config()[index].priority),
-  moduleGraphRunner(config().size()),
+  deadline(config()[index].deadline),
+  moduleGraphRunner(config().size(), config()[index].failOnAllocation),
   logger(logger)
 {
   for(ExecutionUnitCreatorBase* i = ExecutionUnitCreatorBase::first; i; i = i->next)
@@ -60,6 +63,14 @@ void ModuleContainer::connectWithSender(ModuleContainer* sender, const Configura
       sender->senders.back().index = i;
       break;
     }
+
+  // The module graph runners decide later whether the channels are actually used.
+  for(const std::string& representation : config.directRepresentations)
+  {
+    directChannels.emplace_back(representation);
+    moduleGraphRunner.connectDirectChannel(directChannels.back(), receivers.back().index, false);
+    sender->moduleGraphRunner.connectDirectChannel(directChannels.back(), sender->senders.back().index, true);
+  }
 }
 
 void ModuleContainer::connectWithDebug(Debug* debug, const Configuration::Thread& config)
@@ -75,6 +86,7 @@ void ModuleContainer::connectWithDebug(Debug* debug, const Configuration::Thread
 void ModuleContainer::init()
 {
   BH_TRACE_INIT(getName().c_str());
+  Global::getTimingManager().setDeadline(deadline * 1000);
 
   // Prepare first frame
   numberOfMessages = debugSender->getNumberOfMessages();
@@ -98,6 +110,9 @@ bool ModuleContainer::main()
 
     DEBUG_RESPONSE_ONCE("automated requests:DrawingManager") OUTPUT(idDrawingManager, bin, Global::getDrawingManager());
     DEBUG_RESPONSE_ONCE("automated requests:DrawingManager3D") OUTPUT(idDrawingManager3D, bin, Global::getDrawingManager3D());
+    DEBUG_RESPONSE_ONCE("compiledNNCache") Global::getCompiledNNCache().printStatistics();
+    DEBUG_RESPONSE_ONCE("benchmark:debugOverhead") DebugBenchmark::run();
+    DEBUG_RESPONSE_ONCE("timing:resetHistograms") Global::getTimingManager().resetHistograms();
 
     for(Sender<ModulePacket>& sender : senders)
       if(!moduleGraphRunner.senderEmpty(sender.index))
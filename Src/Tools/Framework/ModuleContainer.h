@@ -31,9 +31,11 @@ private:
   // Lists, since Sender.receiver would become invalid when resizing a vector.
   std::list<Receiver<ModulePacket>> receivers; /**< The list of all receivers of this thread. */
   std::list<Sender<ModulePacket>> senders; /**< The list of all senders of this thread. */
+  std::list<DirectChannel> directChannels; /**< The direct channels from other threads to this one. */
 
   const std::string name; /**< The name of this thread. */
   const int priority; /**< The priority of this thread. */
+  const unsigned deadline; /**< The duration of a frame in ms. 0 if misses are not counted. */
 
   FrameExecutionUnit* executionUnit = nullptr; /**< The thread specific code. */
   ModuleGraphRunner moduleGraphRunner; /**< The solution manager handles the execution of modules. */
@@ -10,11 +10,13 @@
 #include "ThreadFrame.h"
 #include "Tools/Debugging/Debugging.h"
 #include "Tools/Global.h"
+#include "Tools/NeuralNetwork/CompiledNNCache.h"
 #include <asmjit/asmjit.h>
 
 ThreadFrame::ThreadFrame(const Settings& settings, const std::string& robotName) :
   settings(settings),
   asmjitRuntime(new asmjit::JitRuntime()),
+  compiledNNCache(new CompiledNNCache()),
   robotName(robotName)
 {
   // Set settings as soon as possible for file access.
@@ -26,6 +28,7 @@ ThreadFrame::ThreadFrame(const Settings& settings, const std::string& robotName,
   debugSender(debugSender),
   settings(settings),
   asmjitRuntime(new asmjit::JitRuntime()),
+  compiledNNCache(new CompiledNNCache()),
   robotName(robotName)
 {
   // Set settings as soon as possible for file access and debugOut for debugging.
@@ -46,6 +49,7 @@ ThreadFrame::~ThreadFrame()
   setGlobals();
   delete debugReceiver;
   delete debugSender;
+  delete compiledNNCache; // Must be deleted before the runtime the networks were compiled with.
   delete asmjitRuntime;
 }
 
@@ -60,6 +64,7 @@ void ThreadFrame::setGlobals()
   Global::theDrawingManager3D = &drawingManager3D;
   Global::theTimingManager = &timingManager;
   Global::theAsmjitRuntime = asmjitRuntime;
+  Global::theCompiledNNCache = compiledNNCache;
 
   Blackboard::setInstance(blackboard); // blackboard is NOT globally accessible
 }
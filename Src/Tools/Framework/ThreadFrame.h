@@ -27,6 +27,7 @@
 
 #include <list>
 
+class CompiledNNCache;
 namespace asmjit
 {
   class JitRuntime;
@@ -58,6 +59,7 @@ private:
   DrawingManager drawingManager;
   DrawingManager3D drawingManager3D;
   asmjit::JitRuntime* asmjitRuntime; /**< JIT and Remote Assembler for C++ in this thread. */
+  CompiledNNCache* compiledNNCache; /**< The neural networks compiled with the asmjit runtime of this thread. */
   TimingManager timingManager; /**< Keeps track of the module timing in this thread. */
 
 protected:
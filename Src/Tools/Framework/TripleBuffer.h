@@ -0,0 +1,66 @@
+/**
+ * @file Tools/Framework/TripleBuffer.h
+ *
+ * This file declares a wait-free triple buffer that passes the most recent
+ * version of some data from a single producer thread to a single consumer
+ * thread. Neither of both ever waits for the other one and no data is copied
+ * between the buffers. Instead, each side swaps its buffer with the one in
+ * the middle.
+ */
+
+#pragma once
+
+#include <atomic>
+
+template<typename T> class TripleBuffer
+{
+private:
+  static constexpr unsigned char fresh = 4; /**< Set in the middle index if the middle buffer was published, but not consumed yet. */
+  static constexpr unsigned char index = 3; /**< The mask for the actual index in the middle index. */
+
+  T buffers[3]; /**< The three buffers. */
+  std::atomic<unsigned char> middle{1}; /**< The index of the buffer in the middle plus the flag fresh. */
+  unsigned char writing = 0; /**< The index of the buffer the producer writes to. */
+  unsigned char reading = 2; /**< The index of the buffer the consumer reads from. */
+
+public:
+  /**
+   * Returns the buffer the producer writes to. It still contains the data
+   * the producer wrote two or more publications ago.
+   * Only the producer may call this method.
+   * @return The buffer.
+   */
+  T& getWriteBuffer() {return buffers[writing];}
+
+  /**
+   * Publishes the buffer the producer wrote to. A version that was published
+   * before, but was not consumed yet, is replaced.
+   * Only the producer may call this method.
+   */
+  void publish()
+  {
+    writing = middle.exchange(writing | fresh, std::memory_order_acq_rel) & index;
+  }
+
+  /**
+   * Switches the consumer to the most recent buffer published if it did not
+   * consume it already.
+   * Only the consumer may call this method.
+   * @return Was a new version published since the last call?
+   */
+  bool consume()
+  {
+    if(!(middle.load(std::memory_order_relaxed) & fresh))
+      return false;
+    reading = middle.exchange(reading, std::memory_order_acq_rel) & index;
+    return true;
+  }
+
+  /**
+   * Returns the buffer the consumer reads from. It is only valid after
+   * consume() returned true at least once.
+   * Only the consumer may call this method.
+   * @return The buffer.
+   */
+  T& getReadBuffer() {return buffers[reading];}
+};
@@ -9,6 +9,7 @@
 // Only declare prototypes. Don't include anything here, because this
 // file is included in many other files.
 class AnnotationManager;
+class CompiledNNCache;
 class OutMessage;
 struct Settings;
 class DebugRequestTable;
@@ -38,6 +39,7 @@ private:
   static thread_local DrawingManager3D* theDrawingManager3D;
   static thread_local TimingManager* theTimingManager;
   static thread_local asmjit::JitRuntime* theAsmjitRuntime;
+  static thread_local CompiledNNCache* theCompiledNNCache;
 
 public:
   /**
@@ -106,6 +108,12 @@ public:
    */
   static asmjit::JitRuntime& getAsmjitRuntime() { return *theAsmjitRuntime; }
 
+  /**
+   * The method returns a reference to the thread wide instance.
+   * @return the instance of the cache for compiled neural networks in this thread.
+   */
+  static CompiledNNCache& getCompiledNNCache() { return *theCompiledNNCache; }
+
   friend class ThreadFrame; // The class ThreadFrame can set these pointers.
   friend class Robot; // The class Robot can set theSettings.
   friend class ConsoleRoboCupCtrl; // The class ConsoleRoboCupCtrl can set theSettings.
@@ -0,0 +1,143 @@
+/**
+ * @file HoughLines.cpp
+ *
+ * This file implements a hough lines transformation of a Sobel image that only
+ * considers a range of angles.
+ */
+
+#include "HoughLines.h"
+#include "Tools/ImageProcessing/SIMD.h"
+#include "Tools/WorkerPool.h"
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+/** Fewer votes are not worth being distributed among multiple threads. */
+static constexpr size_t minVotesPerJob = 20000;
+
+/**
+ * Executes a job for disjoint ranges of rows in parallel.
+ * @param numOfRows The number of rows.
+ * @param numOfRanges The number of ranges the rows are split into.
+ * @param job The job. It is called with the first and the end row of a range and the index of the range.
+ */
+template<typename Job>
+static void forEachRange(size_t numOfRows, size_t numOfRanges, Job job)
+{
+  // The calling thread processes the first range itself.
+  std::vector<std::future<void>> futures;
+  futures.reserve(numOfRanges - 1);
+  for(size_t i = 1; i < numOfRanges; ++i)
+    futures.emplace_back(WorkerPool::getShared().run([&job, i, begin = numOfRows * i / numOfRanges, end = numOfRows * (i + 1) / numOfRanges]
+    {
+      job(begin, end, i);
+    }));
+  job(0, numOfRows / numOfRanges, 0);
+  for(std::future<void>& future : futures)
+    future.get();
+}
+
+void HoughLines::findLocalMaxima(const Sobel::SobelImage& sobelImage, float threshold,
+                                 const std::vector<float>& cosAngles, const std::vector<float>& sinAngles,
+                                 int minIndex, int maxIndex, int dMax, std::vector<Maximum>& localMaxima)
+{
+  const int numOfAngles = static_cast<int>(cosAngles.size());
+  const size_t numOfRows = (maxIndex - minIndex + numOfAngles) % numOfAngles;
+  if(numOfRows == 0)
+    return;
+
+  // Collect the edge pixels.
+  thread_local std::vector<float> xs, ys;
+  xs.clear();
+  ys.clear();
+  for(unsigned int y = 1; y < sobelImage.height - 1; ++y)
+    for(unsigned int x = 1; x < sobelImage.width - 1; ++x)
+    {
+      const Sobel::SobelPixel& pixel = sobelImage[y][x];
+      if(pixel.x * pixel.x + pixel.y * pixel.y >= threshold)
+      {
+        xs.push_back(static_cast<float>(x));
+        ys.push_back(static_cast<float>(y));
+      }
+    }
+  const size_t numOfEdges = xs.size();
+
+  // Row i + 1 of the accumulator contains the votes for the angle minIndex + i. The first and
+  // the last row are always empty, so that the neighbors of each row can be checked uniformly.
+  const size_t width = 2 * dMax + 1;
+  thread_local std::vector<int> accumulator;
+  accumulator.assign((numOfRows + 2) * width, 0);
+
+  const size_t numOfRanges = std::clamp(numOfEdges * numOfRows / minVotesPerJob, size_t(1),
+                                        std::min(numOfRows, WorkerPool::getShared().getNumOfWorkers() + 1));
+
+  // Vote. Each thread fills different rows.
+  int* const acc = accumulator.data();
+  const float* const edgesX = xs.data();
+  const float* const edgesY = ys.data();
+  forEachRange(numOfRows, numOfRanges, [&](size_t begin, size_t end, size_t)
+  {
+    alignas(16) int distances[8];
+    for(size_t row = begin; row < end; ++row)
+    {
+      const int index = (minIndex + static_cast<int>(row)) % numOfAngles;
+      int* const votes = acc + (row + 1) * width + dMax;
+      const __m128 cosine = _mm_set1_ps(cosAngles[index]);
+      const __m128 sine = _mm_set1_ps(sinAngles[index]);
+      size_t i = 0;
+      for(; i + 8 <= numOfEdges; i += 8)
+      {
+        // ceil(x * cos + y * sin), i.e. the truncated value plus 1 if it was rounded down.
+        // If the compiler contracts the scalar expression to a fused multiply-add, so must this
+        // code, because otherwise, the distances can differ if the sum is close to an integer.
+#ifdef __FMA__
+        const __m128 d0 = _mm_fmadd_ps(_mm_loadu_ps(edgesX + i), cosine, _mm_mul_ps(_mm_loadu_ps(edgesY + i), sine));
+        const __m128 d1 = _mm_fmadd_ps(_mm_loadu_ps(edgesX + i + 4), cosine, _mm_mul_ps(_mm_loadu_ps(edgesY + i + 4), sine));
+#else
+        const __m128 d0 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(edgesX + i), cosine), _mm_mul_ps(_mm_loadu_ps(edgesY + i), sine));
+        const __m128 d1 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(edgesX + i + 4), cosine), _mm_mul_ps(_mm_loadu_ps(edgesY + i + 4), sine));
+#endif
+        const __m128i t0 = _mm_cvttps_epi32(d0);
+        const __m128i t1 = _mm_cvttps_epi32(d1);
+        _mm_store_si128(reinterpret_cast<__m128i*>(distances), _mm_sub_epi32(t0, _mm_castps_si128(_mm_cmplt_ps(_mm_cvtepi32_ps(t0), d0))));
+        _mm_store_si128(reinterpret_cast<__m128i*>(distances + 4), _mm_sub_epi32(t1, _mm_castps_si128(_mm_cmplt_ps(_mm_cvtepi32_ps(t1), d1))));
+        for(int distance : distances)
+          ++votes[distance];
+      }
+      for(; i < numOfEdges; ++i)
+        ++votes[static_cast<int>(std::ceil(edgesX[i] * cosAngles[index] + edgesY[i] * sinAngles[index]))];
+    }
+  });
+
+  // Search local maxima. Each thread searches different rows, but reads their neighbors as well.
+  std::vector<std::vector<Maximum>> localMaximaOfRanges(numOfRanges);
+  forEachRange(numOfRows, numOfRanges, [&](size_t begin, size_t end, size_t range)
+  {
+    std::vector<Maximum>& maxima = localMaximaOfRanges[range];
+    for(size_t row = begin; row < end; ++row)
+    {
+      const int* const votes = acc + (row + 1) * width;
+      for(int distanceIndex = 0; distanceIndex < static_cast<int>(width); ++distanceIndex)
+      {
+        const int value = votes[distanceIndex];
+        if(value == 0)
+          continue;
+        const int minJ = std::max(0, distanceIndex - 1);
+        const int maxJ = std::min(static_cast<int>(width) - 1, distanceIndex + 1);
+        bool isMaximum = true;
+        for(const int* neighbors = votes - width; isMaximum && neighbors <= votes + width; neighbors += width)
+          for(int j = minJ; j <= maxJ; ++j)
+            if(neighbors[j] > value)
+            {
+              isMaximum = false;
+              break;
+            }
+        if(isMaximum)
+          maxima.push_back({value, (minIndex + static_cast<int>(row)) % numOfAngles, distanceIndex});
+      }
+    }
+  });
+
+  for(const std::vector<Maximum>& maxima : localMaximaOfRanges)
+    localMaxima.insert(localMaxima.end(), maxima.begin(), maxima.end());
+}
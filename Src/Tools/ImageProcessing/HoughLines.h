@@ -0,0 +1,44 @@
+/**
+ * @file HoughLines.h
+ *
+ * This file declares a hough lines transformation of a Sobel image that only
+ * considers a range of angles. The votes of 8 edge pixels are calculated at
+ * once with SSE, one angle after the other, so that only a single row of the
+ * accumulator is accessed at a time. Large transformations are distributed
+ * among the threads of the shared WorkerPool.
+ */
+
+#pragma once
+
+#include "Sobel.h"
+#include <vector>
+
+namespace HoughLines
+{
+  /** This struct represents a local maximum in the hough space. */
+  struct Maximum
+  {
+    int maxAcc; /**< The accumulator value of the local maximum. */
+    int angleIndex; /**< The angle index of the local maximum in the hough space. */
+    int distanceIndex; /**< The distance index of the local maximum in the hough space. */
+  };
+
+  /**
+   * Performs the hough lines transformation of a Sobel image and determines the
+   * local maxima in the hough space.
+   * @param sobelImage The Sobel image. Its border pixels are ignored.
+   * @param threshold The squared gradient magnitude from which on a pixel is considered to be an edge.
+   * @param cosAngles The cosines of all angles of the hough space.
+   * @param sinAngles The sines of all angles of the hough space.
+   * @param minIndex The index of the first angle considered.
+   * @param maxIndex The index after the last angle considered. The range wraps around
+   *                 if it is smaller than the minimum index.
+   * @param dMax The maximum absolute distance of a line from the image origin.
+   * @param localMaxima The local maxima are appended here, ordered by their angles
+   *                    (starting at the minimum index) and then by their distances.
+   *                    The distance index is the distance plus dMax.
+   */
+  void findLocalMaxima(const Sobel::SobelImage& sobelImage, float threshold,
+                       const std::vector<float>& cosAngles, const std::vector<float>& sinAngles,
+                       int minIndex, int maxIndex, int dMax, std::vector<Maximum>& localMaxima);
+};
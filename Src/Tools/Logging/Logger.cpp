@@ -23,6 +23,7 @@
 #include "Tools/Module/Blackboard.h"
 #include "Tools/Settings.h"
 #include "Tools/Streams/TypeInfo.h"
+#include <algorithm>
 #include <cstring>
 
 #undef PRINT
@@ -60,7 +61,9 @@ Logger::Logger(const Configuration& config)
       for(const auto& thread : config.threads)
         if(thread.name == rpt.thread)
         {
-          for(const std::string& loggerRepresentation : rpt.representations)
+          std::vector<std::string> loggerRepresentations = rpt.representations;
+          loggerRepresentations.insert(loggerRepresentations.end(), rpt.sampledRepresentations.begin(), rpt.sampledRepresentations.end());
+          for(const std::string& loggerRepresentation : loggerRepresentations)
           {
             for(const std::string& defaultRepresentation : config.defaultRepresentations)
               if(loggerRepresentation == defaultRepresentation)
@@ -148,8 +151,8 @@ void Logger::execute(const std::string& threadName)
 
   if(logging)
   {
-    for(const RepresentationsPerThread& rpt : representationsPerThread)
-      if(rpt.thread == threadName && !rpt.representations.empty())
+    for(RepresentationsPerThread& rpt : representationsPerThread)
+      if(rpt.thread == threadName && (!rpt.representations.empty() || !rpt.sampledRepresentations.empty()))
       {
         MessageQueue* buffer = nullptr;
         {
@@ -171,19 +174,29 @@ void Logger::execute(const std::string& threadName)
           buffer->out.bin << threadName;
           buffer->out.finishMessage(idFrameBegin);
 
-          for(const std::string& representation : rpt.representations)
+          // The sampled representations are written last, giving them more time if they are computed in parallel (e.g. JPEGImage).
+          const bool logSampled = rpt.frameCounter++ % std::max(rpt.samplingInterval, 1u) == 0;
+          for(const std::vector<std::string>* representations : {&rpt.representations, &rpt.sampledRepresentations})
+          {
+            if(representations == &rpt.representations || logSampled)
+            {
+              for(const std::string& representation : *representations)
+              {
 #ifndef NDEBUG
-            if(Blackboard::getInstance().exists(representation.c_str()))
+                if(Blackboard::getInstance().exists(representation.c_str()))
 #endif
-            {
-              buffer->out.bin << Blackboard::getInstance()[representation.c_str()];
-              if(!buffer->out.finishMessage(static_cast<MessageID>(TypeRegistry::getEnumValue(typeid(MessageID).name(), "id" + representation))))
-                OUTPUT_WARNING("Logger: Representation " << representation << " did not fit into buffer!");
-            }
+                {
+                  buffer->out.bin << Blackboard::getInstance()[representation.c_str()];
+                  if(!buffer->out.finishMessage(static_cast<MessageID>(TypeRegistry::getEnumValue(typeid(MessageID).name(), "id" + representation))))
+                    OUTPUT_WARNING("Logger: Representation " << representation << " did not fit into buffer!");
+                }
 #ifndef NDEBUG
-            else
-              OUTPUT_WARNING("Logger: Representation " << representation << " does not exists!");
+                else
+                  OUTPUT_WARNING("Logger: Representation " << representation << " does not exists!");
 #endif
+              }
+            }
+          }
 
           Global::getAnnotationManager().getOut().copyAllMessages(*buffer);
         }
@@ -25,9 +25,13 @@ STREAMABLE(Logger,
 {
   /** Which representations will be logged for a certain thread? */
   STREAMABLE(RepresentationsPerThread,
-  {,
+  {
+    unsigned frameCounter = 0; /**< Counts the frames logged to determine when sampled representations are logged. */,
+
     (std::string) thread,
     (std::vector<std::string>) representations,
+    (std::vector<std::string>) sampledRepresentations, /**< Representations that are only logged every samplingInterval frames. */
+    (unsigned)(1) samplingInterval, /**< Log the sampled representations every this many frames. */
   });
 
 private:
@@ -0,0 +1,146 @@
+/**
+ * @file AngularPartition.h
+ *
+ * This file declares and implements a partition of the circle [-pi, pi] into
+ * consecutive segments, each of which has a value. The segments are stored
+ * sorted in a flat array, so that updates neither allocate memory (once the
+ * capacity suffices) nor have to follow a linked list.
+ */
+
+#pragma once
+
+#include "Angle.h"
+#include "Platform/BHAssert.h"
+#include <algorithm>
+#include <vector>
+
+template<typename T>
+class AngularPartition
+{
+public:
+  /** A segment of the partition. */
+  struct Segment
+  {
+    float min; /**< The angle at which the segment starts. */
+    float max; /**< The angle at which the segment ends. It is the start of the next segment. */
+    T value; /**< The value of the segment. */
+  };
+
+  using const_iterator = typename std::vector<Segment>::const_iterator;
+
+  /**
+   * Constructor.
+   * @param value The value of the whole circle.
+   */
+  AngularPartition(const T& value = T()) { reset(value); }
+
+  /**
+   * Resets the partition to a single segment. The memory is kept.
+   * @param value The value of the whole circle.
+   */
+  void reset(const T& value)
+  {
+    segments.clear();
+    segments.push_back({-pi, pi, value});
+  }
+
+  /**
+   * Updates the values of all segments in an angular range. Segments that
+   * are only partially covered by the range are split if their value is
+   * replaced.
+   * @param min The start of the range. Must be in [-pi, pi].
+   * @param max The end of the range. Must be in [min, pi].
+   * @param update A function that is called with the value of each segment in
+   *               the range. It returns whether it replaced the value with
+   *               the new one. Consecutive replaced segments are merged, i.e.
+   *               the function must always assign the same value.
+   */
+  template<typename F> void update(float min, float max, F update)
+  {
+    ASSERT(min >= -pi && max <= pi && min <= max);
+    if(min == max)
+      return;
+
+    const auto first = std::partition_point(segments.begin(), segments.end(), [min](const Segment& segment) { return segment.max <= min; });
+    const auto last = std::partition_point(first, segments.end(), [max](const Segment& segment) { return segment.min < max; });
+
+    // The result is assembled in a second buffer, whose memory is kept as well.
+    buffer.assign(segments.begin(), first);
+    bool replacedLast = false;
+    for(auto segment = first; segment != last; ++segment)
+    {
+      Segment replacement = *segment;
+      const bool replaced = update(replacement.value);
+      if(!replaced)
+        buffer.push_back(*segment);
+      else
+      {
+        if(segment->min < min)
+          buffer.push_back({segment->min, min, segment->value});
+        replacement.min = std::max(segment->min, min);
+        replacement.max = std::min(segment->max, max);
+        if(replacedLast)
+          buffer.back().max = replacement.max;
+        else
+          buffer.push_back(replacement);
+        if(segment->max > max)
+          buffer.push_back({max, segment->max, segment->value});
+      }
+      replacedLast = replaced;
+    }
+    buffer.insert(buffer.end(), last, segments.end());
+    segments.swap(buffer);
+  }
+
+  /**
+   * Updates the values of all segments in an angular range that may wrap
+   * around at -pi/pi.
+   * @param min The normalized start of the range.
+   * @param max The normalized end of the range. If it is not greater than
+   *            \c min, the range wraps around. If both are the same, the
+   *            range covers the whole circle.
+   * @param update See above.
+   */
+  template<typename F> void updateWrapped(float min, float max, F update)
+  {
+    if(min < max)
+      this->update(min, max, update);
+    else
+    {
+      this->update(min, pi, update);
+      this->update(-pi, max, update);
+    }
+  }
+
+  /** Merges all neighboring segments that have the same value. */
+  void simplify()
+  {
+    size_t to = 0;
+    for(size_t from = 1; from < segments.size(); ++from)
+      if(segments[from].value == segments[to].value)
+        segments[to].max = segments[from].max;
+      else
+        segments[++to] = segments[from];
+    segments.resize(to + 1);
+  }
+
+  /**
+   * Returns the segment that contains an angle.
+   * @param angle The normalized angle.
+   * @return The segment. If the angle is a boundary, it is the segment that starts there.
+   */
+  const Segment& operator()(float angle) const
+  {
+    return *(std::partition_point(segments.begin(), segments.end() - 1, [angle](const Segment& segment) { return segment.max <= angle; }));
+  }
+
+  const_iterator begin() const { return segments.begin(); }
+  const_iterator end() const { return segments.end(); }
+  const Segment& front() const { return segments.front(); }
+  const Segment& back() const { return segments.back(); }
+  size_t size() const { return segments.size(); }
+
+private:
+  std::vector<Segment> segments; /**< The segments, sorted by their angles. They are never empty. */
+  std::vector<Segment> buffer; /**< Used to assemble the segments after an update. */
+};
@@ -54,82 +54,50 @@
 
   void SectorList::addSector(const Sector& newSect) 
   {
-    for(auto iter = begin(); iter != end(); iter++)
-    {
-      Sector& localSect = *iter;
-      bool minInside = localSect.isInside(newSect.min);
-      bool maxInside = localSect.isInside(newSect.max);
-      if(minInside) {
-        if (maxInside) {
-          if (newSect.isInside(localSect.min)) { // List becomes single full sector
-            clear();
-            push_back(Sector(-pi,pi - 0.000001f));
-          } 
-          return;
-        } else { // newSect clips localSect on the MaxSide
-          erase(iter);
-          addSector(Sector(localSect.min, newSect.max));
-          return;
-        }
-      } else {
-        if (maxInside) { // newSect clips localSect on the minSide
-            erase(iter);
-            addSector(Sector(newSect.min, localSect.max));
-            return;  
-          
-        } else if (newSect.isInside(localSect.min)) // localSect contained in newSect 
-        {
-            iter = erase(iter); // Remove LocalSect and continue adding
-        } 
-      }
-    } // no intersection with other sectors -> add
-    push_back(newSect);
+    covered.updateWrapped(newSect.min, newSect.max, [](bool& value) { value = true; return true; });
+    covered.simplify();
+    updateSectors();
   }
 
   void SectorList::subtractSector(const Sector& sect) 
   {
-    for(auto iter = begin(); iter != end(); iter++)
+    covered.updateWrapped(sect.min, sect.max, [](bool& value) { value = false; return true; });
+    covered.simplify();
+    updateSectors();
+  }
+
+  void SectorList::join(const SectorList& other) {
+    for(const auto& segment : other.covered)
     {
-      Sector& localSect = *iter;
-      bool minInside = localSect.isInside(sect.min);
-      bool maxInside = localSect.isInside(sect.max);
-      if(minInside) {
-        if (maxInside) {
-          if (sect.isInside(localSect.min)) { // List becomes single full sector
-            clear();
-            push_back(Sector(sect.max, sect.min));
-            return;
-          } else {
-            push_back(Sector(localSect.min, sect.min));
-            push_back(Sector(sect.max, localSect.max));
-            erase(iter);
-            iter = begin();
-          }
-        } else {
-          push_back(Sector(localSect.min, sect.min));
-          erase(iter);
-          iter = begin();
-        }
-      } else {
-        if (maxInside) {
-          push_back(Sector(sect.max, localSect.max));
-          erase(iter);
-          iter = begin();
-        } else {
-          if (sect.isInside(localSect.min)) { 
-            erase(iter);
-            iter = begin();
-          } else if (localSect.isInside(sect.max)) { // New sector is already contained in localSect
-            return;
-          }
-        }
-      }
+      if(segment.value)
+        covered.update(segment.min, segment.max, [](bool& value) { value = true; return true; });
     }
+    covered.simplify();
+    updateSectors();
   }
 
-  void SectorList::join(const SectorList& other) {
-    for(auto& sector : other)
+  void SectorList::clear()
+  {
+    covered.reset(false);
+    sectors.clear();
+  }
+
+  void SectorList::updateSectors()
+  {
+    sectors.clear();
+    if(covered.size() == 1) {
+      if(covered.front().value)
+        sectors.push_back(Sector(-pi, pi - 0.000001f));
+      return;
+    }
+
+    // A sector crossing -pi/pi is split into two segments, which are reunited at the end.
+    const bool wraps = covered.front().value && covered.back().value;
+    for(auto iter = covered.begin() + (wraps ? 1 : 0); iter != covered.end() - (wraps ? 1 : 0); iter++)
     {
-      addSector(sector);
+      if(iter->value)
+        sectors.push_back(Sector(iter->min, iter->max));
     }
+    if(wraps)
+      sectors.push_back(Sector(covered.back().min, covered.front().max));
   }
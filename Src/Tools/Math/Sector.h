@@ -16,7 +16,8 @@
 #pragma once
 
 #include "Angle.h"
-#include <list>
+#include "AngularPartition.h"
+#include <vector>
 
 // Draws a sector on WorldView
 #define DRAW_SECTOR(drawID, sector, poseOffset) \
@@ -50,12 +51,32 @@ public:
 
 };
 
-class SectorList : public std::list<Sector>
+/**
+ * A set of disjoint sectors. The sectors are sorted by their start angles,
+ * except for a sector that wraps around at -pi/pi, which comes last.
+ */
+class SectorList
 {
   public:
+  using const_iterator = std::vector<Sector>::const_iterator;
+
   void addSector(const Sector& sect); 
 
   void subtractSector(const Sector& sect);
 
   void join(const SectorList& other);
+
+  void clear();
+
+  const_iterator begin() const { return sectors.begin(); }
+  const_iterator end() const { return sectors.end(); }
+  size_t size() const { return sectors.size(); }
+  bool empty() const { return sectors.empty(); }
+
+  private:
+  /** Recreates the list of sectors from the covered parts of the circle. */
+  void updateSectors();
+
+  AngularPartition<bool> covered; /**< Which parts of the circle are covered by sectors. */
+  std::vector<Sector> sectors; /**< The sectors in the form they are iterated. */
 };
@@ -1,5 +1,8 @@
 #ifndef MD5_H
-#define MD5_H
+#define MD5_H
+
+#include <cstdio>
+#include <cstring>
 
 // Copyright (C) 1991-2, RSA Data Security, Inc. Created 1991. All
 // rights reserved.
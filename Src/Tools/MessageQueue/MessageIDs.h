@@ -115,4 +115,5 @@ ENUM(MessageID,
   idText,
   idTypeInfo,
   idTypeInfoRequest,
+  idCompressedDebugImage, /**< A debug image in the format of DebugImage::writeCompressed. */
 });
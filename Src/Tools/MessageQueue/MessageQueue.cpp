@@ -110,6 +110,8 @@ void MessageQueue::append(In& stream)
       stream >> id;
 
       stream.read(&size, 3);
+      if(size == MessageQueueBase::extendedSize)
+        stream.read(&size, 4);
 
       if(id >= numOfDataMessageIDs && numberOfMessages == static_cast<unsigned>(-1))
       {
@@ -142,8 +144,8 @@ void MessageQueue::append(In& stream, size_t size)
     queue.writePosition = 0;
 
     // Count new messages
-    for(char* p = dest - MessageQueueBase::headerSize, * pEnd = p + usedSize; p < pEnd;
-        p += 4 + (*reinterpret_cast<unsigned*>(p) >> 8))
+    for(size_t p = static_cast<size_t>(dest - MessageQueueBase::headerSize - queue.buf), pEnd = p + usedSize; p < pEnd;
+        p = queue.getNextMessagePosition(p))
       ++queue.numberOfMessages;
   }
   else // Not all messages fit in there, so try step by step (some will be missing).
@@ -156,6 +158,8 @@ void MessageQueue::append(In& stream, size_t size)
       stream >> id;
 
       stream.read(&size, 3);
+      if(size == MessageQueueBase::extendedSize)
+        stream.read(&size, 4);
 
       char* dest = queue.reserve(size);
       if(dest)
@@ -165,7 +169,7 @@ void MessageQueue::append(In& stream, size_t size)
       }
       else
         stream.skip(size);
-      readSize += 4 + size;
+      readSize += (size >= MessageQueueBase::extendedSize ? MessageQueueBase::extendedHeaderSize : MessageQueueBase::headerSize) + size;
     }
   }
 }
@@ -116,6 +116,15 @@ public:
    */
   void removeMessage(int message) {queue.removeMessage(message);}
 
+  /**
+   * The method removes all messages from the queue that are not accepted by a
+   * filter without copying the queue.
+   * @param keep The filter. It is called for each message in ascending order
+   *             with that message selected for reading. It returns whether to
+   *             keep the message.
+   */
+  void filter(const std::function<bool(int message)>& keep) {queue.filter(keep);}
+
   /**
    * The method removes a message from the queue.
    */
@@ -89,7 +89,7 @@ void MessageQueueBase::createIndex()
   for(int i = 0; i < numberOfMessages; ++i)
   {
     messageIndex[i] = selectedMessageForReadingPosition;
-    selectedMessageForReadingPosition += getMessageSize() + headerSize;
+    selectedMessageForReadingPosition = getNextMessagePosition(selectedMessageForReadingPosition);
   }
 }
 
@@ -104,21 +104,52 @@ void MessageQueueBase::freeIndex()
 
 void MessageQueueBase::removeMessage(int message)
 {
+  ASSERT(message >= 0 && message < numberOfMessages);
+  size_t position = 0;
+  if(messageIndex)
+    position = messageIndex[message];
+  else
+    for(int i = 0; i < message; ++i)
+      position = getNextMessagePosition(position);
   freeIndex();
+
+  // Move all following messages at once
+  const size_t next = getNextMessagePosition(position);
+  memmove(buf + position, buf + next, usedSize - next);
+  usedSize -= next - position;
+  readPosition = 0;
+  --numberOfMessages;
   selectedMessageForReadingPosition = 0;
-  int i;
-  for(i = 0; i < message; ++i)
-    selectedMessageForReadingPosition += getMessageSize() + headerSize;
-  usedSize = selectedMessageForReadingPosition;
-  for(++i; i < numberOfMessages; ++i)
+  lastMessage = 0;
+}
+
+void MessageQueueBase::filter(const std::function<bool(int message)>& keep)
+{
+  ASSERT(!writePosition);
+  freeIndex();
+  size_t source = 0;
+  size_t destination = 0;
+  int numOfKept = 0;
+  for(int i = 0; i < numberOfMessages; ++i)
   {
-    int mlength = getMessageSize() + headerSize;
-    selectedMessageForReadingPosition += mlength;
-    memcpy(buf + usedSize, buf + selectedMessageForReadingPosition, mlength);
-    usedSize = selectedMessageForReadingPosition;
+    // Select the message at its original position. The filter can read it,
+    // because only memory before it has been overwritten so far.
+    selectedMessageForReadingPosition = source;
+    readPosition = 0;
+    lastMessage = i;
+    const size_t next = getNextMessagePosition(source);
+    if(keep(i))
+    {
+      if(destination != source)
+        memmove(buf + destination, buf + source, next - source);
+      destination += next - source;
+      ++numOfKept;
+    }
+    source = next;
   }
+  usedSize = destination;
+  numberOfMessages = numOfKept;
   readPosition = 0;
-  --numberOfMessages;
   selectedMessageForReadingPosition = 0;
   lastMessage = 0;
 }
@@ -204,7 +235,22 @@ bool MessageQueueBase::finishMessage(MessageID id)
           success = false; // reject
       }
 
-    if(success)
+    if(success && writePosition >= extendedSize)
+    {
+      // The size does not fit into 24 bits, so it is stored in 32 additional bits
+      const unsigned size = writePosition;
+      success = reserve(extendedHeaderSize - headerSize) != nullptr;
+      if(success)
+      {
+        memmove(buf + usedSize + extendedHeaderSize, buf + usedSize + headerSize, size);
+        memcpy(buf + usedSize, reinterpret_cast<char*>(&id), 1); // write the id of the message
+        memcpy(buf + usedSize + 1, &extendedSize, 3); // mark the extended size
+        memcpy(buf + usedSize + headerSize, &size, 4); // write the size of the message
+        ++numberOfMessages;
+        usedSize += size + extendedHeaderSize;
+      }
+    }
+    else if(success)
     {
       memcpy(buf + usedSize, reinterpret_cast<char*>(&id), 1); // write the id of the message
       memcpy(buf + usedSize + 1, &writePosition, 3); // write the size of the message
@@ -240,7 +286,7 @@ void MessageQueueBase::removeRepetitions()
       messagesPerType = threads[std::string(getData() + offset, getMessageSize() - offset)];
     }
     ++messagesPerType[getMessageID()];
-    selectedMessageForReadingPosition += getMessageSize() + headerSize;
+    selectedMessageForReadingPosition = getNextMessagePosition(selectedMessageForReadingPosition);
   }
 
   // reset all variables
@@ -253,7 +299,7 @@ void MessageQueueBase::removeRepetitions()
 
   for(int i = 0; i < numberOfMessages; ++i)
   {
-    int mlength = getMessageSize() + headerSize;
+    const size_t mlength = getNextMessagePosition(selectedMessageForReadingPosition) - selectedMessageForReadingPosition;
     bool copy;
     switch(getMessageID())
     {
@@ -277,6 +323,7 @@ void MessageQueueBase::removeRepetitions()
       // data only from latest frame
       case idStopwatch:
       case idDebugImage:
+      case idCompressedDebugImage:
       case idDebugDrawing:
       case idDebugDrawing3D:
         copy = messagesPerType[idFrameFinished] == 1;
@@ -363,7 +410,7 @@ void MessageQueueBase::setSelectedMessageForReading(int message)
       selectedMessageForReadingPosition = 0;
 
     for(int i = 0; i < m; ++i)
-      selectedMessageForReadingPosition += getMessageSize() + headerSize;
+      selectedMessageForReadingPosition = getNextMessagePosition(selectedMessageForReadingPosition);
   }
 
   readPosition = 0;
@@ -373,7 +420,7 @@ void MessageQueueBase::setSelectedMessageForReading(int message)
 void MessageQueueBase::read(void* p, size_t size)
 {
   ASSERT(readPosition + static_cast<int>(size) <= getMessageSize());
-  memcpy(p, buf + selectedMessageForReadingPosition + headerSize + readPosition, size);
+  memcpy(p, getData() + readPosition, size);
   readPosition += static_cast<int>(size);
 }
 
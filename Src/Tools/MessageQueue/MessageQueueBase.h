@@ -8,6 +8,7 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <string>
 
 #include "MessageIDs.h"
@@ -26,6 +27,8 @@ class MessageQueueBase
 {
 private:
   static constexpr int headerSize = 4; /**< The size of the header of each message in bytes. */
+  static constexpr int extendedHeaderSize = 8; /**< The size of the header of messages that are too large for a 24 bit size. */
+  static constexpr unsigned extendedSize = 0xffffff; /**< The 24 bit size that marks that a 32 bit size follows. */
   static constexpr int queueHeaderSize = 2 * sizeof(unsigned); /**< The size of the header in a streamed queue. */
   char* buf = nullptr; /**< The buffer on that the queue works. */
   size_t* messageIndex = 0; /**< An index of the beginnings of all messages. */
@@ -75,6 +78,16 @@ public:
    */
   void removeMessage(int message);
 
+  /**
+   * The method removes all messages from the queue that are not accepted by a
+   * filter. The remaining messages are moved to the front of the buffer in a
+   * single pass, i.e. no additional memory is required.
+   * @param keep The filter. It is called for each message in ascending order
+   *             with that message selected for reading. It must only access the
+   *             currently selected message. It returns whether to keep it.
+   */
+  void filter(const std::function<bool(int message)>& keep);
+
   /**
    * The method adds a number of bytes to the last message in the queue.
    * @param p The address the data is located at.
@@ -113,7 +126,7 @@ public:
    * The method gives direct read access to the selected message for reading.
    * @return The address of the first byte of the message
    */
-  const char* getData() const {return buf + selectedMessageForReadingPosition + headerSize;}
+  const char* getData() const {return buf + selectedMessageForReadingPosition + getHeaderSize(selectedMessageForReadingPosition);}
 
   /**
    * The method returns the message id of the currently selected message for reading.
@@ -125,7 +138,7 @@ public:
    * The method returns the message size of the currently selected message for reading.
    * @return The size in bytes.
    */
-  int getMessageSize() const {return (*reinterpret_cast<int*>(buf + selectedMessageForReadingPosition + 1)) & 0xffffff;}
+  int getMessageSize() const {return static_cast<int>(getMessageSize(selectedMessageForReadingPosition));}
 
   /**
    * The method returns the number of bytes not read yet in the current message.
@@ -173,6 +186,37 @@ public:
   void readMessageIDMapping(In& stream);
 
 private:
+  /**
+   * Returns the size of the header of a message.
+   * @param position The position of the message in the buffer.
+   * @return The size of the header in bytes.
+   */
+  int getHeaderSize(size_t position) const
+  {
+    return (*reinterpret_cast<const unsigned*>(buf + position + 1) & 0xffffff) == extendedSize ? extendedHeaderSize : headerSize;
+  }
+
+  /**
+   * Returns the size of a message without its header.
+   * @param position The position of the message in the buffer.
+   * @return The size in bytes.
+   */
+  unsigned getMessageSize(size_t position) const
+  {
+    const unsigned size = *reinterpret_cast<const unsigned*>(buf + position + 1) & 0xffffff;
+    return size == extendedSize ? *reinterpret_cast<const unsigned*>(buf + position + headerSize) : size;
+  }
+
+  /**
+   * Returns the position of the message that follows another one.
+   * @param position The position of a message in the buffer.
+   * @return The position of the next message.
+   */
+  size_t getNextMessagePosition(size_t position) const
+  {
+    return position + getHeaderSize(position) + getMessageSize(position);
+  }
+
   /**
    * The method reserves a number of bytes in the message queue.
    * @param size The number of bytes to reserve.
@@ -58,6 +58,20 @@ const Streamable& Blackboard::operator[](const char* representation) const
   return *entry.data;
 }
 
+Blackboard::Create Blackboard::getCreate(const char* representation) const
+{
+  const Entry& entry = get(representation);
+  ASSERT(entry.data);
+  return entry.create;
+}
+
+Blackboard::Copy Blackboard::getCopy(const char* representation) const
+{
+  const Entry& entry = get(representation);
+  ASSERT(entry.data);
+  return entry.copy;
+}
+
 void Blackboard::free(const char* representation)
 {
   Entry& entry = get(representation);
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <functional>
+#include <type_traits>
 
 class Streamable;
 class In;
@@ -25,6 +26,10 @@ struct HasReadWrite
 
 class Blackboard
 {
+public:
+  using Create = std::unique_ptr<Streamable> (*)(); /**< A function that creates an instance of the type of a representation. */
+  using Copy = void (*)(Streamable& target, const Streamable& source); /**< A function that assigns an instance of the type of a representation to another one. */
+
 private:
   /** A single entry of the blackboard. */
   struct Entry
@@ -32,6 +37,8 @@ private:
     std::unique_ptr<Streamable> data; /**< The representation. */
     int counter = 0; /**< How many modules requested its existence? */
     std::function<void(Streamable*)> reset;
+    Create create = nullptr; /**< Creates another instance of the representation's type. */
+    Copy copy = nullptr; /**< Copies instances of the representation's type. nullptr if they cannot be copied. */
   };
 
   class Entries; /**< Type of the map for all entries. */
@@ -97,6 +104,12 @@ public:
       };
       else
         entry.reset = [](Streamable*) {};
+      entry.create = [] {return std::unique_ptr<Streamable>(std::make_unique<T>());};
+      if constexpr(std::is_copy_assignable<T>::value)
+        entry.copy = [](Streamable& target, const Streamable& source)
+      {
+        dynamic_cast<T&>(target) = dynamic_cast<const T&>(source);
+      };
       ++version;
     }
     return dynamic_cast<T&>(*entry.data);
@@ -126,6 +139,22 @@ public:
   Streamable& operator[](const char* representation);
   const Streamable& operator[](const char* representation) const;
 
+  /**
+   * Returns a function that creates other instances of the type of a
+   * representation. The representation must already exist.
+   * @param representation The name of the representation.
+   * @return The function.
+   */
+  Create getCreate(const char* representation) const;
+
+  /**
+   * Returns a function that copies instances of the type of a
+   * representation. The representation must already exist.
+   * @param representation The name of the representation.
+   * @return The function or nullptr if the type cannot be copied.
+   */
+  Copy getCopy(const char* representation) const;
+
   /**
    * Return the current version.
    * It can be used to determine whether the configuration of the
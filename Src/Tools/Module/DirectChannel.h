@@ -0,0 +1,78 @@
+/**
+ * @file Tools/Module/DirectChannel.h
+ *
+ * This file declares a channel that passes a single representation from one
+ * thread to another one as soon as it was provided. In contrast to the
+ * packets exchanged between threads, it is neither streamed nor does the
+ * receiver have to wait until the sender finished its frame. The receiver
+ * always gets the most recent version. The time between providing and
+ * receiving the representation is measured.
+ */
+
+#pragma once
+
+#include "Tools/Framework/TripleBuffer.h"
+#include "Tools/Module/Blackboard.h"
+#include "Tools/Streams/Streamable.h"
+#include <chrono>
+#include <string>
+
+class DirectChannel
+{
+public:
+  const std::string representation; /**< The name of the representation passed through this channel. */
+  const std::string latencyName; /**< The name of the stopwatch that measures the latency in the receiving thread. */
+
+private:
+  /** A version of the representation. */
+  struct Slot
+  {
+    std::unique_ptr<Streamable> data; /**< The representation. Created when it is written for the first time. */
+    std::chrono::steady_clock::time_point published; /**< When was it published? */
+  };
+
+  TripleBuffer<Slot> buffer; /**< The most recent versions of the representation. */
+
+public:
+  /**
+   * Constructor.
+   * @param representation The name of the representation passed through this channel.
+   */
+  DirectChannel(const std::string& representation) :
+    representation(representation), latencyName("latency:" + representation) {}
+
+  /**
+   * Publishes a new version of the representation. Only the sending thread
+   * may call this method.
+   * @param data The representation.
+   * @param create A function that creates instances of the type of the representation.
+   * @param copy A function that copies instances of the type of the representation.
+   */
+  void publish(const Streamable& data, Blackboard::Create create, Blackboard::Copy copy)
+  {
+    Slot& slot = buffer.getWriteBuffer();
+    if(!slot.data)
+      slot.data = create();
+    copy(*slot.data, data);
+    slot.published = std::chrono::steady_clock::now();
+    buffer.publish();
+  }
+
+  /**
+   * Receives the most recent version of the representation if it was not
+   * received already. Only the receiving thread may call this method.
+   * @param data The representation that is overwritten.
+   * @param copy A function that copies instances of the type of the representation.
+   * @param latency The time since the representation was published is returned here (in µs).
+   * @return Was a new version received?
+   */
+  bool receive(Streamable& data, Blackboard::Copy copy, unsigned& latency)
+  {
+    if(!buffer.consume())
+      return false;
+    const Slot& slot = buffer.getReadBuffer();
+    copy(data, *slot.data);
+    latency = static_cast<unsigned>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - slot.published).count());
+    return true;
+  }
+};
@@ -558,7 +558,7 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
     { \
       if(sizeof(NoParameters) < sizeof(theName##Module::Parameters)) \
       { \
-        Global::getDebugDataTable().updateObject("parameters:" #theName, *this, false); \
+        Global::getDebugDataTable().updateObject(DEBUG_REQUEST_SLOT("debug data:parameters:" #theName), *this, false); \
         DEBUG_RESPONSE_ONCE("debug data:parameters:" #theName) \
           OUTPUT(idDebugDataResponse, bin, "parameters:" #theName << TypeRegistry::demangle(typeid(theName##Module::Parameters).name()) << *this); \
       } \
@@ -8,6 +8,10 @@
  */
 
 #include "ModuleGraphRunner.h"
+#include "Platform/Memory.h"
+#include "Tools/Debugging/TimingManager.h"
+#include "Tools/Global.h"
+#include <algorithm>
 #ifdef TARGET_ROBOT
 #include "Platform/Time.h"
 #endif
@@ -24,11 +28,15 @@ void ModuleGraphRunner::destroy()
   providers.clear();
   sent.clear();
   received.clear();
+  directSend.clear();
+  directReceive.clear();
 }
 
 void ModuleGraphRunner::update(In& stream)
 {
   providers.clear();
+  directSend.clear();
+  directReceive.clear();
 
   ModuleGraphCreator::ExecutionValues values;
   stream >> values;
@@ -80,10 +88,24 @@ void ModuleGraphRunner::update(In& stream)
   validConfiguration = true;
   stream >> nextTimestamp; // Use this timestamp after execute was called
   this->timestamp = 0; // Invalid until execute was called
+  framesExecuted = 0;
 }
 
 void ModuleGraphRunner::execute()
 {
+  // The allocations of each provider are counted by its stopwatch.
+  const bool forbidAllocations = failOnAllocation && framesExecuted >= warmUpFrames;
+  if(framesExecuted < warmUpFrames)
+    ++framesExecuted;
+
+  // Receive the most recent versions of the representations passed through direct channels.
+  for(const DirectLink& link : directReceive)
+  {
+    unsigned latency;
+    if(link.channel->receive(*link.data, link.copy, latency))
+      Global::getTimingManager().addTiming(link.channel->latencyName.c_str(), latency);
+  }
+
   // Execute all providers in the given sequence
   for(Provider& p : providers)
   {
@@ -93,8 +115,14 @@ void ModuleGraphRunner::execute()
 #ifdef TARGET_ROBOT
     unsigned timestamp = Time::getCurrentSystemTime();
 #endif
+    if(forbidAllocations)
+      Memory::forbidAllocations(p.moduleState->module->name);
     if(p.moduleState->instance)
       p.update(*p.moduleState->instance);
+    if(forbidAllocations)
+      Memory::forbidAllocations(nullptr);
+    for(const DirectLink& link : p.directLinks)
+      link.channel->publish(*link.data, link.create, link.copy);
 #ifdef TARGET_ROBOT
     int duration = Time::getTimeSince(timestamp);
     if(timestamp > 110000 &&
@@ -106,6 +134,8 @@ void ModuleGraphRunner::execute()
                    << " ms at " << timestamp / 1000 - 100 << " s after start");
 #endif
   }
+  for(const DirectLink& link : directSend)
+    link.channel->publish(*link.data, link.create, link.copy);
   BH_TRACE;
 
   if(!timestamp) // Configuration changed recently?
@@ -116,13 +146,34 @@ void ModuleGraphRunner::execute()
       s.clear();
     for(std::size_t i = 0; i < sent.size(); i++)
       for(const std::string& s : sent[i].vector)
-        toSend[i].emplace_back(&Blackboard::getInstance()[s.c_str()]);
+      {
+        // Representations that cannot be copied are still sent in packets.
+        const auto channel = std::find_if(sendingChannels[i].begin(), sendingChannels[i].end(),
+                                          [&s](const DirectChannel* channel) {return channel->representation == s;});
+        if(channel == sendingChannels[i].end() || !Blackboard::getInstance().getCopy(s.c_str()))
+          toSend[i].emplace_back(&Blackboard::getInstance()[s.c_str()]);
+        else
+        {
+          // Publish the representation directly after it was provided.
+          const DirectLink link = {*channel, &Blackboard::getInstance()[s.c_str()],
+                                   Blackboard::getInstance().getCreate(s.c_str()), Blackboard::getInstance().getCopy(s.c_str())};
+          const auto provider = std::find_if(providers.begin(), providers.end(), [&s](const Provider& p) {return p.representation == s;});
+          (provider == providers.end() ? directSend : provider->directLinks).push_back(link);
+        }
+      }
 
     for(auto& r : toReceive)
       r.clear();
     for(std::size_t i = 0; i < received.size(); i++)
       for(const std::string& r : received[i].vector)
-        toReceive[i].emplace_back(&Blackboard::getInstance()[r.c_str()]);
+      {
+        const auto channel = std::find_if(receivingChannels[i].begin(), receivingChannels[i].end(),
+                                          [&r](const DirectChannel* channel) {return channel->representation == r;});
+        if(channel == receivingChannels[i].end() || !Blackboard::getInstance().getCopy(r.c_str()))
+          toReceive[i].emplace_back(&Blackboard::getInstance()[r.c_str()]);
+        else
+          directReceive.push_back({*channel, &Blackboard::getInstance()[r.c_str()], nullptr, Blackboard::getInstance().getCopy(r.c_str())});
+      }
   }
 }
 
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "Tools/Framework/Configuration.h"
+#include "Tools/Module/DirectChannel.h"
 #include "Tools/Module/ModuleGraphCreator.h"
 
 #include <vector>
@@ -42,6 +43,17 @@ private:
     ModuleState(ModuleBase* module) : module(module) {}
   };
 
+  /**
+   * A representation that is exchanged with another thread through a direct channel.
+   */
+  struct DirectLink
+  {
+    DirectChannel* channel; /**< The channel. */
+    Streamable* data; /**< The representation in the blackboard. */
+    Blackboard::Create create; /**< Creates instances of the type of the representation. */
+    Blackboard::Copy copy; /**< Copies instances of the type of the representation. */
+  };
+
   /**
    * The class represents a provider of information, i.e. a method of a module that updates a representation.
    */
@@ -51,6 +63,7 @@ private:
     const char* representation; /**< The representation that will be provided. */
     ModuleState* moduleState; /**< The moduleState that will give access to the module that provides the information. */
     void (*update)(Streamable&); /**< The update handler within the module. */
+    std::vector<DirectLink> directLinks; /**< The direct channels the representation is published to after it was updated. */
 
     /**
      * Constructor.
@@ -73,16 +86,29 @@ private:
   std::list<Provider> providers; /**< The list of providers that will be executed. */
   std::vector<std::vector<Streamable*>> toReceive; /**< The list of all representations received from other threads. */
   std::vector<std::vector<Streamable*>> toSend; /**< The list of all representations sent to other threads. */
+  std::vector<std::vector<DirectChannel*>> sendingChannels; /**< The direct channels to other threads. */
+  std::vector<std::vector<DirectChannel*>> receivingChannels; /**< The direct channels from other threads. */
+  std::vector<DirectLink> directSend; /**< The representations published at the end of each frame, because they are not provided in this thread. */
+  std::vector<DirectLink> directReceive; /**< The representations received at the beginning of each frame. */
 
   unsigned timestamp = 0; /**< The timestamp of the last module request. Communication is only possible if both sides use the same timestamp. */
   unsigned nextTimestamp = 0; /**< The next timestamp used to verify communication. */
 
+  static constexpr unsigned warmUpFrames = 100; /**< The number of frames after a module request in which modules may allocate heap memory. */
+  const bool failOnAllocation; /**< Abort if a module allocates heap memory after the warm-up frames? */
+  unsigned framesExecuted = 0; /**< The number of frames executed since the last module request. */
+
 public:
   /**
    * The constructor.
    * @param numberOfThreads The number of threads.
+   * @param failOnAllocation Abort if a module allocates heap memory after the
+   *                         warm-up frames? This allows to check that a thread
+   *                         does not allocate in steady state.
    */
-  ModuleGraphRunner(size_t numberOfThreads) : toReceive(numberOfThreads), toSend(numberOfThreads)
+  ModuleGraphRunner(size_t numberOfThreads, bool failOnAllocation = false) :
+    toReceive(numberOfThreads), toSend(numberOfThreads), sendingChannels(numberOfThreads), receivingChannels(numberOfThreads),
+    failOnAllocation(failOnAllocation)
   {
     for(ModuleBase* i = ModuleBase::first; i; i = i->next)
       allModules.emplace(i->name, i);
@@ -139,6 +165,18 @@ public:
    */
   void writePacket(Out& stream, const std::size_t index) const;
 
+  /**
+   * The function connects a direct channel with this thread. Representations
+   * exchanged through direct channels are not part of the packets anymore.
+   * @param channel The channel.
+   * @param index The index of the other thread.
+   * @param sending Does this thread send through the channel? Otherwise, it receives.
+   */
+  void connectDirectChannel(DirectChannel& channel, const std::size_t index, bool sending)
+  {
+    (sending ? sendingChannels : receivingChannels)[index].push_back(&channel);
+  }
+
   /**
    * The function checks whether no data would be received in a packet from a
    * certain thread.
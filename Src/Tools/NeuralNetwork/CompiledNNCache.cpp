@@ -0,0 +1,113 @@
+/**
+ * @file CompiledNNCache.cpp
+ *
+ * This file implements a cache for compiled neural networks.
+ */
+
+#include "CompiledNNCache.h"
+#include "Platform/File.h"
+#include "Platform/Time.h"
+#include "Tools/Debugging/Debugging.h"
+#include "Tools/Global.h"
+#include "Tools/Md5.h"
+#include <mutex>
+#include <vector>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+NeuralNetwork::CompiledNN& CompiledNNCache::get(const std::string& path, bool uint8Input, const NeuralNetwork::CompilationSettings& settings)
+{
+  const unsigned long long start = Time::getCurrentThreadTime();
+
+  // The contents are hashed, so that changed files are recompiled.
+  const std::string hash = getHash(path);
+  std::string variant = uint8Input ? ":uint8" : ":float";
+  const std::string modelKey = hash + variant;
+  variant += settings.useX64 ? ":x64" : ":x86";
+  variant += settings.useSSE42 ? ":sse42" : "";
+  variant += settings.useAVX2 ? ":avx2" : "";
+  variant += settings.useExpApproxInSigmoid ? ":approxSigmoid" : ":sigmoid";
+  variant += settings.useExpApproxInTanh ? ":approxTanh" : ":tanh";
+  variant += settings.debug ? ":debug" : "";
+  const std::string key = hash + variant;
+
+  Entry& entry = entries[key];
+  ++entry.requests;
+  if(!entry.network)
+  {
+    // Networks compiled from previous contents of the file are not requested anymore.
+    for(auto i = entries.begin(); i != entries.end();)
+      if(i->first != key && i->second.path == path && i->second.variant == variant)
+        i = entries.erase(i);
+      else
+        ++i;
+
+    entry.path = path;
+    entry.variant = variant;
+    entry.model = getModel(modelKey, path, uint8Input);
+    entry.network = std::make_unique<NeuralNetwork::CompiledNN>(&Global::getAsmjitRuntime());
+    entry.network->compile(*entry.model, settings);
+    entry.coldStartTime = Time::getCurrentThreadTime() - start;
+  }
+  else
+    entry.warmStartTime = Time::getCurrentThreadTime() - start;
+  return *entry.network;
+}
+
+void CompiledNNCache::printStatistics() const
+{
+  for(const auto& [key, entry] : entries)
+    OUTPUT_TEXT(entry.path << ": requested " << entry.requests << " times, cold start "
+                << entry.coldStartTime / 1000.f << " ms, warm start " << entry.warmStartTime / 1000.f << " ms");
+}
+
+std::string CompiledNNCache::getHash(const std::string& path)
+{
+  /** The hash of a file and the state of the file when it was hashed. */
+  struct FileHash
+  {
+    long long size;
+    long long modificationTime;
+    std::string hash;
+  };
+
+  static std::mutex mutex;
+  static std::unordered_map<std::string, FileHash> hashes;
+
+  struct stat info;
+  if(stat(path.c_str(), &info) != 0)
+    return path;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  FileHash& fileHash = hashes[path];
+  if(fileHash.hash.empty() || fileHash.size != static_cast<long long>(info.st_size)
+     || fileHash.modificationTime != static_cast<long long>(info.st_mtime))
+  {
+    File file(path, "rb", false);
+    if(!file.exists())
+      return path;
+    std::vector<unsigned char> buffer(file.getSize());
+    file.read(buffer.data(), buffer.size());
+    MD5 md5;
+    fileHash = {static_cast<long long>(info.st_size), static_cast<long long>(info.st_mtime),
+                md5.digestMemory(buffer.data(), static_cast<int>(buffer.size()))};
+  }
+  return fileHash.hash;
+}
+
+std::shared_ptr<const NeuralNetwork::Model> CompiledNNCache::getModel(const std::string& key, const std::string& path, bool uint8Input)
+{
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::weak_ptr<const NeuralNetwork::Model>> models;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<const NeuralNetwork::Model> model = models[key].lock();
+  if(!model)
+  {
+    auto newModel = std::make_shared<NeuralNetwork::Model>(path);
+    if(uint8Input)
+      newModel->setInputUInt8(0);
+    models[key] = model = newModel;
+  }
+  return model;
+}
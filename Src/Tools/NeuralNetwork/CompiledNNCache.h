@@ -0,0 +1,77 @@
+/**
+ * @file CompiledNNCache.h
+ *
+ * This file declares a cache for compiled neural networks. Each thread owns
+ * an instance, because the code generated is bound to the asmjit runtime of
+ * the thread. Therefore, a network is only compiled once per thread, even if
+ * the module using it is recreated when the module graph changes. The
+ * generated code is neither shared between threads nor stored on disk,
+ * because CompiledNN owns the tensors of a network and does not expose its
+ * code. Only the hashes of the model files and the models loaded from them
+ * are shared between all threads.
+ */
+
+#pragma once
+
+#include <CompiledNN/CompiledNN.h>
+#include <CompiledNN/Model.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+class CompiledNNCache
+{
+  /** A network compiled in this thread. */
+  struct Entry
+  {
+    std::shared_ptr<const NeuralNetwork::Model> model; /**< The model the network was compiled from. */
+    std::unique_ptr<NeuralNetwork::CompiledNN> network; /**< The compiled network. */
+    std::string path; /**< The file the model was loaded from. */
+    std::string variant; /**< The input type and the compilation settings as part of the key. */
+    unsigned long long coldStartTime = 0; /**< The time it took to load and compile the network in µs. */
+    unsigned long long warmStartTime = 0; /**< The time the last lookup of the network took in µs. */
+    unsigned requests = 0; /**< How often the network was requested. */
+  };
+
+  std::unordered_map<std::string, Entry> entries; /**< The networks compiled, indexed by their key. */
+
+public:
+  /**
+   * Returns a network compiled from a model file. If the same file with the
+   * same contents was already compiled with the same settings in this
+   * thread, the network compiled before is returned. Modules using the same
+   * network in a thread share its input and output tensors, which is fine,
+   * because they are never executed at the same time. If the file has
+   * changed, the network compiled from its previous contents with the same
+   * settings is released.
+   * @param path The absolute path of the model file.
+   * @param uint8Input Whether the first input of the network is given as bytes.
+   * @param settings The settings used for compiling the network.
+   * @return The compiled network. It stays valid until the thread terminates
+   *         or the network is requested again after the file has changed.
+   */
+  NeuralNetwork::CompiledNN& get(const std::string& path, bool uint8Input = false,
+                                 const NeuralNetwork::CompilationSettings& settings = NeuralNetwork::CompilationSettings());
+
+  /** Prints the cold and warm start times of all networks compiled in this thread. */
+  void printStatistics() const;
+
+private:
+  /**
+   * Returns the MD5 hash of a file's contents. The file is only read again
+   * if its size or its modification time have changed since it was hashed
+   * by any thread.
+   * @param path The absolute path of the file.
+   * @return The hash or the path itself if the file does not exist.
+   */
+  static std::string getHash(const std::string& path);
+
+  /**
+   * Loads a model or returns an instance already loaded by another thread.
+   * @param key The key that identifies the file contents and the input type.
+   * @param path The absolute path of the model file.
+   * @param uint8Input Whether the first input of the network is given as bytes.
+   * @return The model.
+   */
+  static std::shared_ptr<const NeuralNetwork::Model> getModel(const std::string& key, const std::string& path, bool uint8Input);
+};
@@ -0,0 +1,190 @@
+/**
+ * The file declares a pool of objects with a fixed capacity. The elements are
+ * stored in slots that never move, i.e. pointers and references to an element
+ * stay valid until it is erased. The elements are kept in the order in which
+ * they were added, which is also the order of iteration and of the indices used
+ * by operator[]. The type of the elements must be assignable and copyable.
+ * Erased elements are not destroyed. Instead, their slots are reused by
+ * assigning new values to them, so that the resources they own (e.g. the memory
+ * of a RingBuffer) are recycled. Therefore, the pool does not allocate memory
+ * after its construction as long as the elements do not. The interface of the
+ * class is similar to types of the standard template library and it also
+ * supports for-each loops.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include "Platform/BHAssert.h"
+#include "Platform/Memory.h"
+
+template<typename T, std::size_t n = 0> class ObjectPool
+{
+private:
+  T* slots; /**< The slots storing the elements. */
+  std::size_t* order; /**< The indices of the slots of the elements in the order of the elements. */
+  std::size_t* released; /**< A stack of the indices of slots that contain erased elements. */
+  std::size_t allocated; /**< The capacity of the pool. */
+  std::size_t entries = 0; /**< The number of elements in the pool. */
+  std::size_t numOfReleased = 0; /**< The number of entries in the stack of released slots. */
+  std::size_t constructed = 0; /**< The slots before this index contain constructed objects. */
+
+public:
+  /** A class for iterators with its typical interface. */
+  class iterator : public std::iterator<std::forward_iterator_tag, T>
+  {
+  private:
+    ObjectPool<T, n>& pool; /**< The pool. */
+    std::size_t index; /**< Index of the current entry. */
+
+    friend class ObjectPool<T, n>;
+
+  public:
+    iterator(ObjectPool<T, n>& pool, std::size_t index) : pool(pool), index(index) {}
+    iterator(const iterator& other) : iterator(other.pool, other.index) {}
+    iterator& operator=(const iterator& other) {return *new(this) iterator(other.pool, other.index);}
+    T* operator->() const {return &pool[index];}
+    T& operator*() const {return pool[index];}
+    bool operator==(const iterator& other) const {return index == other.index && &pool == &other.pool;}
+    bool operator!=(const iterator& other) const {return index != other.index || &pool != &other.pool;}
+    iterator& operator++() {++index; return *this;}
+    iterator operator++(int) {iterator result(*this); ++index; return result;}
+    iterator& operator+=(std::ptrdiff_t offset) {index += offset; return *this;}
+    iterator& operator-=(std::ptrdiff_t offset) {index -= offset; return *this;}
+    iterator operator+(std::ptrdiff_t offset) {iterator result(*this); return result += offset;}
+    iterator operator-(std::ptrdiff_t offset) {iterator result(*this); return result -= offset;}
+  };
+
+  /** A class for constant iterators with its typical interface. */
+  class const_iterator : public std::iterator<std::forward_iterator_tag, T>
+  {
+  private:
+    const ObjectPool<T, n>& pool; /**< The pool. */
+    std::size_t index; /**< Index of the current entry. */
+
+  public:
+    const_iterator(const ObjectPool<T, n>& pool, std::size_t index) : pool(pool), index(index) {}
+    const_iterator(const const_iterator& other) : const_iterator(other.pool, other.index) {}
+    const_iterator& operator=(const const_iterator& other) {return *new(this) const_iterator(other.pool, other.index);}
+    const T* operator->() const {return &pool[index];}
+    const T& operator*() const {return pool[index];}
+    bool operator==(const const_iterator& other) const {return index == other.index && &pool == &other.pool;}
+    bool operator!=(const const_iterator& other) const {return index != other.index || &pool != &other.pool;}
+    const_iterator& operator++() {++index; return *this;}
+    const_iterator operator++(int) {const_iterator result(*this); ++index; return result;}
+    const_iterator& operator+=(std::ptrdiff_t offset) {index += offset; return *this;}
+    const_iterator& operator-=(std::ptrdiff_t offset) {index -= offset; return *this;}
+    const_iterator operator+(std::ptrdiff_t offset) {const_iterator result(*this); return result += offset;}
+    const_iterator operator-(std::ptrdiff_t offset) {const_iterator result(*this); return result -= offset;}
+  };
+
+  /**
+   * Constructor. All memory required is allocated here.
+   * @param capacity The maximum number of elements the pool can store. If not specified,
+   *                 the second template parameter is used as default capacity.
+   */
+  ObjectPool(std::size_t capacity = n) :
+    slots(reinterpret_cast<T*>(Memory::alignedMalloc(capacity * sizeof(T)))),
+    order(reinterpret_cast<std::size_t*>(Memory::alignedMalloc(2 * capacity * sizeof(std::size_t)))),
+    released(order + capacity),
+    allocated(capacity)
+  {}
+
+  /** Pools are neither copied nor assigned, because the objects are owned by their slots. */
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+
+  /** Destructor. Destroys all objects, including the erased ones. */
+  ~ObjectPool()
+  {
+    for(std::size_t i = 0; i < constructed; ++i)
+      slots[i].~T();
+    Memory::alignedFree(reinterpret_cast<char*>(slots));
+    Memory::alignedFree(reinterpret_cast<char*>(order));
+  }
+
+  /** Erases all elements. Their slots are reused in reverse order. */
+  void clear()
+  {
+    while(!empty())
+      released[numOfReleased++] = order[--entries];
+  }
+
+  /**
+   * Adds a copy of a value behind the last element. If a slot of an erased element
+   * is reused, the value is assigned to it. Otherwise, it is copy-constructed in a
+   * slot that was not used before. The pool must not be full.
+   * @param value The value that is added to the pool.
+   * @return The new element.
+   */
+  T& push_back(const T& value)
+  {
+    ASSERT(!full());
+    std::size_t slot;
+    if(numOfReleased)
+    {
+      slot = released[--numOfReleased];
+      slots[slot] = value;
+    }
+    else
+    {
+      slot = constructed++;
+      new(slots + slot) T(value);
+    }
+    order[entries++] = slot;
+    return slots[slot];
+  }
+
+  /**
+   * Erases an element. The order of the remaining elements is preserved. The
+   * complexity is O(size()) in the worst case, but only indices are moved.
+   * @param element An iterator pointing at the element that is erased.
+   * @return An iterator pointing at the element behind the one erased.
+   */
+  iterator erase(iterator element)
+  {
+    ASSERT(element.index < entries);
+    released[numOfReleased++] = order[element.index];
+    --entries;
+    std::memmove(order + element.index, order + element.index + 1, (entries - element.index) * sizeof(std::size_t));
+    return element;
+  }
+
+  /**
+   * Access to the individual elements of the pool.
+   * @param index The index of the element in the order in which the elements were added.
+   */
+  T& operator[](std::size_t index) {ASSERT(index < entries); return slots[order[index]];}
+  const T& operator[](std::size_t index) const {ASSERT(index < entries); return slots[order[index]];}
+
+  /** Access the first element of the pool. */
+  T& front() {ASSERT(!empty()); return (*this)[0];}
+  const T& front() const {ASSERT(!empty()); return (*this)[0];}
+
+  /** Access the last element of the pool. */
+  T& back() {ASSERT(!empty()); return (*this)[entries - 1];}
+  const T& back() const {ASSERT(!empty()); return (*this)[entries - 1];}
+
+  /** The number of elements currently stored in the pool. */
+  std::size_t size() const {return entries;}
+
+  /** The maximum number of elements that can be stored in the pool. */
+  std::size_t capacity() const {return allocated;}
+
+  /** Is the pool empty? */
+  bool empty() const {return entries == 0;}
+
+  /** Is the pool full, i.e. push_back() must not be called? */
+  bool full() const {return entries == allocated;}
+
+  /** Returns an iterator pointing at the front() of the pool. */
+  iterator begin() {return iterator(*this, 0);}
+  const_iterator begin() const {return const_iterator(*this, 0);}
+
+  /** Returns an iterator pointing at behind the back() of the pool. */
+  iterator end() {return iterator(*this, entries);}
+  const_iterator end() const {return const_iterator(*this, entries);}
+};
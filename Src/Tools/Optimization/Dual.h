@@ -0,0 +1,94 @@
+/**
+ * @file Dual.h
+ *
+ * This file declares and implements a dual number for forward-mode automatic
+ * differentiation. A dual number carries a value and its partial derivatives
+ * with respect to N variables. Every arithmetic operation and function applies
+ * the chain rule, so that evaluating a function with dual numbers as arguments
+ * also yields its exact gradient.
+ */
+
+#pragma once
+
+#include "Tools/Math/Eigen.h"
+#include <cmath>
+
+template<size_t N>
+struct Dual
+{
+  using Vector = Eigen::Matrix<float, N, 1>;
+
+  float value = 0.f; /**< The value. */
+  Vector derivatives = Vector::Zero(); /**< The partial derivatives of the value with respect to all variables. */
+
+  Dual() = default;
+
+  /**
+   * Creates a constant, i.e. a number that does not depend on any variable.
+   * @param value The value.
+   */
+  Dual(float value) : value(value) {}
+
+  /**
+   * Creates a number with the given derivatives.
+   * @param value The value.
+   * @param derivatives The partial derivatives of the value.
+   */
+  Dual(float value, const Vector& derivatives) : value(value), derivatives(derivatives) {}
+
+  /**
+   * Creates the ith variable, i.e. a number whose derivative is 1 with
+   * respect to itself and 0 with respect to all other variables.
+   * @param value The value of the variable.
+   * @param index The index of the variable.
+   * @return The variable.
+   */
+  static Dual variable(float value, size_t index)
+  {
+    Dual result(value);
+    result.derivatives(index) = 1.f;
+    return result;
+  }
+
+  Dual operator-() const {return Dual(-value, -derivatives);}
+
+  Dual& operator+=(const Dual& other) {value += other.value; derivatives += other.derivatives; return *this;}
+  Dual& operator-=(const Dual& other) {value -= other.value; derivatives -= other.derivatives; return *this;}
+  Dual& operator*=(const Dual& other) {derivatives = derivatives * other.value + other.derivatives * value; value *= other.value; return *this;}
+  Dual& operator/=(const Dual& other) {derivatives = (derivatives - other.derivatives * (value / other.value)) / other.value; value /= other.value; return *this;}
+
+  friend Dual operator+(Dual a, const Dual& b) {return a += b;}
+  friend Dual operator-(Dual a, const Dual& b) {return a -= b;}
+  friend Dual operator*(Dual a, const Dual& b) {return a *= b;}
+  friend Dual operator/(Dual a, const Dual& b) {return a /= b;}
+
+  friend bool operator<(const Dual& a, const Dual& b) {return a.value < b.value;}
+  friend bool operator>(const Dual& a, const Dual& b) {return a.value > b.value;}
+  friend bool operator<=(const Dual& a, const Dual& b) {return a.value <= b.value;}
+  friend bool operator>=(const Dual& a, const Dual& b) {return a.value >= b.value;}
+
+  friend Dual sin(const Dual& a) {return Dual(std::sin(a.value), a.derivatives * std::cos(a.value));}
+  friend Dual cos(const Dual& a) {return Dual(std::cos(a.value), a.derivatives * -std::sin(a.value));}
+  friend Dual tan(const Dual& a)
+  {
+    const float t = std::tan(a.value);
+    return Dual(t, a.derivatives * (1.f + t * t));
+  }
+  friend Dual atan2(const Dual& y, const Dual& x)
+  {
+    const float sqr = x.value * x.value + y.value * y.value;
+    return Dual(std::atan2(y.value, x.value), (y.derivatives * x.value - x.derivatives * y.value) / sqr);
+  }
+  friend Dual sqrt(const Dual& a)
+  {
+    const float root = std::sqrt(a.value);
+    return Dual(root, a.derivatives / (2.f * root));
+  }
+  friend Dual exp(const Dual& a)
+  {
+    const float e = std::exp(a.value);
+    return Dual(e, a.derivatives * e);
+  }
+  friend Dual log(const Dual& a) {return Dual(std::log(a.value), a.derivatives / a.value);}
+  friend Dual abs(const Dual& a) {return a.value < 0.f ? -a : a;}
+};
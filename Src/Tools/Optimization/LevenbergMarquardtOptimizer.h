@@ -0,0 +1,354 @@
+/**
+ * @file LevenbergMarquardtOptimizer.h
+ *
+ * This file declares and implements an optimizer for nonlinear least squares
+ * problems that uses the Levenberg-Marquardt algorithm. In contrast to the
+ * GaussNewtonOptimizer, it only accepts steps that reduce the error, it can
+ * reduce the influence of outliers by a robust loss function, it can use
+ * exact derivatives instead of numerical ones, and it evaluates the
+ * measurements in parallel.
+ */
+
+#pragma once
+
+#include "Dual.h"
+#include "Platform/BHAssert.h"
+#include "Tools/Math/Eigen.h"
+#include "Tools/WorkerPool.h"
+#include <Eigen/Cholesky>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <vector>
+
+template<size_t N>
+class LevenbergMarquardtOptimizer
+{
+public:
+  using Vector = Eigen::Matrix<float, N, 1>;
+
+  /** The functions that map the error of a measurement to its contribution to the total cost. */
+  enum class Loss
+  {
+    squared, /**< e² / 2, i.e. ordinary least squares. */
+    huber, /**< Quadratic up to the scale, linear beyond it. */
+    cauchy, /**< Logarithmic, i.e. large errors hardly have any influence. */
+  };
+
+  /**
+   * The problem to optimize. Different measurements are evaluated concurrently,
+   * but each measurement is only evaluated by a single thread at a time.
+   */
+  struct Functor
+  {
+    /**
+     * Calculate the error for the ith measurement given a set of parameters.
+     * @parameter measurement The index of the ith measurement.
+     */
+    virtual float operator()(const Vector& params, size_t measurement) const = 0;
+
+    /** The number of measurements. */
+    virtual size_t getNumOfMeasurements() const = 0;
+
+    /**
+     * Calculates the error for the ith measurement and its partial derivatives
+     * with respect to the parameters. If this is not supported, the derivatives
+     * are approximated by central differences.
+     * @param params The parameters.
+     * @param measurement The index of the ith measurement.
+     * @param error The error is returned here.
+     * @param gradient The partial derivatives of the error are returned here.
+     * @return Were the error and its derivatives calculated?
+     */
+    virtual bool gradient(const Vector&, size_t, float&, Vector&) const {return false;}
+  };
+
+  /**
+   * A functor whose derivatives are calculated by forward-mode automatic
+   * differentiation. The derived class must implement the error as a template
+   * that is instantiated for float and for Dual<N>:
+   * template<typename T> T error(const std::array<T, N>& params, size_t measurement) const;
+   */
+  template<typename Derived>
+  struct AutoDiffFunctor : Functor
+  {
+    float operator()(const Vector& params, size_t measurement) const override
+    {
+      std::array<float, N> values;
+      for(size_t i = 0; i < N; ++i)
+        values[i] = params(i);
+      return static_cast<const Derived*>(this)->error(values, measurement);
+    }
+
+    bool gradient(const Vector& params, size_t measurement, float& error, Vector& gradient) const override
+    {
+      std::array<Dual<N>, N> variables;
+      for(size_t i = 0; i < N; ++i)
+        variables[i] = Dual<N>::variable(params(i), i);
+      const Dual<N> result = static_cast<const Derived*>(this)->error(variables, measurement);
+      error = result.value;
+      gradient = result.derivatives;
+      return true;
+    }
+  };
+
+private:
+  using Matrix = Eigen::Matrix<float, N, N>;
+
+  /** The normal equations of a range of measurements. */
+  struct Normals
+  {
+    Matrix JtWJ = Matrix::Zero(); /**< Jᵀ W J, where W contains the weights of the robust loss. */
+    Vector JtWr = Vector::Zero(); /**< Jᵀ W r. */
+    float cost = 0.f; /**< The sum of the loss of all errors. */
+  };
+
+  static constexpr size_t minMeasurementsPerJob = 4; /**< Fewer measurements are not worth being evaluated by another thread. */
+  static constexpr float initialDamping = 1e-3f; /**< The damping before the first iteration. */
+  static constexpr float minDamping = 1e-7f; /**< The damping is never reduced below this value. */
+  static constexpr float maxDamping = 1e7f; /**< If the damping exceeds this value, no better parameters can be found. */
+  static constexpr float dampingFactor = 10.f; /**< The factor by which the damping changes after each step. */
+
+  const Functor& functor;
+  const Loss loss; /**< The robust loss function. */
+  const float lossScale; /**< The error beyond which the robust loss function reduces the influence of measurements. */
+  const bool parallel; /**< Should the measurements be evaluated by multiple threads? */
+  float damping = initialDamping; /**< The current damping, i.e. λ. */
+  VectorXf errors; /**< The errors for the parameters after the most recent iteration. */
+  VectorXf candidateErrors; /**< The errors for the parameters that are currently tested. */
+
+public:
+  /**
+   * Constructor.
+   * @param functor The problem to optimize.
+   * @param loss The robust loss function.
+   * @param lossScale The error beyond which the robust loss function reduces the influence of measurements.
+   * @param parallel Should the measurements be evaluated by multiple threads?
+   */
+  LevenbergMarquardtOptimizer(const Functor& functor, Loss loss = Loss::squared, float lossScale = 1.f, bool parallel = true) :
+    functor(functor), loss(loss), lossScale(lossScale), parallel(parallel) {}
+
+  /**
+   * Performs a single iteration. If a step does not reduce the cost, it is
+   * rejected and the damping is increased until a step succeeds.
+   * @param params The parameters that are optimized.
+   * @param epsilon The step sizes for approximating the derivatives numerically.
+   * @return The sum of the absolute changes of all parameters. It is 0 if no
+   *         step could reduce the cost.
+   */
+  float iterate(Vector& params, const Vector& epsilon);
+
+  /**
+   * Returns the errors for the current parameters, i.e. the parameters after
+   * the most recent iteration.
+   * @return The errors of all measurements.
+   */
+  const VectorXf& getErrors() const {return errors;}
+
+  /**
+   * Returns the current damping.
+   * @return λ.
+   */
+  float getDamping() const {return damping;}
+
+private:
+  /**
+   * Calculates the contribution of an error to the total cost and its weight
+   * in the normal equations (iteratively reweighted least squares).
+   * @param error The error of a measurement.
+   * @param weight The weight is returned here.
+   * @return The cost.
+   */
+  float applyLoss(float error, float& weight) const;
+
+  /**
+   * Executes a job for disjoint ranges of measurements in parallel and
+   * returns the results of all ranges.
+   * @param job The job. It is called with the first and the end index of a range.
+   * @return The results of all ranges.
+   */
+  template<typename Job>
+  std::vector<std::invoke_result_t<Job, size_t, size_t>> forEachRange(Job job) const;
+
+  /**
+   * Calculates the errors and the normal equations for the given parameters.
+   * @param params The parameters.
+   * @param epsilon The step sizes for approximating the derivatives numerically.
+   * @return The normal equations.
+   */
+  Normals linearize(const Vector& params, const Vector& epsilon);
+
+  /**
+   * Calculates the errors and the total cost for the given parameters.
+   * @param params The parameters.
+   * @param errorsOfParams The errors are returned here.
+   * @return The total cost.
+   */
+  float evaluate(const Vector& params, VectorXf& errorsOfParams) const;
+};
+
+template<size_t N>
+float LevenbergMarquardtOptimizer<N>::iterate(Vector& params, const Vector& epsilon)
+{
+  // See: https://en.wikipedia.org/wiki/Levenberg%E2%80%93Marquardt_algorithm
+
+  ASSERT(functor.getNumOfMeasurements() >= N);
+
+  const Normals normals = linearize(params, epsilon);
+
+  // Parameters that have no influence on the error would make the system singular.
+  const Vector scaling = normals.JtWJ.diagonal().cwiseMax(normals.JtWJ.diagonal().maxCoeff() * 1e-6f);
+  while(true)
+  {
+    Matrix dampedJtWJ = normals.JtWJ;
+    dampedJtWJ.diagonal() += damping * scaling;
+    const Vector s = dampedJtWJ.ldlt().solve(normals.JtWr);
+    const float sum = s.cwiseAbs().sum();
+    if(!std::isfinite(sum))
+      return sum;
+
+    const Vector candidate = params - s;
+    if(evaluate(candidate, candidateErrors) < normals.cost)
+    {
+      params = candidate;
+      errors.swap(candidateErrors);
+      damping = std::max(minDamping, damping / dampingFactor);
+      return sum;
+    }
+
+    damping *= dampingFactor;
+    if(damping > maxDamping)
+    {
+      damping = maxDamping;
+      return 0.f;
+    }
+  }
+}
+
+template<size_t N>
+float LevenbergMarquardtOptimizer<N>::applyLoss(float error, float& weight) const
+{
+  switch(loss)
+  {
+    case Loss::huber:
+    {
+      const float absError = std::abs(error);
+      if(absError <= lossScale)
+      {
+        weight = 1.f;
+        return 0.5f * error * error;
+      }
+      weight = lossScale / absError;
+      return lossScale * (absError - 0.5f * lossScale);
+    }
+    case Loss::cauchy:
+    {
+      const float sqrRelError = (error / lossScale) * (error / lossScale);
+      weight = 1.f / (1.f + sqrRelError);
+      return 0.5f * lossScale * lossScale * std::log1p(sqrRelError);
+    }
+    default:
+      weight = 1.f;
+      return 0.5f * error * error;
+  }
+}
+
+template<size_t N>
+template<typename Job>
+std::vector<std::invoke_result_t<Job, size_t, size_t>> LevenbergMarquardtOptimizer<N>::forEachRange(Job job) const
+{
+  using Result = std::invoke_result_t<Job, size_t, size_t>;
+
+  const size_t numOfMeasurements = functor.getNumOfMeasurements();
+  const size_t numOfRanges = parallel ? std::clamp(numOfMeasurements / minMeasurementsPerJob, size_t(1),
+                                                   WorkerPool::getShared().getNumOfWorkers() + 1) : 1;
+
+  // The calling thread evaluates the first range itself.
+  std::vector<std::future<Result>> futures;
+  futures.reserve(numOfRanges - 1);
+  for(size_t i = 1; i < numOfRanges; ++i)
+    futures.emplace_back(WorkerPool::getShared().run([&job, begin = numOfMeasurements * i / numOfRanges,
+                                                      end = numOfMeasurements * (i + 1) / numOfRanges]
+    {
+      return job(begin, end);
+    }));
+
+  std::vector<Result> results;
+  results.reserve(numOfRanges);
+  results.emplace_back(job(0, numOfMeasurements / numOfRanges));
+  for(std::future<Result>& future : futures)
+    results.emplace_back(future.get());
+  return results;
+}
+
+template<size_t N>
+typename LevenbergMarquardtOptimizer<N>::Normals LevenbergMarquardtOptimizer<N>::linearize(const Vector& params, const Vector& epsilon)
+{
+  std::array<Vector, N> paramsAbove;
+  std::array<Vector, N> paramsBelow;
+  for(size_t j = 0; j < N; ++j)
+  {
+    paramsAbove[j] = params;
+    paramsAbove[j](j) += epsilon(j);
+    paramsBelow[j] = params;
+    paramsBelow[j](j) -= epsilon(j);
+  }
+
+  errors.resize(functor.getNumOfMeasurements());
+  const std::vector<Normals> normalsOfRanges = forEachRange([&](size_t begin, size_t end)
+  {
+    Normals normals;
+    Vector gradient;
+    for(size_t i = begin; i < end; ++i)
+    {
+      float error;
+      if(!functor.gradient(params, i, error, gradient))
+      {
+        error = functor(params, i);
+        for(size_t j = 0; j < N; ++j)
+          gradient(j) = (functor(paramsAbove[j], i) - functor(paramsBelow[j], i)) / (2 * epsilon(j));
+      }
+      errors(i) = error;
+
+      float weight;
+      normals.cost += applyLoss(error, weight);
+      normals.JtWJ.template selfadjointView<Eigen::Lower>().rankUpdate(gradient, weight);
+      normals.JtWr += gradient * (weight * error);
+    }
+    return normals;
+  });
+
+  Normals normals;
+  for(const Normals& normalsOfRange : normalsOfRanges)
+  {
+    normals.JtWJ += normalsOfRange.JtWJ;
+    normals.JtWr += normalsOfRange.JtWr;
+    normals.cost += normalsOfRange.cost;
+  }
+  normals.JtWJ.template triangularView<Eigen::StrictlyUpper>() = normals.JtWJ.transpose();
+  return normals;
+}
+
+template<size_t N>
+float LevenbergMarquardtOptimizer<N>::evaluate(const Vector& params, VectorXf& errorsOfParams) const
+{
+  errorsOfParams.resize(functor.getNumOfMeasurements());
+  const std::vector<float> costs = forEachRange([&](size_t begin, size_t end)
+  {
+    float cost = 0.f;
+    float weight;
+    for(size_t i = begin; i < end; ++i)
+    {
+      errorsOfParams(i) = functor(params, i);
+      cost += applyLoss(errorsOfParams(i), weight);
+    }
+    return cost;
+  });
+
+  float cost = 0.f;
+  for(float costOfRange : costs)
+    cost += costOfRange;
+  return std::isfinite(cost) ? cost : std::numeric_limits<float>::max();
+}
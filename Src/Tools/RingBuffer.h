@@ -2,7 +2,8 @@
  * The file declares a ring buffer. The type of the elements must be assignable and
  * copyable. They do not need to provide a default constructor. The interface of the
  * class is similar to types of the standard template library and it also supports
- * for-each loops.
+ * for-each loops. The memory for the elements is only allocated when the first element
+ * is added, i.e. empty buffers, e.g. in temporary copies, do not allocate memory.
  * @author Thomas Röfer
  */
 
@@ -75,7 +76,7 @@ public:
    *                 the second template parameter is used as default capacity.
    */
   RingBuffer(std::size_t capacity = n) :
-    buffer(reinterpret_cast<T*>(Memory::alignedMalloc(capacity * sizeof(T)))),
+    buffer(nullptr),
     allocated(capacity)
   {}
 
@@ -84,7 +85,7 @@ public:
    * @param other The buffer this one is constructed from.
    */
   RingBuffer(const RingBuffer& other) :
-    buffer(reinterpret_cast<T*>(Memory::alignedMalloc(other.allocated * sizeof(T)))),
+    buffer(nullptr),
     allocated(other.allocated)
   {
     for(std::size_t i = other.entries; i-- > 0;)
@@ -106,11 +107,10 @@ public:
   RingBuffer& operator=(const RingBuffer& other)
   {
     clear();
-    if(allocated != other.allocated)
+    if(allocated != other.allocated && buffer)
     {
-      if(buffer)
-        Memory::alignedFree(reinterpret_cast<char*>(buffer));
-      buffer = reinterpret_cast<T*>(Memory::alignedMalloc(other.allocated * sizeof(T)));
+      Memory::alignedFree(reinterpret_cast<char*>(buffer));
+      buffer = nullptr;
     }
     allocated = other.allocated;
     head = 0;
@@ -136,6 +136,8 @@ public:
   void push_front(const T& value)
   {
     ASSERT(allocated);
+    if(!buffer)
+      buffer = reinterpret_cast<T*>(Memory::alignedMalloc(allocated * sizeof(T)));
     if(entries < allocated)
     {
       new(buffer + head) T(value);
@@ -182,7 +184,9 @@ public:
    */
   void reserve(std::size_t capacity)
   {
-    if(capacity != allocated)
+    if(capacity != allocated && !buffer)
+      allocated = capacity;
+    else if(capacity != allocated)
     {
       while(size() > capacity)
         pop_back();
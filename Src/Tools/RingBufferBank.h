@@ -0,0 +1,269 @@
+/**
+ * The file declares a bank of ring buffers of the same capacity that are filled
+ * synchronously, e.g. one buffer per joint that receives the measurement of its
+ * joint in each frame. All channels are stored in a single aligned block. Each
+ * row contains the values of all channels at one point in time, padded to the
+ * width of an SSE register. A whole frame is added at once and the statistics of
+ * all channels are computed together with SSE instructions. Like
+ * RingBufferWithSum, the bank maintains the sums of all channels, so that sums
+ * and averages are available in constant time. The elements must either be of
+ * type int or float.
+ */
+
+#pragma once
+
+#include "Platform/BHAssert.h"
+#include "Tools/ImageProcessing/SIMD.h"
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/** Overloads of the SSE operations used by the RingBufferBank for its element types. */
+namespace RingBufferBankLanes
+{
+  ALWAYSINLINE __m128 load(const float* p) {return _mm_load_ps(p);}
+  ALWAYSINLINE __m128i load(const int* p) {return _mm_load_si128(reinterpret_cast<const __m128i*>(p));}
+  ALWAYSINLINE void store(float* p, __m128 a) {_mm_store_ps(p, a);}
+  ALWAYSINLINE void store(int* p, __m128i a) {_mm_store_si128(reinterpret_cast<__m128i*>(p), a);}
+  ALWAYSINLINE __m128 add(__m128 a, __m128 b) {return _mm_add_ps(a, b);}
+  ALWAYSINLINE __m128i add(__m128i a, __m128i b) {return _mm_add_epi32(a, b);}
+  ALWAYSINLINE __m128 sub(__m128 a, __m128 b) {return _mm_sub_ps(a, b);}
+  ALWAYSINLINE __m128i sub(__m128i a, __m128i b) {return _mm_sub_epi32(a, b);}
+  ALWAYSINLINE __m128 min(__m128 a, __m128 b) {return _mm_min_ps(a, b);}
+  ALWAYSINLINE __m128 max(__m128 a, __m128 b) {return _mm_max_ps(a, b);}
+
+  // _mm_min_epi32 and _mm_max_epi32 require SSE4.1.
+  ALWAYSINLINE __m128i min(__m128i a, __m128i b)
+  {
+    const __m128i aSmaller = _mm_cmplt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(aSmaller, a), _mm_andnot_si128(aSmaller, b));
+  }
+
+  ALWAYSINLINE __m128i max(__m128i a, __m128i b)
+  {
+    const __m128i aGreater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(aGreater, a), _mm_andnot_si128(aGreater, b));
+  }
+
+  ALWAYSINLINE __m128 toFloat(__m128 a) {return a;}
+  ALWAYSINLINE __m128 toFloat(__m128i a) {return _mm_cvtepi32_ps(a);}
+}
+
+template<typename T, std::size_t channels, std::size_t n> class RingBufferBank
+{
+  static_assert(std::is_same<T, float>::value || std::is_same<T, int>::value, "Only int and float are supported");
+  static_assert(channels > 0 && n > 0, "The bank must not be empty");
+
+public:
+  using Frame = std::array<T, channels>; /**< The values of all channels at one point in time. */
+
+  /** The number of values per row, i.e. the number of channels rounded up to a multiple of 4. */
+  static constexpr std::size_t stride = (channels + 3) & ~std::size_t(3);
+
+private:
+  alignas(16) T rows[n][stride]; /**< The buffer. Each row stores one frame. */
+  alignas(16) T currentSum[stride]; /**< Sums of current round since row 0. */
+  alignas(16) T prevSum[stride]; /**< Sums of previous round. */
+  std::size_t head = 0; /**< The next row that will be used for push_front(). */
+  std::size_t entries = 0; /**< The number of frames in the buffer. */
+
+public:
+  /** Constructor. */
+  RingBufferBank()
+  {
+    // Padding values stay zero, so that they do not affect the results.
+    std::memset(rows, 0, sizeof(rows));
+    clear();
+  }
+
+  /** Empties all buffers. */
+  void clear()
+  {
+    std::memset(currentSum, 0, sizeof(currentSum));
+    std::memset(prevSum, 0, sizeof(prevSum));
+    head = 0;
+    entries = 0;
+  }
+
+  /**
+   * Adds a new frame to the front of all buffers. If the buffers were already full,
+   * the oldest frame is lost.
+   * @param frame The values of all channels.
+   */
+  void push_front(const Frame& frame)
+  {
+    using namespace RingBufferBankLanes;
+
+    T* row = rows[head];
+    if(full())
+      for(std::size_t i = 0; i < stride; i += 4)
+        store(prevSum + i, sub(load(prevSum + i), load(row + i)));
+
+    std::memcpy(row, frame.data(), sizeof(frame));
+    for(std::size_t i = 0; i < stride; i += 4)
+      store(currentSum + i, add(load(currentSum + i), load(row + i)));
+
+    head = (head + 1) % n;
+    if(entries < n)
+      ++entries;
+
+    // Prevent propagating errors from one round to another
+    if(head == 0)
+    {
+      std::memcpy(prevSum, currentSum, sizeof(prevSum));
+      std::memset(currentSum, 0, sizeof(currentSum));
+    }
+  }
+
+  /**
+   * Access to the individual entries of a buffer.
+   * @param channel The channel of the entry.
+   * @param index The index of the entry. Entry 0 was added last.
+   */
+  T operator()(std::size_t channel, std::size_t index) const
+  {
+    ASSERT(channel < channels && index < entries);
+    return rows[(n + head - index - 1) % n][channel];
+  }
+
+  /** The number of frames currently stored in the bank. */
+  std::size_t size() const {return entries;}
+
+  /** The maximum number of frames that can be stored in the bank. */
+  static constexpr std::size_t capacity() {return n;}
+
+  /** Is the bank empty? */
+  bool empty() const {return entries == 0;}
+
+  /** Is the bank full, i.e. will the next push_front() drop the oldest frame? */
+  bool full() const {return entries == n;}
+
+  /**
+   * Returns the sum of all entries of a channel in O(1).
+   * @param channel The channel.
+   */
+  T sum(std::size_t channel) const {ASSERT(channel < channels); return prevSum[channel] + currentSum[channel];}
+
+  /**
+   * Returns the average of all entries of a channel in O(1). For integers, the
+   * average is truncated as in RingBufferWithSum::average(). If the bank is empty,
+   * 0 is returned.
+   * @param channel The channel.
+   */
+  T average(std::size_t channel) const {return empty() ? T() : static_cast<T>(sum(channel) / static_cast<T>(entries));}
+
+  /** Returns the sums of all channels. */
+  Frame sums() const
+  {
+    using namespace RingBufferBankLanes;
+
+    alignas(16) T result[stride];
+    for(std::size_t i = 0; i < stride; i += 4)
+      store(result + i, add(load(prevSum + i), load(currentSum + i)));
+    return toFrame(result);
+  }
+
+  /** Returns the averages of all channels. See average(). */
+  Frame averages() const
+  {
+    Frame result = sums();
+    if(!empty())
+      for(T& value : result)
+        value = static_cast<T>(value / static_cast<T>(entries));
+    return result;
+  }
+
+  /**
+   * Returns the minima of all channels in O(size()).
+   * If the bank is empty, 0 is returned for all channels.
+   */
+  Frame minima() const
+  {
+    return reduce([](auto a, auto b) {return RingBufferBankLanes::min(a, b);});
+  }
+
+  /**
+   * Returns the maxima of all channels in O(size()).
+   * If the bank is empty, 0 is returned for all channels.
+   */
+  Frame maxima() const
+  {
+    return reduce([](auto a, auto b) {return RingBufferBankLanes::max(a, b);});
+  }
+
+  /**
+   * Returns the population variances of all channels in O(size()).
+   * If the bank is empty, 0 is returned for all channels.
+   */
+  std::array<float, channels> variances() const
+  {
+    using namespace RingBufferBankLanes;
+
+    alignas(16) float result[stride] = {0.f};
+    if(!empty())
+    {
+      const __m128 count = _mm_set1_ps(static_cast<float>(entries));
+      for(std::size_t i = 0; i < stride; i += 4)
+      {
+        const __m128 mean = _mm_div_ps(toFloat(add(load(prevSum + i), load(currentSum + i))), count);
+        __m128 squares = _mm_setzero_ps();
+        forEachRow([&](const T* row)
+        {
+          const __m128 deviation = _mm_sub_ps(toFloat(load(row + i)), mean);
+          squares = _mm_add_ps(squares, _mm_mul_ps(deviation, deviation));
+        });
+        _mm_store_ps(result + i, _mm_div_ps(squares, count));
+      }
+    }
+    std::array<float, channels> variances;
+    std::memcpy(variances.data(), result, sizeof(variances));
+    return variances;
+  }
+
+private:
+  /**
+   * Calls a function for all rows that contain frames.
+   * @param function The function. It is called with a pointer to the row.
+   */
+  template<typename Function> void forEachRow(Function function) const
+  {
+    for(std::size_t i = (n + head - entries) % n, j = 0; j < entries; ++j, i = i + 1 == n ? 0 : i + 1)
+      function(rows[i]);
+  }
+
+  /**
+   * Combines the rows containing frames with an operation.
+   * @param operation The operation that combines two registers.
+   * @return The combined values of all channels or 0 if the bank is empty.
+   */
+  template<typename Operation> Frame reduce(Operation operation) const
+  {
+    using namespace RingBufferBankLanes;
+
+    alignas(16) T result[stride] = {T()};
+    if(!empty())
+    {
+      const T* front = rows[(n + head - 1) % n];
+      for(std::size_t i = 0; i < stride; i += 4)
+      {
+        auto value = load(front + i);
+        forEachRow([&](const T* row) {value = operation(value, load(row + i));});
+        store(result + i, value);
+      }
+    }
+    return toFrame(result);
+  }
+
+  /**
+   * Copies the channels of a row.
+   * @param row The row.
+   * @return The values of all channels.
+   */
+  static Frame toFrame(const T* row)
+  {
+    Frame frame;
+    std::memcpy(frame.data(), row, sizeof(frame));
+    return frame;
+  }
+};
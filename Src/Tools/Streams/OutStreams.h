@@ -761,6 +761,11 @@ public:
    */
   const char* data() const { return buffer; }
 
+  /**
+   * Discards all bytes written so far. The memory is kept for reuse.
+   */
+  void clear() { bytes = 0; }
+
   /**
    * Obtain ownership of the memory. The caller must free the memory.
    * This stream looses access to the memory.
@@ -1185,6 +1190,12 @@ public:
    */
   OutMapMemory(bool singleLine = false, size_t capacity = 1024, char* buffer = nullptr);
 
+  /**
+   * Discards everything written so far. The memory is kept for reuse.
+   * Must only be called between complete values.
+   */
+  void clear() {stream.clear();}
+
   /**
    * Returns the number of written bytes
    */
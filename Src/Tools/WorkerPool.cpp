@@ -0,0 +1,56 @@
+/**
+ * @file WorkerPool.cpp
+ *
+ * This file implements a pool of worker threads that execute short jobs
+ * in parallel to the threads of the framework.
+ */
+
+#include "WorkerPool.h"
+#include "Platform/Thread.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t numOfWorkers)
+{
+  workers.reserve(std::max(numOfWorkers, size_t(1)));
+  for(size_t i = 0; i < std::max(numOfWorkers, size_t(1)); ++i)
+    workers.emplace_back(&WorkerPool::worker, this);
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    terminate = true;
+  }
+  jobAvailable.notify_all();
+  for(std::thread& worker : workers)
+    worker.join();
+}
+
+void WorkerPool::worker()
+{
+  Thread::nameCurrentThread("Worker");
+
+  while(true)
+  {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      jobAvailable.wait(lock, [this] { return terminate || !jobs.empty() || !urgentJobs.empty(); });
+      std::deque<std::function<void()>>& queue = urgentJobs.empty() ? jobs : urgentJobs;
+      if(queue.empty())
+        return;
+      job = std::move(queue.front());
+      queue.pop_front();
+    }
+    job();
+  }
+}
+
+WorkerPool& WorkerPool::getShared()
+{
+  // The pool is never destroyed. Otherwise, a forked child process, which has no
+  // worker threads, would wait forever for them to terminate when it exits.
+  static WorkerPool& pool = *new WorkerPool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+  return pool;
+}
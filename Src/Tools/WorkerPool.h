@@ -0,0 +1,86 @@
+/**
+ * @file WorkerPool.h
+ *
+ * This file declares a pool of worker threads that execute short jobs
+ * in parallel to the threads of the framework, e.g. the compression of
+ * the stripes of an image. The jobs are executed in the order in which they
+ * were issued, but urgent jobs are executed before all others. Their results
+ * are returned as futures.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool
+{
+public:
+  /** The priorities of jobs. */
+  enum class Priority
+  {
+    normal, /**< The job is executed after all jobs issued before. */
+    urgent, /**< The job is executed before all normal jobs not started yet, e.g. because the issuing thread waits for it. */
+  };
+
+private:
+  std::vector<std::thread> workers; /**< The worker threads. */
+  std::deque<std::function<void()>> jobs; /**< The normal jobs not started yet. */
+  std::deque<std::function<void()>> urgentJobs; /**< The urgent jobs not started yet. */
+  std::mutex mutex; /**< Synchronizes the access to the jobs and to the termination flag. */
+  std::condition_variable jobAvailable; /**< Signals that a job was added or that the workers should terminate. */
+  bool terminate = false; /**< Should the workers terminate? */
+
+  /** The main loop of each worker thread. */
+  void worker();
+
+public:
+  /**
+   * The constructor starts the worker threads.
+   * @param numOfWorkers The number of worker threads. At least one is started.
+   */
+  WorkerPool(size_t numOfWorkers);
+
+  /** The destructor executes all remaining jobs and stops the worker threads. */
+  ~WorkerPool();
+
+  /**
+   * Issues a job.
+   * @param job A function without parameters that will be executed by one of
+   *            the workers.
+   * @param priority The priority of the job.
+   * @return A future that becomes ready when the job has been executed. It
+   *         also contains the job's result.
+   */
+  template<typename F> std::future<std::invoke_result_t<F>> run(F&& job, Priority priority = Priority::normal)
+  {
+    auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(job));
+    std::future<std::invoke_result_t<F>> result = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      (priority == Priority::urgent ? urgentJobs : jobs).emplace_back([task] { (*task)(); });
+    }
+    jobAvailable.notify_one();
+    return result;
+  }
+
+  /**
+   * Returns the number of worker threads.
+   * @return The number of jobs that can be executed in parallel.
+   */
+  size_t getNumOfWorkers() const { return workers.size(); }
+
+  /**
+   * Returns the pool shared by all threads of this process. It is created
+   * when it is used for the first time and leaves one core for the thread
+   * that issues the jobs. It is never destroyed.
+   * @return The shared pool.
+   */
+  static WorkerPool& getShared();
+};
@@ -0,0 +1,335 @@
+#include "Platform/Memory.h"
+#include "Tools/Communication/MsgPack.h"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * A mock of LoLA, the interface to the hardware of the NAO. It sends packets
+ * with the same layout as LoLA through a Unix stream socket and expects an
+ * answer to each of them, just as NaoProvider does. The sensor values replayed
+ * are a function of the frame number, so that the receiver can check them.
+ */
+class MockLoLA
+{
+public:
+  static constexpr int numOfJoints = 25;
+  static constexpr size_t surplus = 5; /**< The number of bytes of the second packet sent together with the first one. They are the same in all packets. */
+  static constexpr std::chrono::microseconds period = std::chrono::microseconds(12000); /**< LoLA runs at 83 Hz. */
+
+  unsigned char packet[896]; /**< The packet sent. */
+  size_t packetSize; /**< The number of bytes of the packet. */
+  std::vector<unsigned char*> floats; /**< The addresses of all float values in the packet. */
+  int sockets[2]; /**< The socket of LoLA and the one of its client. */
+
+  /** Constructor. Creates the layout of the packets sent by LoLA. */
+  MockLoLA()
+  {
+    unsigned char* p = packet;
+    MsgPack::writeMapHeader(13, p);
+    writeFloats("Stiffness", numOfJoints, p);
+    writeFloats("Position", numOfJoints, p);
+    writeFloats("Temperature", numOfJoints, p);
+    writeFloats("Current", numOfJoints, p);
+    writeFloats("Battery", 4, p);
+    writeFloats("Accelerometer", 3, p);
+    writeFloats("Gyroscope", 3, p);
+    writeFloats("Angles", 2, p);
+    writeFloats("Sonar", 2, p);
+    writeFloats("FSR", 8, p);
+    writeFloats("Touch", 14, p);
+    MsgPack::write("Status", p);
+    MsgPack::writeArrayHeader(numOfJoints, p);
+    for(int i = 0; i < numOfJoints; ++i)
+      *p++ = static_cast<unsigned char>(i % 4); // msgpack positive fixint
+    MsgPack::write("RobotConfig", p);
+    MsgPack::writeArrayHeader(4, p);
+    for(const char* value : {"P0000073A07S94700103", "6.0", "P0000074A05S93Z00061", "6.0"})
+      MsgPack::write(value, p);
+    packetSize = p - packet;
+    EXPECT_LE(packetSize, sizeof(packet));
+    EXPECT_LT(surplus, static_cast<size_t>(floats[0] - packet));
+    EXPECT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+  }
+
+  /** Destructor. Closes the sockets. */
+  ~MockLoLA()
+  {
+    close(sockets[0]);
+    close(sockets[1]);
+  }
+
+  /** The value of a float in a frame. */
+  static float value(int frame, size_t index) {return static_cast<float>(frame) + static_cast<float>(index) * 0.001f;}
+
+  /**
+   * Sends packets to a client. Each packet is sent in two fragments. The
+   * first packet is followed by the beginning of the second one.
+   * @param socket The socket connected to the client.
+   * @param numOfFrames The number of packets sent.
+   * @param realTime Send packets at 83 Hz or as fast as possible?
+   * @return The number of packets the client answered.
+   */
+  int serve(int socket, int numOfFrames, bool realTime)
+  {
+    unsigned char buffer[sizeof(packet) + surplus];
+    unsigned char answer[1000];
+    auto next = std::chrono::steady_clock::now();
+    for(int frame = 0; frame < numOfFrames; ++frame)
+    {
+      for(size_t i = 0; i < floats.size(); ++i)
+        MsgPack::writeFloat(value(frame, i), floats[i]);
+
+      const size_t start = frame == 1 ? surplus : 0;
+      const size_t split = packetSize / (frame % 7 + 2);
+      if(send(socket, packet + start, split - start, MSG_NOSIGNAL) != static_cast<ssize_t>(split - start))
+        return frame;
+      std::this_thread::yield();
+      std::memcpy(buffer, packet + split, packetSize - split);
+      const size_t size = packetSize - split + (frame == 0 && numOfFrames > 1 ? surplus : 0);
+      std::memcpy(buffer + packetSize - split, packet, size - (packetSize - split));
+      if(send(socket, buffer, size, MSG_NOSIGNAL) != static_cast<ssize_t>(size)
+         || recv(socket, answer, sizeof(answer), 0) <= 0)
+        return frame;
+
+      if(realTime)
+        std::this_thread::sleep_until(next += period);
+    }
+    return numOfFrames;
+  }
+
+private:
+  void writeFloats(const char* name, int numOfValues, unsigned char*& p)
+  {
+    MsgPack::write(name, p);
+    MsgPack::writeArrayHeader(numOfValues, p);
+    for(int i = 0; i < numOfValues; ++i)
+      floats.push_back(MsgPack::write(0.f, p));
+  }
+};
+
+/**
+ * Receives packets from the mock LoLA in the same way as NaoProvider does.
+ * @param numOfFrames The number of packets received.
+ * @param realTime Send packets at 83 Hz or as fast as possible?
+ * @return The allocations after the first packet.
+ */
+static Memory::AllocationCounter receive(int numOfFrames, bool realTime = false)
+{
+  MockLoLA lola;
+  std::thread server([&lola, numOfFrames, realTime] {EXPECT_EQ(lola.serve(lola.sockets[0], numOfFrames, realTime), numOfFrames);});
+
+  unsigned char receivedPacket[896];
+  unsigned char packetToSend[100];
+  unsigned char* p = packetToSend;
+  MsgPack::writeMapHeader(1, p);
+  MsgPack::write("Position", p);
+  MsgPack::writeArrayHeader(1, p);
+  MsgPack::write(0.f, p);
+  const size_t packetToSendSize = p - packetToSend;
+
+  size_t receivedPacketSize = 0;
+  size_t bytesBuffered = 0;
+  std::vector<const unsigned char*> floats;
+  Memory::AllocationCounter allocations;
+  for(int frame = 0; frame < numOfFrames; ++frame)
+  {
+    if(receivedPacketSize && bytesBuffered >= receivedPacketSize)
+    {
+      bytesBuffered -= receivedPacketSize;
+      std::memmove(receivedPacket, receivedPacket + receivedPacketSize, bytesBuffered);
+    }
+
+    MsgPack::Entry entries[256];
+    size_t numOfEntries = 0;
+    const bool firstPacket = !receivedPacketSize;
+    while(!receivedPacketSize || bytesBuffered < receivedPacketSize)
+    {
+      const size_t bytesToRead = (receivedPacketSize ? receivedPacketSize : sizeof(receivedPacket)) - bytesBuffered;
+      const long bytesRead = bytesToRead ? recv(lola.sockets[1], receivedPacket + bytesBuffered, bytesToRead, 0) : 0;
+      if(bytesRead <= 0)
+      {
+        ADD_FAILURE() << "Could not receive packet " << frame;
+        break;
+      }
+      bytesBuffered += static_cast<size_t>(bytesRead);
+      if(!receivedPacketSize)
+        receivedPacketSize = MsgPack::parse(receivedPacket, bytesBuffered, entries, 256, numOfEntries);
+    }
+    if(!receivedPacketSize || bytesBuffered < receivedPacketSize)
+      break;
+
+    if(firstPacket)
+    {
+      EXPECT_EQ(receivedPacketSize, lola.packetSize);
+      for(size_t i = 0; i < numOfEntries; ++i)
+        if(entries[i].type == MsgPack::float32)
+          floats.push_back(entries[i].value);
+      EXPECT_EQ(floats.size(), lola.floats.size());
+      Memory::setAllocationCounter(&allocations);
+    }
+
+    for(size_t i = 0; i < floats.size(); ++i)
+      if(MsgPack::readFloat(floats[i]) != MockLoLA::value(frame, i))
+      {
+        ADD_FAILURE() << "Value " << i << " in frame " << frame << " differs";
+        break;
+      }
+
+    EXPECT_EQ(send(lola.sockets[1], packetToSend, packetToSendSize, 0), static_cast<ssize_t>(packetToSendSize));
+  }
+  Memory::setAllocationCounter(nullptr);
+  shutdown(lola.sockets[1], SHUT_RDWR); // Let the server stop if receiving failed.
+  server.join();
+  return allocations;
+}
+
+GTEST_TEST(MsgPack, parseFindsAllValues)
+{
+  MockLoLA lola;
+  MsgPack::Entry entries[256];
+  size_t numOfEntries;
+  EXPECT_EQ(MsgPack::parse(lola.packet, lola.packetSize, entries, 256, numOfEntries), lola.packetSize);
+  ASSERT_EQ(numOfEntries, lola.floats.size() + MockLoLA::numOfJoints + 4);
+
+  EXPECT_TRUE(entries[0].is("Stiffness"));
+  EXPECT_FALSE(entries[0].is("Stiff"));
+  EXPECT_FALSE(entries[0].is("Stiffnesses"));
+  EXPECT_TRUE(entries[MockLoLA::numOfJoints + 1].is("Position"));
+  EXPECT_EQ(entries[MockLoLA::numOfJoints + 1].index, 1);
+  EXPECT_EQ(entries[MockLoLA::numOfJoints + 1].value, lola.floats[MockLoLA::numOfJoints + 1]);
+
+  const MsgPack::Entry& status = entries[lola.floats.size() + 3];
+  EXPECT_TRUE(status.is("Status"));
+  EXPECT_EQ(status.type, MsgPack::positiveFixint);
+  EXPECT_EQ(*status.value, 3);
+
+  const MsgPack::Entry& robotConfig = entries[numOfEntries - 1];
+  EXPECT_TRUE(robotConfig.is("RobotConfig"));
+  EXPECT_EQ(robotConfig.type, MsgPack::fixstr);
+  EXPECT_EQ(robotConfig.index, 3);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(robotConfig.value), robotConfig.size), "6.0");
+
+  // The version with callbacks reports the same values.
+  size_t i = 0;
+  auto check = [&](const std::string& name, const unsigned char* p)
+  {
+    ASSERT_LT(i, numOfEntries);
+    EXPECT_EQ(name, std::string(entries[i].name, entries[i].nameLength) + ":" + std::to_string(entries[i].index));
+    EXPECT_EQ(p, entries[i++].value);
+  };
+  MsgPack::parse(lola.packet, lola.packetSize, check, check,
+                 [&](const std::string& name, const unsigned char* p, size_t) {check(name, p);});
+  EXPECT_EQ(i, numOfEntries);
+}
+
+GTEST_TEST(MsgPack, parseRejectsInvalidPackets)
+{
+  MockLoLA lola;
+  MsgPack::Entry entries[256];
+  size_t numOfEntries;
+  EXPECT_EQ(MsgPack::parse(lola.packet, lola.packetSize, entries, 10, numOfEntries), 0u);
+  EXPECT_EQ(numOfEntries, 10u);
+  EXPECT_EQ(MsgPack::parse(lola.packet + 1, lola.packetSize - 1, entries, 256, numOfEntries), 0u);
+  EXPECT_EQ(numOfEntries, 0u);
+}
+
+GTEST_TEST(MsgPack, parseDetectsPacketSize)
+{
+  MockLoLA lola;
+  MsgPack::Entry entries[256];
+  size_t numOfEntries;
+
+  // Incomplete packets are not parsed, no matter where they end.
+  for(size_t size = 0; size < lola.packetSize; ++size)
+    EXPECT_EQ(MsgPack::parse(lola.packet, size, entries, 256, numOfEntries), 0u) << "size " << size;
+  EXPECT_EQ(MsgPack::parse(lola.packet, 1 + 1 + 9 + 3 + 5 * 3 + 2, entries, 256, numOfEntries), 0u);
+  EXPECT_EQ(numOfEntries, 3u);
+
+  // Bytes behind the packet are not part of it.
+  unsigned char buffer[sizeof(lola.packet) + MockLoLA::surplus];
+  std::memcpy(buffer, lola.packet, lola.packetSize);
+  std::memcpy(buffer + lola.packetSize, lola.packet, MockLoLA::surplus);
+  EXPECT_EQ(MsgPack::parse(buffer, lola.packetSize + MockLoLA::surplus, entries, 256, numOfEntries), lola.packetSize);
+  EXPECT_EQ(numOfEntries, lola.floats.size() + MockLoLA::numOfJoints + 4);
+}
+
+GTEST_TEST(MsgPack, receiveFromMockLoLA)
+{
+  const Memory::AllocationCounter allocations = receive(500);
+  EXPECT_EQ(allocations.count, 0u);
+}
+
+GTEST_TEST(MsgPack, DISABLED_Benchmark)
+{
+  MockLoLA lola;
+  MsgPack::Entry entries[256];
+  constexpr int runs = 100000;
+  float sumCallbacks = 0.f;
+  float sumTable = 0.f;
+
+  auto start = std::chrono::steady_clock::now();
+  for(int run = 0; run < runs; ++run)
+    MsgPack::parse(lola.packet, lola.packetSize,
+                   [&sumCallbacks](const std::string&, const unsigned char* p) {sumCallbacks += MsgPack::readFloat(p);},
+                   [](const std::string&, const unsigned char*) {},
+                   [](const std::string&, const unsigned char*, size_t) {});
+  const double callbacks = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+
+  start = std::chrono::steady_clock::now();
+  for(int run = 0; run < runs; ++run)
+  {
+    size_t numOfEntries;
+    MsgPack::parse(lola.packet, lola.packetSize, entries, 256, numOfEntries);
+    for(size_t i = 0; i < numOfEntries; ++i)
+      if(entries[i].type == MsgPack::float32)
+        sumTable += MsgPack::readFloat(entries[i].value);
+  }
+  const double table = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+
+  EXPECT_EQ(sumCallbacks, sumTable);
+  std::printf("Parsing a LoLA packet: callbacks %.3f us, table %.3f us\n", callbacks, table);
+
+  // Soak test at LoLA's rate for one minute.
+  start = std::chrono::steady_clock::now();
+  const Memory::AllocationCounter allocations = receive(5000, true);
+  std::printf("Received 5000 packets in %.3f s with %u allocations\n",
+              std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), allocations.count);
+}
+
+/**
+ * A mock LoLA daemon. It serves packets at 83 Hz through the socket LoLA uses
+ * on the NAO until its client disconnects, e.g. to soak-test the framework on
+ * a Linux host. Run it with
+ * --gtest_also_run_disabled_tests --gtest_filter=MsgPack.DISABLED_MockLoLADaemon
+ */
+GTEST_TEST(MsgPack, DISABLED_MockLoLADaemon)
+{
+  MockLoLA lola;
+  sockaddr_un address;
+  address.sun_family = AF_UNIX;
+  std::strcpy(address.sun_path, "/tmp/robocup");
+  const int server = socket(AF_UNIX, SOCK_STREAM, 0);
+  ASSERT_GE(server, 0);
+  unlink(address.sun_path);
+  ASSERT_EQ(bind(server, reinterpret_cast<const sockaddr*>(&address), sizeof(address)), 0);
+  ASSERT_EQ(listen(server, 1), 0);
+  std::printf("Waiting for a client on %s\n", address.sun_path);
+  const int client = accept(server, nullptr, nullptr);
+  ASSERT_GE(client, 0);
+  const auto start = std::chrono::steady_clock::now();
+  const int frames = lola.serve(client, std::numeric_limits<int>::max(), true);
+  std::printf("Served %d packets in %.3f s\n", frames, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  close(client);
+  close(server);
+  unlink(address.sun_path);
+}
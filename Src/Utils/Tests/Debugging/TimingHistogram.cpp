@@ -0,0 +1,55 @@
+#include "Tools/Debugging/TimingHistogram.h"
+#include "Tools/Streams/InStreams.h"
+#include "Tools/Streams/OutStreams.h"
+
+#include "gtest/gtest.h"
+
+GTEST_TEST(TimingHistogram, buckets)
+{
+  unsigned lastIndex = 0;
+  for(unsigned value = 0; value < 1u << TimingHistogram::maxExponent; value += 1 + value / 1000)
+  {
+    const unsigned index = TimingHistogram::getIndex(value);
+    ASSERT_LT(index, TimingHistogram::numOfBuckets);
+    ASSERT_LE(lastIndex, index);
+    ASSERT_LE(TimingHistogram::getLowerBound(index), value);
+    ASSERT_GE(TimingHistogram::getUpperBound(index), value);
+    ASSERT_LE(TimingHistogram::getUpperBound(index) - TimingHistogram::getLowerBound(index), value / TimingHistogram::subBuckets);
+    lastIndex = index;
+  }
+  EXPECT_EQ(TimingHistogram::getIndex(1u << TimingHistogram::maxExponent), TimingHistogram::numOfBuckets - 1);
+  EXPECT_EQ(TimingHistogram::getIndex(0xffffffff), TimingHistogram::numOfBuckets - 1);
+  for(unsigned index = 0; index < TimingHistogram::numOfBuckets - 1; ++index)
+    EXPECT_EQ(TimingHistogram::getUpperBound(index) + 1, TimingHistogram::getLowerBound(index + 1));
+}
+
+GTEST_TEST(TimingHistogram, percentiles)
+{
+  TimingHistogram histogram;
+  EXPECT_EQ(histogram.getPercentile(0.5f), 0u);
+  for(unsigned value = 1; value <= 1000; ++value)
+    histogram.add(value * 10);
+  EXPECT_EQ(histogram.getTotal(), 1000u);
+  EXPECT_EQ(TimingHistogram::getIndex(histogram.getPercentile(0.5f)), TimingHistogram::getIndex(5000));
+  EXPECT_EQ(TimingHistogram::getIndex(histogram.getPercentile(0.99f)), TimingHistogram::getIndex(9900));
+  EXPECT_EQ(TimingHistogram::getIndex(histogram.getPercentile(1.f)), TimingHistogram::getIndex(10000));
+  EXPECT_EQ(TimingHistogram::getIndex(histogram.getPercentile(0.f)), TimingHistogram::getIndex(10));
+}
+
+GTEST_TEST(TimingHistogram, streaming)
+{
+  TimingHistogram histogram;
+  for(unsigned value : {3u, 3u, 250u, 17000u, 5000000u, 0xffffffffu})
+    histogram.add(value);
+
+  OutBinaryMemory out;
+  histogram.write(out);
+  InBinaryMemory in(out.data(), out.size());
+  TimingHistogram copy;
+  copy.add(42);
+  copy.read(in);
+
+  EXPECT_EQ(copy.getTotal(), histogram.getTotal());
+  for(unsigned index = 0; index < TimingHistogram::numOfBuckets; ++index)
+    EXPECT_EQ(copy.getCount(index), histogram.getCount(index));
+}
@@ -0,0 +1,67 @@
+#include "Tools/Framework/TripleBuffer.h"
+
+#include "gtest/gtest.h"
+#include <thread>
+
+/** Data that would be torn if producer and consumer accessed the same buffer. */
+struct Data
+{
+  unsigned first = 0;
+  unsigned values[64];
+  unsigned last = 0;
+};
+
+GTEST_TEST(TripleBuffer, singleThread)
+{
+  TripleBuffer<unsigned> buffer;
+  EXPECT_FALSE(buffer.consume());
+  buffer.getWriteBuffer() = 1;
+  buffer.publish();
+  buffer.getWriteBuffer() = 2;
+  buffer.publish();
+  ASSERT_TRUE(buffer.consume());
+  EXPECT_EQ(buffer.getReadBuffer(), 2u);
+  EXPECT_FALSE(buffer.consume());
+  buffer.getWriteBuffer() = 3;
+  buffer.publish();
+  ASSERT_TRUE(buffer.consume());
+  EXPECT_EQ(buffer.getReadBuffer(), 3u);
+}
+
+GTEST_TEST(TripleBuffer, producerAndConsumer)
+{
+  static constexpr unsigned numOfVersions = 200000;
+  TripleBuffer<Data> buffer;
+
+  std::thread producer([&buffer]
+  {
+    for(unsigned version = 1; version <= numOfVersions; ++version)
+    {
+      Data& data = buffer.getWriteBuffer();
+      data.first = version;
+      for(unsigned& value : data.values)
+        value = version;
+      data.last = version;
+      buffer.publish();
+    }
+  });
+
+  unsigned lastVersion = 0;
+  unsigned received = 0;
+  while(lastVersion < numOfVersions)
+    if(buffer.consume())
+    {
+      const Data& data = buffer.getReadBuffer();
+      ASSERT_EQ(data.first, data.last);
+      for(unsigned value : data.values)
+        ASSERT_EQ(value, data.first);
+      ASSERT_GT(data.first, lastVersion);
+      lastVersion = data.first;
+      ++received;
+    }
+  producer.join();
+
+  EXPECT_EQ(lastVersion, numOfVersions);
+  EXPECT_FALSE(buffer.consume());
+  EXPECT_GT(received, 0u);
+}
@@ -0,0 +1,178 @@
+#include "Tools/ImageProcessing/HoughLines.h"
+#include "Tools/Math/Angle.h"
+#include "Tools/Math/BHMath.h"
+#include "Tools/Math/Eigen.h"
+#include "Tools/Math/Random.h"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+
+static constexpr int numOfAngles = 1800;
+
+/** The sine/cosine lookup tables as created by the AutomaticCameraCalibrator. */
+struct LookUpTables
+{
+  std::vector<float> cosAngles, sinAngles;
+
+  LookUpTables()
+  {
+    int index = 0;
+    for(float deg = 0.f; index < numOfAngles; ++index, deg += pi / numOfAngles)
+    {
+      cosAngles.push_back(std::cos(deg));
+      sinAngles.push_back(std::sin(deg));
+    }
+  }
+};
+
+static const LookUpTables tables;
+
+/** The previous implementation in the AutomaticCameraCalibrator as a reference. */
+static void referenceFindLocalMaxima(const Sobel::SobelImage& sobelImage, float thresh, int minIndex, int maxIndex, int dMax, std::vector<HoughLines::Maximum>& localMaxima)
+{
+  std::vector<std::vector<int>> houghSpace(numOfAngles, std::vector<int>(2 * dMax + 1, 0));
+  for(unsigned int y = 1; y < sobelImage.height - 1; ++y)
+    for(unsigned int x = 1; x < sobelImage.width - 1; ++x)
+    {
+      const Sobel::SobelPixel& pixel = sobelImage[y][x];
+      if(pixel.x * pixel.x + pixel.y * pixel.y >= thresh)
+      {
+        for(int index = minIndex; index != maxIndex; ++index)
+        {
+          int d = static_cast<int>(std::ceil(x * tables.cosAngles[index] + y * tables.sinAngles[index]));
+          ++houghSpace[index][d + dMax];
+          if(minIndex > maxIndex && index == numOfAngles - 1)
+            index = -1;
+        }
+      }
+    }
+
+  const int maxDisIndex = static_cast<int>(houghSpace[0].size());
+  auto localMaximum = [&houghSpace, maxDisIndex](const int value, const int angleIndex, const int distanceIndex) -> bool
+  {
+    for(int i = -1; i <= 1; ++i)
+    {
+      int index = ((angleIndex + i) + numOfAngles) % numOfAngles;
+      for(int j = std::max(0, distanceIndex - 1); j <= std::min(maxDisIndex - 1, distanceIndex + 1); ++j)
+      {
+        if(index == angleIndex && j == distanceIndex)
+          continue;
+        if(houghSpace[index][j] > value)
+          return false;
+      }
+    }
+    return true;
+  };
+
+  for(int angleIndex = minIndex; angleIndex != maxIndex; ++angleIndex)
+  {
+    for(int distanceIndex = 0; distanceIndex < maxDisIndex; ++distanceIndex)
+    {
+      int value = houghSpace[angleIndex][distanceIndex];
+      if(value != 0 && localMaximum(value, angleIndex, distanceIndex))
+        localMaxima.push_back({value, angleIndex, distanceIndex});
+    }
+    if(minIndex > maxIndex && angleIndex == numOfAngles - 1)
+      angleIndex = -1;
+  }
+}
+
+/** An image patch around a field line as extracted by the AutomaticCameraCalibrator. */
+struct Patch
+{
+  Sobel::SobelImage sobelImage;
+  float thresh;
+  int minIndex;
+  int maxIndex;
+  int dMax;
+
+  /**
+   * Draws a noisy field line into a gray image and calculates its Sobel image.
+   * @param width The width of the patch. Must be a multiple of 16.
+   * @param height The height of the patch.
+   */
+  Patch(unsigned width, unsigned height)
+  {
+    const Angle direction = Random::uniform(-pi_4, pi_4);
+    const Vector2f normal(-std::sin(direction), std::cos(direction));
+    const Vector2f center(width * 0.5f + Random::uniform(-5.f, 5.f), height * 0.5f + Random::uniform(-5.f, 5.f));
+    const float lineWidth = Random::uniform(3.f, 12.f);
+    Sobel::Image1D grayImage(width, height, sizeof(Sobel::Image1D::PixelType));
+    for(unsigned y = 0; y < height; ++y)
+      for(unsigned x = 0; x < width; ++x)
+        grayImage[y][x] = static_cast<unsigned char>((std::abs(normal.dot(Vector2f(x, y) - center)) < lineWidth * 0.5f ? 200 : 80) +
+                                                     Random::uniformInt(0, 20));
+    Sobel::sobelSSE(grayImage, sobelImage);
+
+    int maxValue = 0;
+    for(unsigned y = 1; y < height - 1; ++y)
+      for(unsigned x = 1; x < width - 1; ++x)
+        maxValue = std::max(maxValue, sobelImage[y][x].x * sobelImage[y][x].x + sobelImage[y][x].y * sobelImage[y][x].y);
+    thresh = sqr(std::sqrt(static_cast<float>(maxValue)) * 0.25f);
+
+    // The angle range of the normal as calculated in AutomaticCameraCalibrator::fitLine.
+    const float angle = std::fmod(static_cast<float>(Angle::normalize(direction + pi_2) + pi), static_cast<float>(pi));
+    const float minAngle = std::fmod(static_cast<float>(Angle::normalize(angle - 10_deg) + pi), static_cast<float>(pi));
+    const float maxAngle = std::fmod(static_cast<float>(Angle::normalize(angle + 10_deg) + pi), static_cast<float>(pi));
+    minIndex = static_cast<int>(minAngle * numOfAngles / pi) % numOfAngles;
+    maxIndex = static_cast<int>(maxAngle * numOfAngles / pi) % numOfAngles;
+    dMax = static_cast<int>(std::ceil(std::hypot(height, width)));
+  }
+};
+
+GTEST_TEST(HoughLines, sameAsReference)
+{
+  for(int run = 0; run < 30; ++run)
+  {
+    Patch patch(Random::uniformInt(2, 40) * 16, Random::uniformInt(32, 200));
+    // Also test ranges that wrap around.
+    if(run % 3 == 0)
+    {
+      patch.minIndex = Random::uniformInt(numOfAngles - 150, numOfAngles - 1);
+      patch.maxIndex = (patch.minIndex + 200) % numOfAngles;
+    }
+
+    std::vector<HoughLines::Maximum> expected;
+    std::vector<HoughLines::Maximum> localMaxima;
+    referenceFindLocalMaxima(patch.sobelImage, patch.thresh, patch.minIndex, patch.maxIndex, patch.dMax, expected);
+    HoughLines::findLocalMaxima(patch.sobelImage, patch.thresh, tables.cosAngles, tables.sinAngles, patch.minIndex, patch.maxIndex, patch.dMax, localMaxima);
+
+    ASSERT_EQ(expected.size(), localMaxima.size());
+    for(size_t i = 0; i < expected.size(); ++i)
+    {
+      EXPECT_EQ(expected[i].maxAcc, localMaxima[i].maxAcc);
+      EXPECT_EQ(expected[i].angleIndex, localMaxima[i].angleIndex);
+      EXPECT_EQ(expected[i].distanceIndex, localMaxima[i].distanceIndex);
+    }
+  }
+}
+
+GTEST_TEST(HoughLines, DISABLED_Benchmark)
+{
+  // Patch sizes of lines in images of 640x480 and of 1280x960 pixels.
+  for(const auto& [width, height] : {std::make_pair(128u, 32u), std::make_pair(320u, 48u), std::make_pair(640u, 96u)})
+  {
+    const Patch patch(width, height);
+    const int repetitions = 20000000 / (width * height);
+    std::vector<HoughLines::Maximum> localMaxima;
+
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < repetitions; ++i)
+    {
+      localMaxima.clear();
+      referenceFindLocalMaxima(patch.sobelImage, patch.thresh, patch.minIndex, patch.maxIndex, patch.dMax, localMaxima);
+    }
+    const double reference = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+    start = std::chrono::steady_clock::now();
+    for(int i = 0; i < repetitions; ++i)
+    {
+      localMaxima.clear();
+      HoughLines::findLocalMaxima(patch.sobelImage, patch.thresh, tables.cosAngles, tables.sinAngles, patch.minIndex, patch.maxIndex, patch.dMax, localMaxima);
+    }
+    const double optimized = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+    std::printf("%3ux%2u pixels: reference %.3f ms, optimized %.3f ms\n", width, height, reference, optimized);
+  }
+}
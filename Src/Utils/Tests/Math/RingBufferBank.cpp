@@ -0,0 +1,137 @@
+#include "Tools/Math/Random.h"
+#include "Tools/RingBufferBank.h"
+#include "Tools/RingBufferWithSum.h"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Fills a bank and one RingBufferWithSum per channel with the same random values
+ * and compares their statistics after each frame.
+ */
+template<typename T, std::size_t channels, std::size_t n> static void compareWithRingBufferWithSum(T min, T max)
+{
+  RingBufferBank<T, channels, n> bank;
+  std::vector<RingBufferWithSum<T, n>> buffers(channels);
+  EXPECT_TRUE(bank.empty());
+
+  for(std::size_t frame = 0; frame < 3 * n + 1; ++frame)
+  {
+    typename RingBufferBank<T, channels, n>::Frame values;
+    for(std::size_t channel = 0; channel < channels; ++channel)
+    {
+      if constexpr(std::is_integral<T>::value)
+        values[channel] = Random::uniformInt(min, max);
+      else
+        values[channel] = Random::uniform(min, max);
+      buffers[channel].push_front(values[channel]);
+    }
+    bank.push_front(values);
+
+    ASSERT_EQ(bank.size(), buffers[0].size());
+    ASSERT_EQ(bank.full(), buffers[0].full());
+    const auto sums = bank.sums();
+    const auto averages = bank.averages();
+    const auto minima = bank.minima();
+    const auto maxima = bank.maxima();
+    const auto variances = bank.variances();
+    for(std::size_t channel = 0; channel < channels; ++channel)
+    {
+      const RingBufferWithSum<T, n>& buffer = buffers[channel];
+      // The sums are computed in the same order, so even floats must be identical.
+      EXPECT_EQ(sums[channel], buffer.sum());
+      EXPECT_EQ(bank.sum(channel), buffer.sum());
+      EXPECT_EQ(averages[channel], buffer.average());
+      EXPECT_EQ(bank.average(channel), buffer.average());
+      EXPECT_EQ(minima[channel], buffer.minimum());
+      EXPECT_EQ(maxima[channel], buffer.maximum());
+      EXPECT_EQ(bank(channel, 0), buffer.front());
+      EXPECT_EQ(bank(channel, bank.size() - 1), buffer.back());
+
+      float mean = 0.f;
+      for(T value : buffer)
+        mean += static_cast<float>(value);
+      mean /= static_cast<float>(buffer.size());
+      float variance = 0.f;
+      for(T value : buffer)
+        variance += (static_cast<float>(value) - mean) * (static_cast<float>(value) - mean);
+      variance /= static_cast<float>(buffer.size());
+      EXPECT_NEAR(variances[channel], variance, 1e-3f * std::max(1.f, variance));
+    }
+  }
+}
+
+GTEST_TEST(RingBufferBank, int)
+{
+  // RingBufferWithSum divides by an unsigned size, i.e. its averages of negative integers are wrong.
+  compareWithRingBufferWithSum<int, 26, 20>(0, 2000);
+  compareWithRingBufferWithSum<int, 1, 7>(0, 1);
+}
+
+GTEST_TEST(RingBufferBank, float)
+{
+  compareWithRingBufferWithSum<float, 3, 27>(-1.f, 1.f);
+  compareWithRingBufferWithSum<float, 9, 5>(0.f, 100.f);
+}
+
+GTEST_TEST(RingBufferBank, clear)
+{
+  RingBufferBank<int, 5, 4> bank;
+  for(int i = 0; i < 6; ++i)
+    bank.push_front({i, i, i, i, i});
+  bank.clear();
+  EXPECT_TRUE(bank.empty());
+  EXPECT_EQ(bank.sums(), (RingBufferBank<int, 5, 4>::Frame{0, 0, 0, 0, 0}));
+  EXPECT_EQ(bank.maxima(), (RingBufferBank<int, 5, 4>::Frame{0, 0, 0, 0, 0}));
+  bank.push_front({1, 2, 3, 4, 5});
+  EXPECT_EQ(bank.averages(), (RingBufferBank<int, 5, 4>::Frame{1, 2, 3, 4, 5}));
+  bank.push_front({-8, -8, 0, 0, 0});
+  EXPECT_EQ(bank.averages(), (RingBufferBank<int, 5, 4>::Frame{-3, -3, 1, 2, 2}));
+}
+
+GTEST_TEST(RingBufferBank, DISABLED_Benchmark)
+{
+  // 25 joints with 100 samples each. Each frame, a new sample is added to all joints
+  // and the averages, minima, and maxima are determined.
+  constexpr std::size_t joints = 25;
+  constexpr std::size_t samples = 100;
+  constexpr int frames = 200000;
+  std::vector<std::array<int, joints>> values(1000);
+  for(auto& frame : values)
+    for(int& value : frame)
+      value = Random::uniformInt(0, 2000);
+
+  long long checksum = 0;
+  std::vector<RingBufferWithSum<int, samples>> buffers(joints);
+  auto start = std::chrono::steady_clock::now();
+  for(int frame = 0; frame < frames; ++frame)
+  {
+    const auto& frameValues = values[frame % values.size()];
+    for(std::size_t joint = 0; joint < joints; ++joint)
+    {
+      buffers[joint].push_front(frameValues[joint]);
+      checksum += buffers[joint].average() + buffers[joint].minimum() + buffers[joint].maximum();
+    }
+  }
+  const double reference = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / frames;
+
+  RingBufferBank<int, joints, samples> bank;
+  start = std::chrono::steady_clock::now();
+  for(int frame = 0; frame < frames; ++frame)
+  {
+    bank.push_front(values[frame % values.size()]);
+    const auto averages = bank.averages();
+    const auto minima = bank.minima();
+    const auto maxima = bank.maxima();
+    for(std::size_t joint = 0; joint < joints; ++joint)
+      checksum -= averages[joint] + minima[joint] + maxima[joint];
+  }
+  const double optimized = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / frames;
+
+  EXPECT_EQ(checksum, 0);
+  std::printf("%u joints x %u samples: RingBufferWithSum %.3f us, RingBufferBank %.3f us per frame\n",
+              static_cast<unsigned>(joints), static_cast<unsigned>(samples), reference, optimized);
+}
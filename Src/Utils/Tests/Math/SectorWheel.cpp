@@ -0,0 +1,209 @@
+#include "Tools/BehaviorControl/SectorWheel.h"
+#include "Tools/Math/Random.h"
+#include "Tools/Math/Sector.h"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <list>
+
+/** The previous implementation of SectorWheel based on a linked list as a reference. */
+class ListSectorWheel
+{
+public:
+  using Sector = SectorWheel::Sector;
+
+  void begin()
+  {
+    wheel.clear();
+    wheel.emplace_back(Rangea(-pi, pi), std::numeric_limits<float>::max(), Sector::free);
+  }
+
+  void addSector(const Rangea& angleRange, float distance, Sector::Type type)
+  {
+    if(angleRange.min == angleRange.max)
+      return;
+    if(angleRange.min > angleRange.max)
+    {
+      addSectorNormalized(Rangea(angleRange.min, pi), distance, type);
+      addSectorNormalized(Rangea(-pi, angleRange.max), distance, type);
+    }
+    else
+      addSectorNormalized(angleRange, distance, type);
+  }
+
+  void addSectorNormalized(const Rangea& angleRange, float distance, Sector::Type type)
+  {
+    if(angleRange.max == angleRange.min)
+      return;
+
+    bool contiguous = false;
+    auto currentContiguousPart = wheel.end();
+    for(auto it = wheel.begin(); it != wheel.end(); ++it)
+    {
+      if(it->angleRange.max <= angleRange.min)
+        continue;
+      if(it->angleRange.min >= angleRange.max)
+        break;
+      if(distance > it->distance)
+      {
+        contiguous = false;
+        continue;
+      }
+
+      const Sector currentSector = *it;
+      auto nextIt = std::next(it);
+      if(it->angleRange.min < angleRange.min)
+        it->angleRange.max = angleRange.min;
+      else
+        nextIt = wheel.erase(it);
+
+      if(contiguous)
+        currentContiguousPart->angleRange.max = std::min(currentSector.angleRange.max, angleRange.max), it = currentContiguousPart;
+      else
+        it = wheel.emplace(nextIt, Rangea(std::max(angleRange.min, currentSector.angleRange.min), std::min(currentSector.angleRange.max, angleRange.max)), distance, type);
+
+      if((contiguous = currentSector.angleRange.max <= it->angleRange.max))
+        currentContiguousPart = it;
+      else
+        it = wheel.emplace(nextIt, Rangea(it->angleRange.max, currentSector.angleRange.max), currentSector.distance, currentSector.type);
+    }
+  }
+
+  std::list<Sector> wheel;
+};
+
+/** An obstacle as seen from the center of the wheel. */
+struct TestObstacle
+{
+  Rangea angleRange;
+  float distance;
+  SectorWheel::Sector::Type type;
+};
+
+static std::vector<TestObstacle> createObstacles(size_t numOfObstacles)
+{
+  std::vector<TestObstacle> obstacles;
+  for(size_t i = 0; i < numOfObstacles; ++i)
+  {
+    const Angle direction = Random::uniform(-pi, pi);
+    const Angle radius = Random::uniform(0.02f, 0.5f);
+    obstacles.push_back({Rangea(Angle::normalize(direction - radius), Angle::normalize(direction + radius)),
+                         static_cast<float>(Random::uniformInt(1, 20) * 500), // Equal distances must occur
+                         Random::bernoulli(0.3) ? SectorWheel::Sector::teammate : SectorWheel::Sector::obstacle});
+  }
+  return obstacles;
+}
+
+GTEST_TEST(SectorWheel, sameAsList)
+{
+  SectorWheel wheel;
+  ListSectorWheel reference;
+  for(int run = 0; run < 500; ++run)
+  {
+    wheel.begin(Vector2f::Zero());
+    reference.begin();
+    for(const TestObstacle& obstacle : createObstacles(Random::uniformInt(0, 30)))
+    {
+      wheel.addSector(obstacle.angleRange, obstacle.distance, obstacle.type);
+      reference.addSector(obstacle.angleRange, obstacle.distance, obstacle.type);
+    }
+
+    const std::vector<SectorWheel::Sector>& sectors = wheel.finishWithoutCircleClosure();
+    ASSERT_EQ(reference.wheel.size(), sectors.size());
+    auto expected = reference.wheel.begin();
+    for(const SectorWheel::Sector& sector : sectors)
+    {
+      EXPECT_EQ(expected->angleRange.min, sector.angleRange.min);
+      EXPECT_EQ(expected->angleRange.max, sector.angleRange.max);
+      EXPECT_EQ(expected->distance, sector.distance);
+      EXPECT_EQ(expected->type, sector.type);
+      ++expected;
+    }
+  }
+}
+
+GTEST_TEST(SectorList, coverage)
+{
+  for(int run = 0; run < 200; ++run)
+  {
+    SectorList sectors;
+    std::vector<std::pair<Sector, bool>> operations;
+    for(int i = Random::uniformInt(1, 20); i > 0; --i)
+    {
+      const Angle direction = Random::uniform(-pi, pi);
+      const Sector sector = Sector::centeredSector(direction, Random::uniform(0.05f, 2.f));
+      const bool add = !Random::bernoulli(0.2);
+      operations.emplace_back(sector, add);
+      if(add)
+        sectors.addSector(sector);
+      else
+        sectors.subtractSector(sector);
+    }
+
+    // Sectors must be disjoint and each must contain its center.
+    for(const Sector& sector : sectors)
+      EXPECT_TRUE(sector.isInside(sector.getCenter()));
+
+    for(int i = 0; i < 360; ++i)
+    {
+      const Angle angle = Angle::normalize(-pi + (i + 0.5f) * pi2 / 360.f);
+      bool expected = false;
+      bool ambiguous = false;
+      for(const auto& [sector, add] : operations)
+      {
+        ambiguous |= std::abs(Angle::normalize(angle - sector.min)) < 1e-4f || std::abs(Angle::normalize(angle - sector.max)) < 1e-4f;
+        if(sector.isInside(angle))
+          expected = add;
+      }
+      if(ambiguous)
+        continue;
+      int inside = 0;
+      for(const Sector& sector : sectors)
+        inside += sector.isInside(angle) ? 1 : 0;
+      EXPECT_EQ(expected ? 1 : 0, inside) << "angle " << angle;
+    }
+  }
+}
+
+GTEST_TEST(SectorWheel, DISABLED_Benchmark)
+{
+  constexpr int repetitions = 10000;
+  SectorWheel wheel;
+  ListSectorWheel reference;
+  SectorList sectorList;
+  for(size_t numOfObstacles : {5, 10, 20, 30})
+  {
+    const std::vector<TestObstacle> obstacles = createObstacles(numOfObstacles);
+
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < repetitions; ++i)
+    {
+      reference.begin();
+      for(const TestObstacle& obstacle : obstacles)
+        reference.addSector(obstacle.angleRange, obstacle.distance, obstacle.type);
+    }
+    const double list = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+    start = std::chrono::steady_clock::now();
+    for(int i = 0; i < repetitions; ++i)
+    {
+      wheel.begin(Vector2f::Zero());
+      for(const TestObstacle& obstacle : obstacles)
+        wheel.addSector(obstacle.angleRange, obstacle.distance, obstacle.type);
+      wheel.finishWithoutCircleClosure();
+    }
+    const double flat = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+    start = std::chrono::steady_clock::now();
+    for(int i = 0; i < repetitions; ++i)
+    {
+      sectorList.clear();
+      for(const TestObstacle& obstacle : obstacles)
+        sectorList.addSector(Sector(obstacle.angleRange.min, obstacle.angleRange.max));
+    }
+    const double union_ = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+    std::printf("%2zu obstacles: list wheel %.2f us, flat wheel %.2f us, sector list %.2f us\n", numOfObstacles, list, flat, union_);
+  }
+}
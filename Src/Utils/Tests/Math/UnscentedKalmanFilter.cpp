@@ -0,0 +1,68 @@
+#include "Tools/Math/UnscentedKalmanFilter.h"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <functional>
+
+using Vector5f = Eigen::Matrix<float, 5, 1>;
+using Matrix5f = Eigen::Matrix<float, 5, 5>;
+
+GTEST_TEST(UnscentedKalmanFilter, sameWithFunctionAndLambda)
+{
+  UKF<2> withFunction(Vector2f::Zero());
+  UKF<2> withLambda(Vector2f::Zero());
+  withFunction.init(Vector2f(1.f, 2.f), Matrix2f::Identity());
+  withLambda.init(Vector2f(1.f, 2.f), Matrix2f::Identity());
+  auto dynamicModel = [](Vector2f& state) { state.x() += state.y() * 0.01f; };
+  auto measurementModel = [](const Vector2f& state) { return state.x(); };
+  auto measurementModel2 = [](const Vector2f& state) { return Vector2f(state.x() + state.y(), state.y()); };
+  for(int i = 0; i < 100; ++i)
+  {
+    withFunction.predict(std::function<void(Vector2f&)>(dynamicModel), Matrix2f::Identity() * 0.1f);
+    withLambda.predict(dynamicModel, Matrix2f::Identity() * 0.1f);
+    withFunction.update(static_cast<float>(i), std::function<float(const Vector2f&)>(measurementModel), 0.5f);
+    withLambda.update(static_cast<float>(i), measurementModel, 0.5f);
+    withFunction.update<2>(Vector2f(i, 1.f), std::function<Vector2f(const Vector2f&)>(measurementModel2), Matrix2f::Identity());
+    withLambda.update<2>(Vector2f(i, 1.f), measurementModel2, Matrix2f::Identity());
+  }
+  EXPECT_TRUE(withFunction.mean == withLambda.mean);
+  EXPECT_TRUE(withFunction.cov == withLambda.cov);
+}
+
+/** Measures a filter step of the shape of FallDownStateProvider::updateUKF, which runs in every Motion frame. */
+GTEST_TEST(UnscentedKalmanFilter, DISABLED_Benchmark)
+{
+  constexpr int repetitions = 200000;
+  auto dynamicModel = [](Vector5f& state)
+  {
+    state.head<2>() += state.tail<2>() * 0.012f;
+    state.tail<2>() += Vector2f(std::sin(state.x()), std::sin(state.y())) * 0.012f;
+  };
+  auto measurementModel = [](const Vector5f& state) { return state; };
+  const Vector5f noise = Vector5f::Constant(0.01f);
+  UKF<5> ukf(Vector5f::Zero());
+
+  for(int run = 0; run < 3; ++run)
+  {
+    ukf.init(Vector5f::Zero(), Matrix5f::Identity());
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < repetitions; ++i)
+    {
+      ukf.predict(std::function<void(Vector5f&)>(dynamicModel), noise.asDiagonal());
+      ukf.update<5>(Vector5f::Constant(0.1f), std::function<Vector5f(const Vector5f&)>(measurementModel), noise.asDiagonal());
+    }
+    const double function = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+    ukf.init(Vector5f::Zero(), Matrix5f::Identity());
+    start = std::chrono::steady_clock::now();
+    for(int i = 0; i < repetitions; ++i)
+    {
+      ukf.predict(dynamicModel, noise.asDiagonal());
+      ukf.update<5>(Vector5f::Constant(0.1f), measurementModel, noise.asDiagonal());
+    }
+    const double lambda = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+    std::printf("UKF<5> predict + update: std::function %.3f us, inlined %.3f us\n", function, lambda);
+  }
+}
@@ -0,0 +1,179 @@
+#include "Tools/MessageQueue/MessageQueue.h"
+#include "Tools/Streams/InStreams.h"
+#include "Tools/Streams/OutStreams.h"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+/** Collects the ids, sizes and first bytes of all messages in a queue. */
+class MessageCollector : public MessageHandler
+{
+public:
+  struct Message
+  {
+    MessageID id;
+    int size;
+    char first;
+  };
+
+  std::vector<Message> messages;
+
+  bool handleMessage(InMessage& message) override
+  {
+    char first = '\0';
+    if(message.getMessageSize())
+      message.bin.read(&first, 1);
+    messages.push_back({message.getMessageID(), message.getMessageSize(), first});
+    return true;
+  }
+
+  static std::vector<Message> collect(MessageQueue& queue)
+  {
+    MessageCollector collector;
+    queue.handleAllMessages(collector);
+    return collector.messages;
+  }
+};
+
+/**
+ * Adds a message to a queue.
+ * @param queue The queue.
+ * @param id The id of the message.
+ * @param size The number of bytes of the message. All bytes are set to \c c.
+ * @param c The content of the message.
+ */
+static void addMessage(MessageQueue& queue, MessageID id, size_t size, char c)
+{
+  std::vector<char> data(size, c);
+  queue.out.bin.write(data.data(), data.size());
+  ASSERT_TRUE(queue.out.finishMessage(id));
+}
+
+GTEST_TEST(MessageQueue, largeMessages)
+{
+  constexpr size_t largeSize = 0x1000010; // > 16 MB
+  MessageQueue queue;
+  queue.setSize(0x3000000);
+  addMessage(queue, idFrameBegin, 10, 'a');
+  addMessage(queue, idText, largeSize, 'b');
+  addMessage(queue, idFrameFinished, 0xffffff, 'c'); // exactly the marker
+  addMessage(queue, idText, 3, 'd');
+
+  const auto check = [&](MessageQueue& queue)
+  {
+    const std::vector<MessageCollector::Message> messages = MessageCollector::collect(queue);
+    ASSERT_EQ(4u, messages.size());
+    EXPECT_EQ(idFrameBegin, messages[0].id);
+    EXPECT_EQ(10, messages[0].size);
+    EXPECT_EQ(idText, messages[1].id);
+    EXPECT_EQ(static_cast<int>(largeSize), messages[1].size);
+    EXPECT_EQ('b', messages[1].first);
+    EXPECT_EQ(idFrameFinished, messages[2].id);
+    EXPECT_EQ(0xffffff, messages[2].size);
+    EXPECT_EQ('c', messages[2].first);
+    EXPECT_EQ(3, messages[3].size);
+    EXPECT_EQ('d', messages[3].first);
+  };
+  check(queue);
+
+  // Streaming and reading back must preserve the extended headers
+  std::vector<char> buffer(queue.getStreamedSize());
+  OutBinaryMemory out(buffer.size(), buffer.data());
+  out << queue;
+  InBinaryMemory in(buffer.data(), buffer.size());
+  MessageQueue copy;
+  copy.setSize(0x3000000);
+  in >> copy;
+  check(copy);
+}
+
+GTEST_TEST(MessageQueue, filterAndRemove)
+{
+  MessageQueue queue;
+  queue.setSize(0x3000000);
+  for(int i = 0; i < 20; ++i)
+    addMessage(queue, i % 3 ? idText : idFrameBegin, i == 7 ? 0x1000000 : i, static_cast<char>('a' + i));
+
+  queue.filter([](int message) {return message % 2 == 1;});
+  std::vector<MessageCollector::Message> messages = MessageCollector::collect(queue);
+  ASSERT_EQ(10u, messages.size());
+  for(int i = 0; i < 10; ++i)
+  {
+    const int original = i * 2 + 1;
+    EXPECT_EQ(original % 3 ? idText : idFrameBegin, messages[i].id);
+    EXPECT_EQ(original == 7 ? 0x1000000 : original, messages[i].size);
+    EXPECT_EQ(static_cast<char>('a' + original), messages[i].first);
+  }
+
+  queue.removeMessage(3); // the large one
+  queue.removeMessage(0);
+  messages = MessageCollector::collect(queue);
+  ASSERT_EQ(8u, messages.size());
+  EXPECT_EQ('a' + 3, messages[0].first);
+  EXPECT_EQ('a' + 5, messages[1].first);
+  EXPECT_EQ('a' + 9, messages[2].first);
+  EXPECT_EQ('a' + 19, messages[7].first);
+
+  queue.removeLastMessage();
+  EXPECT_EQ(7, queue.getNumberOfMessages());
+}
+
+/** Keeps every message except for every fourth one, similar to removing a message type from a log. */
+GTEST_TEST(MessageQueue, DISABLED_BenchmarkFilter)
+{
+  constexpr size_t totalSize = 0x80000000 - 0x1000000; // almost 2 GB
+  constexpr size_t messageSize = 4096;
+  const std::function<bool(int)> keep = [](int message) {return message % 4 != 0;};
+
+  const auto fill = [&](MessageQueue& queue)
+  {
+    queue.setSize(totalSize + 0x1000000);
+    std::vector<char> data(messageSize, 'x');
+    for(size_t size = 0; size + messageSize + 4 < totalSize; size += messageSize + 4)
+    {
+      queue.out.bin.write(data.data(), data.size());
+      queue.out.finishMessage(idText);
+    }
+  };
+
+  double copyTime;
+  {
+    MessageQueue queue;
+    fill(queue);
+
+    // The previous approach: Copy all messages to keep into another queue.
+    const auto start = std::chrono::steady_clock::now();
+    MessageQueue target;
+    target.setSize(queue.getSize());
+    class Copier : public MessageHandler
+    {
+    public:
+      MessageQueue& target;
+      const std::function<bool(int)>& keep;
+      int message = 0;
+
+      Copier(MessageQueue& target, const std::function<bool(int)>& keep) : target(target), keep(keep) {}
+
+      bool handleMessage(InMessage& message) override
+      {
+        if(keep(this->message++))
+          message >> target;
+        return true;
+      }
+    } copier(target, keep);
+    queue.handleAllMessages(copier);
+    copyTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  MessageQueue queue;
+  fill(queue);
+  const int numOfMessages = queue.getNumberOfMessages();
+  const auto start = std::chrono::steady_clock::now();
+  queue.filter(keep);
+  const double filterTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::printf("%d messages: copy %.3f s, in place %.3f s\n", numOfMessages, copyTime, filterTime);
+}
@@ -0,0 +1,166 @@
+#include "Platform/Memory.h"
+#include "Tools/Math/Eigen.h"
+#include "Tools/Math/Random.h"
+#include "Tools/ObjectPool.h"
+#include "Tools/RingBuffer.h"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/** An element similar to an obstacle hypothesis, which owns memory. */
+struct Hypothesis
+{
+  Vector2f center;
+  Matrix2f covariance;
+  RingBuffer<Vector2f, 10> lastPositions;
+
+  Hypothesis(int id) : center(static_cast<float>(id), 0.f), covariance(Matrix2f::Identity()) {}
+};
+
+/** Counts the objects alive. */
+struct Counted
+{
+  static int alive;
+  int value;
+
+  Counted(int value) : value(value) {++alive;}
+  Counted(const Counted& other) : value(other.value) {++alive;}
+  Counted& operator=(const Counted& other) = default;
+  ~Counted() {--alive;}
+};
+
+int Counted::alive = 0;
+
+GTEST_TEST(ObjectPool, keepsOrderAndAddresses)
+{
+  ObjectPool<int, 8> pool;
+  for(int i = 0; i < 5; ++i)
+    pool.push_back(i);
+  const int* third = &pool[3];
+
+  auto next = pool.erase(pool.begin() + 1);
+  EXPECT_EQ(*next, 2);
+  ASSERT_EQ(pool.size(), 4u);
+  EXPECT_EQ(&pool[2], third);
+
+  const std::vector<int> expected = {0, 2, 3, 4};
+  std::size_t index = 0;
+  for(int value : pool)
+    EXPECT_EQ(value, expected[index++]);
+
+  // The slot of the element erased is reused.
+  pool.push_back(5);
+  EXPECT_EQ(pool.back(), 5);
+  EXPECT_EQ(pool.size(), 5u);
+  EXPECT_EQ(&pool[2], third);
+
+  for(auto i = pool.begin(); i != pool.end();)
+    i = *i % 2 ? pool.erase(i) : i + 1;
+  ASSERT_EQ(pool.size(), 3u);
+  EXPECT_EQ(pool.front(), 0);
+  EXPECT_EQ(pool[1], 2);
+  EXPECT_EQ(pool.back(), 4);
+}
+
+GTEST_TEST(ObjectPool, fillsUpToCapacity)
+{
+  ObjectPool<int> pool(3);
+  EXPECT_EQ(pool.capacity(), 3u);
+  EXPECT_TRUE(pool.empty());
+  for(int run = 0; run < 3; ++run)
+  {
+    while(!pool.full())
+      pool.push_back(static_cast<int>(pool.size()));
+    EXPECT_EQ(pool.size(), 3u);
+    EXPECT_EQ(pool[2], 2);
+    pool.clear();
+    EXPECT_TRUE(pool.empty());
+  }
+}
+
+GTEST_TEST(ObjectPool, destroysAllObjects)
+{
+  {
+    ObjectPool<Counted, 4> pool;
+    for(int i = 0; i < 4; ++i)
+      pool.push_back(Counted(i));
+    pool.erase(pool.begin());
+    pool.erase(pool.begin());
+    EXPECT_EQ(Counted::alive, 4);
+    pool.push_back(Counted(4));
+    EXPECT_EQ(Counted::alive, 4);
+    EXPECT_EQ(pool[2].value, 4);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+GTEST_TEST(ObjectPool, recyclesMemoryOfElements)
+{
+  ObjectPool<Hypothesis, 32> pool;
+  Memory::AllocationCounter counter;
+
+  for(int frame = 0; frame < 100; ++frame)
+  {
+    if(frame == 10)
+      Memory::setAllocationCounter(&counter);
+
+    // Remove some old hypotheses and add new ones as the ObstacleModelProvider does.
+    for(auto i = pool.begin(); i != pool.end();)
+      i = (i->lastPositions.full() && Random::bernoulli(0.3)) ? pool.erase(i) : i + 1;
+    while(pool.size() < 24)
+      pool.push_back(Hypothesis(frame));
+    for(Hypothesis& hypothesis : pool)
+      hypothesis.lastPositions.push_front(hypothesis.center);
+  }
+  Memory::setAllocationCounter(nullptr);
+
+  // All slots were used and their ring buffers allocated during the first 10 frames.
+  EXPECT_EQ(counter.count, 0u);
+}
+
+GTEST_TEST(ObjectPool, DISABLED_Benchmark)
+{
+  // Crowded fields with up to 30 hypotheses, about a tenth of which are replaced in each frame.
+  constexpr int frames = 1000000;
+  for(std::size_t numOfHypotheses : {10u, 20u, 30u})
+  {
+    std::vector<int> erased(frames);
+    for(int& index : erased)
+      index = Random::uniformInt(0, static_cast<int>(numOfHypotheses) - 1);
+
+    Memory::AllocationCounter vectorAllocations;
+    std::vector<Hypothesis, Eigen::aligned_allocator<Hypothesis>> vector;
+    Memory::setAllocationCounter(&vectorAllocations);
+    auto start = std::chrono::steady_clock::now();
+    for(int frame = 0; frame < frames; ++frame)
+    {
+      if(vector.size() == numOfHypotheses)
+        vector.erase(vector.begin() + erased[frame]);
+      while(vector.size() < numOfHypotheses)
+        vector.emplace_back(frame);
+      vector.back().lastPositions.push_front(vector.back().center);
+    }
+    const double vectorTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / frames;
+    Memory::setAllocationCounter(nullptr);
+
+    Memory::AllocationCounter poolAllocations;
+    ObjectPool<Hypothesis, 64> pool;
+    Memory::setAllocationCounter(&poolAllocations);
+    start = std::chrono::steady_clock::now();
+    for(int frame = 0; frame < frames; ++frame)
+    {
+      if(pool.size() == numOfHypotheses)
+        pool.erase(pool.begin() + erased[frame]);
+      while(pool.size() < numOfHypotheses)
+        pool.push_back(Hypothesis(frame));
+      pool.back().lastPositions.push_front(pool.back().center);
+    }
+    const double poolTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / frames;
+    Memory::setAllocationCounter(nullptr);
+
+    std::printf("%2u hypotheses: vector %.3f us (%u allocations), pool %.3f us (%u allocations)\n",
+                static_cast<unsigned>(numOfHypotheses), vectorTime, vectorAllocations.count, poolTime, poolAllocations.count);
+  }
+}
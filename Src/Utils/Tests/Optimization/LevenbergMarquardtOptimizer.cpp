@@ -0,0 +1,228 @@
+#include "Tools/Optimization/GaussNewtonOptimizer.h"
+#include "Tools/Optimization/LevenbergMarquardtOptimizer.h"
+#include "Tools/Math/Random.h"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+
+using Optimizer = LevenbergMarquardtOptimizer<6>;
+using Parameters = Optimizer::Vector;
+
+/**
+ * A calibration problem of the shape of the one solved by the AutomaticCameraCalibrator:
+ * Points on the ground are observed by a camera at an unknown pose, i.e. roll, pitch,
+ * yaw, x, y, and height. Each observation results in two measurements, i.e. the
+ * horizontal and the vertical error in the (normalized) image.
+ */
+struct Projection : Optimizer::AutoDiffFunctor<Projection>
+{
+  std::vector<Vector2f> pointsOnField;
+  std::vector<Vector2f> pointsInImage;
+
+  /**
+   * Creates observations.
+   * @param camera The actual pose of the camera.
+   * @param numOfObservations The number of points observed.
+   * @param outlierRatio The ratio of the observations that are disturbed.
+   */
+  Projection(const Parameters& camera, size_t numOfObservations, float outlierRatio = 0.f)
+  {
+    while(pointsOnField.size() < numOfObservations)
+    {
+      const Vector2f pointOnField(Random::uniform(500.f, 3000.f), Random::uniform(-1500.f, 1500.f));
+      const Vector2f pointInImage(project<float>(toArray(camera), pointOnField, 0), project<float>(toArray(camera), pointOnField, 1));
+      if(std::abs(pointInImage.x()) > 0.6f || std::abs(pointInImage.y()) > 0.45f)
+        continue;
+      pointsOnField.push_back(pointOnField);
+      pointsInImage.push_back(pointInImage + (Random::bernoulli(outlierRatio) ? Vector2f(Random::uniform(-0.2f, 0.2f), Random::uniform(-0.2f, 0.2f)) : Vector2f::Zero()));
+    }
+  }
+
+  static std::array<float, 6> toArray(const Parameters& params)
+  {
+    return {params(0), params(1), params(2), params(3), params(4), params(5)};
+  }
+
+  /**
+   * Projects a point on the ground into the image.
+   * @param camera The pose of the camera.
+   * @param pointOnField The point.
+   * @param dimension The image coordinate that is returned (0: horizontal, 1: vertical).
+   * @return The normalized image coordinate.
+   */
+  template<typename T> static T project(const std::array<T, 6>& camera, const Vector2f& pointOnField, size_t dimension)
+  {
+    using std::sin;
+    using std::cos;
+    const T sr = sin(camera[0]), cr = cos(camera[0]);
+    const T sp = sin(camera[1]), cp = cos(camera[1]);
+    const T sy = sin(camera[2]), cy = cos(camera[2]);
+    const T dx = T(pointOnField.x()) - camera[3];
+    const T dy = T(pointOnField.y()) - camera[4];
+    const T dz = -camera[5];
+
+    // Rotate the offset by the transposed rotation Rz(yaw) * Ry(pitch) * Rx(roll).
+    const T x1 = cy * dx + sy * dy;
+    const T y1 = cy * dy - sy * dx;
+    const T x = cp * x1 - sp * dz;
+    const T z2 = sp * x1 + cp * dz;
+    const T y = cr * y1 + sr * z2;
+    const T z = cr * z2 - sr * y1;
+    return (dimension == 0 ? y : z) / x;
+  }
+
+  template<typename T> T error(const std::array<T, 6>& params, size_t measurement) const
+  {
+    return project(params, pointsOnField[measurement / 2], measurement % 2) - T(pointsInImage[measurement / 2](measurement % 2));
+  }
+
+  size_t getNumOfMeasurements() const override {return pointsOnField.size() * 2;}
+};
+
+/** The same problem, but the derivatives are approximated numerically. */
+struct NumericalProjection : Projection
+{
+  using Projection::Projection;
+
+  bool gradient(const Parameters&, size_t, float&, Parameters&) const override {return false;}
+};
+
+/** The same problem for the GaussNewtonOptimizer. */
+struct GaussNewtonProjection : GaussNewtonOptimizer<6>::Functor
+{
+  const Projection& projection;
+
+  GaussNewtonProjection(const Projection& projection) : projection(projection) {}
+  float operator()(const Parameters& params, size_t measurement) const override {return projection(params, measurement);}
+  size_t getNumOfMeasurements() const override {return projection.getNumOfMeasurements();}
+};
+
+static const Parameters camera = (Parameters() << 0.02f, 0.5f, -0.05f, -20.f, 10.f, 520.f).finished();
+static const Parameters start = (Parameters() << 0.f, 0.45f, 0.f, 0.f, 0.f, 500.f).finished();
+static const Parameters epsilon = (Parameters() << 1e-3f, 1e-3f, 1e-3f, 0.1f, 0.1f, 0.1f).finished();
+static const Parameters tolerance = (Parameters() << 1e-3f, 1e-3f, 1e-3f, 2.f, 2.f, 2.f).finished();
+
+/**
+ * Optimizes until the parameters do not change anymore.
+ * @return The number of iterations.
+ */
+static int optimize(Optimizer& optimizer, Parameters& params, int maxIterations = 100)
+{
+  int iterations = 0;
+  while(iterations < maxIterations && optimizer.iterate(params, epsilon) > 1e-5f)
+    ++iterations;
+  return iterations;
+}
+
+GTEST_TEST(LevenbergMarquardtOptimizer, converges)
+{
+  for(int run = 0; run < 10; ++run)
+  {
+    const NumericalProjection numerical(camera, 30);
+    Optimizer optimizer(numerical);
+    Parameters params = start;
+    EXPECT_LT(optimize(optimizer, params), 100);
+    EXPECT_TRUE(((params - camera).cwiseAbs().array() < tolerance.array()).all()) << params.transpose();
+    EXPECT_LT(optimizer.getErrors().cwiseAbs().maxCoeff(), 1e-4f);
+  }
+}
+
+GTEST_TEST(LevenbergMarquardtOptimizer, autoDiffSameAsNumerical)
+{
+  const NumericalProjection projection(camera, 30);
+  for(int run = 0; run < 100; ++run)
+  {
+    Parameters params = start;
+    params.head<3>() += Vector3f::Random() * 0.05f;
+    params.tail<3>() += Vector3f::Random() * 50.f;
+    for(size_t i = 0; i < projection.getNumOfMeasurements(); ++i)
+    {
+      float error;
+      Parameters gradient;
+      ASSERT_TRUE(projection.Projection::gradient(params, i, error, gradient));
+      EXPECT_NEAR(projection(params, i), error, 1e-6f);
+      for(size_t j = 0; j < 6; ++j)
+      {
+        Parameters above = params;
+        Parameters below = params;
+        above(j) += epsilon(j);
+        below(j) -= epsilon(j);
+        const float numerical = (projection(above, i) - projection(below, i)) / (2.f * epsilon(j));
+        EXPECT_NEAR(numerical, gradient(j), 1e-3f * std::max(1.f, std::abs(gradient(j)))) << "parameter " << j;
+      }
+    }
+  }
+}
+
+GTEST_TEST(LevenbergMarquardtOptimizer, parallelSameAsSequential)
+{
+  const Projection projection(camera, 100);
+  Optimizer parallel(projection);
+  Optimizer sequential(projection, Optimizer::Loss::squared, 1.f, false);
+  Parameters parallelParams = start;
+  Parameters sequentialParams = start;
+  for(int i = 0; i < 10; ++i)
+  {
+    parallel.iterate(parallelParams, epsilon);
+    sequential.iterate(sequentialParams, epsilon);
+    EXPECT_TRUE(((parallelParams - sequentialParams).cwiseAbs().array() < tolerance.array() * 0.1f).all());
+  }
+}
+
+GTEST_TEST(LevenbergMarquardtOptimizer, robustLoss)
+{
+  float squaredError = 0.f;
+  float huberError = 0.f;
+  float cauchyError = 0.f;
+  for(int run = 0; run < 10; ++run)
+  {
+    const Projection projection(camera, 60, 0.2f);
+    for(auto [loss, error] : {std::make_pair(Optimizer::Loss::squared, &squaredError),
+                              std::make_pair(Optimizer::Loss::huber, &huberError),
+                              std::make_pair(Optimizer::Loss::cauchy, &cauchyError)})
+    {
+      Optimizer optimizer(projection, loss, 0.005f);
+      Parameters params = start;
+      optimize(optimizer, params);
+      *error += (params - camera).cwiseQuotient(tolerance).norm();
+    }
+  }
+  EXPECT_LT(huberError, squaredError);
+  EXPECT_LT(cauchyError, huberError);
+}
+
+GTEST_TEST(LevenbergMarquardtOptimizer, DISABLED_Benchmark)
+{
+  for(size_t numOfObservations : {15, 50, 200})
+  {
+    const NumericalProjection numerical(camera, numOfObservations);
+    const GaussNewtonProjection gaussNewtonProjection(numerical);
+    const Projection autoDiff(numerical);
+
+    auto measure = [&](const char* name, auto createOptimizer)
+    {
+      constexpr int repetitions = 100;
+      Parameters params;
+      int iterations = 0;
+      const auto begin = std::chrono::steady_clock::now();
+      for(int i = 0; i < repetitions; ++i)
+      {
+        auto optimizer = createOptimizer();
+        params = start;
+        iterations = 0;
+        while(iterations < 100 && optimizer.iterate(params, epsilon) > 1e-5f)
+          ++iterations;
+      }
+      const double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count() / repetitions;
+      std::printf("%3zu observations, %-21s %3d iterations, %7.3f ms, %8.1f iterations/s, error %.4f\n", numOfObservations, name,
+                  iterations, time, (iterations + 1) / time * 1000., (params - camera).cwiseQuotient(tolerance).norm());
+    };
+
+    measure("Gauss-Newton:", [&] {return GaussNewtonOptimizer<6>(gaussNewtonProjection);});
+    measure("LM, sequential:", [&] {return Optimizer(numerical, Optimizer::Loss::squared, 1.f, false);});
+    measure("LM, parallel:", [&] {return Optimizer(numerical);});
+    measure("LM, autodiff:", [&] {return Optimizer(autoDiff, Optimizer::Loss::squared, 1.f, false);});
+    measure("LM, autodiff parallel:", [&] {return Optimizer(autoDiff);});
+  }
+}
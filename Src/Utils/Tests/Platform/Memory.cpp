@@ -0,0 +1,51 @@
+#include "Platform/Memory.h"
+
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+GTEST_TEST(Memory, countAllocations)
+{
+  Memory::AllocationCounter counter;
+  Memory::AllocationCounter* previous = Memory::setAllocationCounter(&counter);
+  std::vector<int> numbers;
+  numbers.reserve(100);
+  std::unique_ptr<double> number = std::make_unique<double>(1.0);
+  void* aligned = Memory::alignedMalloc(64, 32);
+  EXPECT_EQ(Memory::setAllocationCounter(previous), &counter);
+  Memory::alignedFree(aligned);
+
+  EXPECT_EQ(counter.count, 3u);
+  EXPECT_EQ(counter.bytes, 100 * sizeof(int) + sizeof(double) + 64);
+
+  // Nothing is counted after the counter was removed.
+  numbers.reserve(200);
+  EXPECT_EQ(counter.count, 3u);
+}
+
+GTEST_TEST(Memory, countPerThread)
+{
+  Memory::AllocationCounter counter;
+  Memory::AllocationCounter* previous = Memory::setAllocationCounter(&counter);
+  std::thread([] {std::vector<int>(1000);}).join();
+  Memory::setAllocationCounter(previous);
+
+  // Creating the thread might allocate, but the allocation in the thread itself is not counted.
+  EXPECT_LT(counter.bytes, 1000 * sizeof(int));
+}
+
+GTEST_TEST(Memory, forbidAllocations)
+{
+  Memory::forbidAllocations("test");
+  const std::vector<int> empty;
+  EXPECT_STREQ(Memory::forbidAllocations(nullptr), "test");
+  EXPECT_TRUE(empty.empty());
+
+  EXPECT_DEATH(
+  {
+    Memory::forbidAllocations("test");
+    std::string text(100, 'x');
+  }, "Heap allocation of 101 bytes in test");
+}
@@ -0,0 +1,23 @@
+#include "Tools/WorkerPool.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+
+GTEST_TEST(WorkerPool, urgentJobsFirst)
+{
+  WorkerPool pool(1);
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::vector<int> order;
+
+  // The only worker is blocked until all other jobs are issued.
+  std::future<void> blocker = pool.run([released] { released.wait(); });
+  std::future<void> normal1 = pool.run([&order] { order.push_back(1); });
+  std::future<void> normal2 = pool.run([&order] { order.push_back(2); });
+  std::future<void> urgent3 = pool.run([&order] { order.push_back(3); }, WorkerPool::Priority::urgent);
+  std::future<void> urgent4 = pool.run([&order] { order.push_back(4); }, WorkerPool::Priority::urgent);
+  release.set_value();
+  normal2.wait();
+
+  EXPECT_EQ(order, std::vector<int>({3, 4, 1, 2}));
+}